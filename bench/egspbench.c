@@ -0,0 +1,535 @@
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+// Data type definitions for the schemas in egspbench.egsp. Each one stresses a different path.
+
+// Every number type side by side, so each field goes through its own call
+typedef struct
+{
+	uint64_t a0;
+	uint64_t a1;
+	int64_t a2;
+	int64_t a3;
+	double a4;
+	double a5;
+	uint32_t b0;
+	uint32_t b1;
+	uint32_t b2;
+	int32_t b3;
+	int32_t b4;
+	int32_t b5;
+	float b6;
+	float b7;
+	float b8;
+	float b9;
+	uint16_t c0;
+	uint16_t c1;
+	int16_t c2;
+	int16_t c3;
+	uint8_t d0;
+	uint8_t d1;
+	int8_t d2;
+	int8_t d3;
+} Wide;
+
+typedef struct
+{
+	uint32_t count;
+	Wide* items;
+} WideSet;
+
+// Eight levels of inline structs with a single number each, so the cost is all in the calls
+typedef struct { uint32_t value; } Deep7;
+typedef struct { uint32_t value; Deep7 next; } Deep6;
+typedef struct { uint32_t value; Deep6 next; } Deep5;
+typedef struct { uint32_t value; Deep5 next; } Deep4;
+typedef struct { uint32_t value; Deep4 next; } Deep3;
+typedef struct { uint32_t value; Deep3 next; } Deep2;
+typedef struct { uint32_t value; Deep2 next; } Deep1;
+typedef struct { uint32_t value; Deep1 next; } Deep0;
+
+typedef struct
+{
+	uint32_t count;
+	Deep0* items;
+} DeepSet;
+
+// Large arrays of structs, raw structs and numbers
+typedef struct
+{
+	float x;
+	float y;
+	float z;
+	uint32_t id;
+} Point;
+
+typedef struct
+{
+	float x;
+	float y;
+	float z;
+	uint32_t color;
+} Pixel;
+
+typedef struct
+{
+	uint32_t count;
+	Point* points;
+	Pixel* pixels;
+	uint32_t* values;
+} ArraySet;
+
+// Strings, many short ones or a few long ones
+typedef struct
+{
+	const char* text;
+} Word;
+
+typedef struct
+{
+	uint32_t count;
+	Word* words;
+} ShortStrings;
+
+typedef struct
+{
+	uint32_t count;
+	Word* pages;
+} LongStrings;
+
+// Nodes pointing at up to four leaves each, about half of them null
+typedef struct
+{
+	uint64_t key;
+	float weight;
+} Leaf;
+
+typedef struct
+{
+	uint32_t id;
+	Leaf* a;
+	Leaf* b;
+	Leaf* c;
+	Leaf* d;
+} GraphNode;
+
+typedef struct
+{
+	uint32_t count;
+	GraphNode* nodes;
+} Graph;
+
+// A balanced binary tree of nodes pointing at their own type, loaded and saved recursively
+typedef struct TreeNode
+{
+	uint32_t id;
+	float weight;
+	struct TreeNode* left;
+	struct TreeNode* right;
+} TreeNode;
+
+typedef struct
+{
+	uint32_t count;
+	TreeNode* root;
+} Tree;
+
+#include "egspload.h"
+
+#ifndef EGSP_BENCH_VERSION
+#define EGSP_BENCH_VERSION "unknown"
+#endif
+
+// Sizes of the data sets, a few MB of stream each
+#define BENCH_WIDE 20000
+#define BENCH_DEEP 50000
+#define BENCH_ARRAY 100000
+#define BENCH_SHORT 100000
+#define BENCH_LONG 64
+#define BENCH_GRAPH 30000
+#define BENCH_TREE 32767
+
+// Stream kept in memory, grown as Save and Print fill it. Blocks lie end to end, so Load gets back the same ones.
+typedef struct
+{
+	uint8_t* pBase;
+	size_t capacity;
+	size_t count;
+	size_t blockSize;
+	size_t used;
+} Stream;
+
+uint8_t* StreamFunc(void* pUser, size_t size)
+{
+	Stream* pStream = (Stream*)pUser;
+	size_t end = (pStream->count + 1) * pStream->blockSize;
+	pStream->used += size;
+	if (end > pStream->capacity)
+	{
+		size_t capacity = pStream->capacity * 2 > end ? pStream->capacity * 2 : end;
+		uint8_t* pBase = (uint8_t*)realloc(pStream->pBase, capacity);
+		if (!pBase)
+		{
+			return 0;
+		}
+		pStream->pBase = pBase;
+		pStream->capacity = capacity;
+	}
+	return pStream->pBase + (pStream->count++ * pStream->blockSize);
+}
+
+static uint64_t Now()
+{
+	struct timespec time;
+#if defined(_WIN32)
+	timespec_get(&time, TIME_UTC);
+#else
+	clock_gettime(CLOCK_MONOTONIC, &time);
+#endif
+	return (uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_nsec;
+}
+
+// xorshift64, so that every run benchmarks the same data
+static uint64_t s_random = 0x9E3779B97F4A7C15ull;
+
+static uint64_t Random()
+{
+	s_random ^= s_random << 13;
+	s_random ^= s_random >> 7;
+	s_random ^= s_random << 17;
+	return s_random;
+}
+
+static char* RandomText(size_t length, size_t lineLength)
+{
+	char* pText = (char*)malloc(length + 1);
+	for (size_t i = 0; i < length; ++i)
+	{
+		uint64_t r = Random();
+		pText[i] = (lineLength && i % lineLength == lineLength - 1) ? '\n' : (r % 7 == 0) ? ' ' : (char)('a' + r % 26);
+	}
+	pText[length] = '\0';
+	return pText;
+}
+
+// Generated functions of every schema behind the same signatures, and the table interpreter doing the same work
+typedef EgspResult (*BenchWrite)(EgspLoader* pLoader, void* pVal);
+typedef EgspResult (*BenchRead)(EgspLoader* pLoader, void* pVal, void* pHeap, size_t heapSize);
+
+#ifdef EGSP_JSON
+#define BENCH_JSON(NAME) \
+	static EgspResult Print##NAME(EgspLoader* pLoader, void* pVal) { return EgspPrint##NAME##Ex(pLoader, (NAME*)pVal); } \
+	static EgspResult Read##NAME(EgspLoader* pLoader, void* pVal, void* pHeap, size_t heapSize) { return EgspRead##NAME##Ex(pLoader, (NAME*)pVal, pHeap, heapSize); } \
+	static EgspResult TablePrint##NAME(EgspLoader* pLoader, void* pVal) { return EgspPrintStructEx(pLoader, &s_egspInfo##NAME, pVal); } \
+	static EgspResult TableRead##NAME(EgspLoader* pLoader, void* pVal, void* pHeap, size_t heapSize) { return EgspReadStructEx(pLoader, &s_egspInfo##NAME, pVal, pHeap, heapSize); }
+#define BENCH_JSON_FUNCS(NAME) Print##NAME, Read##NAME
+#define BENCH_TABLE_JSON_FUNCS(NAME) TablePrint##NAME, TableRead##NAME
+#else
+#define BENCH_JSON(NAME)
+#define BENCH_JSON_FUNCS(NAME) 0, 0
+#define BENCH_TABLE_JSON_FUNCS(NAME) 0, 0
+#endif
+
+#define BENCH_SCHEMA(NAME) \
+	static EgspResult Save##NAME(EgspLoader* pLoader, void* pVal) { return EgspSave##NAME##Ex(pLoader, (NAME*)pVal); } \
+	static EgspResult Load##NAME(EgspLoader* pLoader, void* pVal, void* pHeap, size_t heapSize) { return EgspLoad##NAME##Ex(pLoader, (NAME*)pVal, pHeap, heapSize); } \
+	static EgspResult TableSave##NAME(EgspLoader* pLoader, void* pVal) { return EgspSaveStructEx(pLoader, &s_egspInfo##NAME, pVal); } \
+	static EgspResult TableLoad##NAME(EgspLoader* pLoader, void* pVal, void* pHeap, size_t heapSize) { return EgspLoadStructEx(pLoader, &s_egspInfo##NAME, pVal, pHeap, heapSize); } \
+	BENCH_JSON(NAME)
+
+BENCH_SCHEMA(WideSet)
+BENCH_SCHEMA(DeepSet)
+BENCH_SCHEMA(ArraySet)
+BENCH_SCHEMA(ShortStrings)
+BENCH_SCHEMA(LongStrings)
+BENCH_SCHEMA(Graph)
+BENCH_SCHEMA(Tree)
+
+typedef struct
+{
+	const char* pName;
+	void* pData;
+	size_t size;
+	size_t objects;
+	BenchWrite pSave;
+	BenchRead pLoad;
+	BenchWrite pPrint;
+	BenchRead pRead;
+	BenchWrite pTableSave;
+	BenchRead pTableLoad;
+	BenchWrite pTablePrint;
+	BenchRead pTableRead;
+} Schema;
+
+#define BENCH_ENTRY(NAME, DATA, OBJECTS) { #NAME, &DATA, sizeof(NAME), OBJECTS, Save##NAME, Load##NAME, BENCH_JSON_FUNCS(NAME), \
+	TableSave##NAME, TableLoad##NAME, BENCH_TABLE_JSON_FUNCS(NAME) }
+
+static WideSet s_wide;
+static DeepSet s_deep;
+static ArraySet s_array;
+static ShortStrings s_short;
+static LongStrings s_long;
+static Graph s_graph;
+static Tree s_tree;
+
+// Ids first to last of the subtree, the middle one at its root
+static TreeNode* BuildTree(uint32_t first, uint32_t last)
+{
+	if (first > last)
+	{
+		return 0;
+	}
+	uint32_t middle = first + (last - first) / 2;
+	TreeNode* pNode = (TreeNode*)malloc(sizeof(TreeNode));
+	pNode->id = middle;
+	pNode->weight = (float)(Random() % 1000) / 8.0f;
+	pNode->left = middle > first ? BuildTree(first, middle - 1) : 0;
+	pNode->right = BuildTree(middle + 1, last);
+	return pNode;
+}
+
+static void SetupData()
+{
+	s_wide.count = BENCH_WIDE;
+	s_wide.items = (Wide*)calloc(BENCH_WIDE, sizeof(Wide));
+	for (uint32_t i = 0; i < BENCH_WIDE; ++i)
+	{
+		Wide* pWide = &s_wide.items[i];
+		pWide->a0 = Random();
+		pWide->a1 = Random() >> 40;
+		pWide->a2 = (int64_t)Random();
+		pWide->a3 = -(int64_t)(Random() >> 50);
+		pWide->a4 = (double)Random() / 3.0;
+		pWide->a5 = 1.0 / (double)(i + 1);
+		pWide->b0 = (uint32_t)Random();
+		pWide->b1 = i;
+		pWide->b2 = (uint32_t)(Random() >> 52);
+		pWide->b3 = -(int32_t)i;
+		pWide->b4 = (int32_t)Random();
+		pWide->b5 = 7;
+		pWide->b6 = (float)i * 0.5f;
+		pWide->b7 = (float)(Random() % 100000) / 7.0f;
+		pWide->b8 = -1.25f;
+		pWide->b9 = 3.0e-20f * (float)i;
+		pWide->c0 = (uint16_t)Random();
+		pWide->c1 = (uint16_t)i;
+		pWide->c2 = (int16_t)Random();
+		pWide->c3 = -5;
+		pWide->d0 = (uint8_t)Random();
+		pWide->d1 = (uint8_t)i;
+		pWide->d2 = (int8_t)Random();
+		pWide->d3 = -1;
+	}
+
+	s_deep.count = BENCH_DEEP;
+	s_deep.items = (Deep0*)calloc(BENCH_DEEP, sizeof(Deep0));
+	for (uint32_t i = 0; i < BENCH_DEEP; ++i)
+	{
+		Deep0* pDeep = &s_deep.items[i];
+		pDeep->value = i;
+		pDeep->next.value = (uint32_t)Random();
+		pDeep->next.next.value = i * 3;
+		pDeep->next.next.next.value = (uint32_t)(Random() >> 48);
+		pDeep->next.next.next.next.value = i ^ 0x5555;
+		pDeep->next.next.next.next.next.value = (uint32_t)Random();
+		pDeep->next.next.next.next.next.next.value = i & 0xFF;
+		pDeep->next.next.next.next.next.next.next.value = (uint32_t)Random();
+	}
+
+	s_array.count = BENCH_ARRAY;
+	s_array.points = (Point*)calloc(BENCH_ARRAY, sizeof(Point));
+	s_array.pixels = (Pixel*)calloc(BENCH_ARRAY, sizeof(Pixel));
+	s_array.values = (uint32_t*)calloc(BENCH_ARRAY, sizeof(uint32_t));
+	for (uint32_t i = 0; i < BENCH_ARRAY; ++i)
+	{
+		s_array.points[i].x = (float)(Random() % 4096) * 0.25f;
+		s_array.points[i].y = (float)i;
+		s_array.points[i].z = -0.5f * (float)i;
+		s_array.points[i].id = i;
+		s_array.pixels[i].x = s_array.points[i].x;
+		s_array.pixels[i].y = s_array.points[i].y;
+		s_array.pixels[i].z = s_array.points[i].z;
+		s_array.pixels[i].color = (uint32_t)Random();
+		s_array.values[i] = (uint32_t)Random();
+	}
+
+	s_short.count = BENCH_SHORT;
+	s_short.words = (Word*)calloc(BENCH_SHORT, sizeof(Word));
+	for (uint32_t i = 0; i < BENCH_SHORT; ++i)
+	{
+		s_short.words[i].text = RandomText(4 + Random() % 13, 0);
+	}
+
+	s_long.count = BENCH_LONG;
+	s_long.pages = (Word*)calloc(BENCH_LONG, sizeof(Word));
+	for (uint32_t i = 0; i < BENCH_LONG; ++i)
+	{
+		s_long.pages[i].text = RandomText(16384 + Random() % 49152, 80);
+	}
+
+	s_graph.count = BENCH_GRAPH;
+	s_graph.nodes = (GraphNode*)calloc(BENCH_GRAPH, sizeof(GraphNode));
+	for (uint32_t i = 0; i < BENCH_GRAPH; ++i)
+	{
+		GraphNode* pNode = &s_graph.nodes[i];
+		Leaf** ppLeaves[] = { &pNode->a, &pNode->b, &pNode->c, &pNode->d };
+		pNode->id = i;
+		for (size_t l = 0; l < 4; ++l)
+		{
+			if (Random() & 1)
+			{
+				Leaf* pLeaf = (Leaf*)malloc(sizeof(Leaf));
+				pLeaf->key = Random();
+				pLeaf->weight = (float)(Random() % 1000) / 8.0f;
+				*ppLeaves[l] = pLeaf;
+			}
+		}
+	}
+
+	s_tree.count = BENCH_TREE;
+	s_tree.root = BuildTree(0, BENCH_TREE - 1);
+}
+
+// Runs one operation over and over for at least seconds, returning the fastest run in nanoseconds or 0 on failure.
+// Writing operations report the stream size and heap they needed.
+static uint64_t Measure(Stream* pStream, size_t alignBytes, const Schema* pSchema, BenchWrite pWrite, BenchRead pRead,
+	void* pOut, void* pHeap, size_t* pHeapSize, double seconds)
+{
+	uint64_t best = UINT64_MAX;
+	uint64_t start = Now();
+	do
+	{
+		EgspLoader loader;
+		EgspInitLoader(&loader, StreamFunc, pStream);
+		loader.blockSize = pStream->blockSize;
+		loader.alignBytes = alignBytes;
+		loader.flags = 0;
+		pStream->count = 0;
+		pStream->used = 0;
+
+		uint64_t begin = Now();
+		EgspResult result = pWrite ? pWrite(&loader, pSchema->pData) : pRead(&loader, pOut, pHeap, *pHeapSize);
+		uint64_t elapsed = Now() - begin;
+		if (result != EGSP_SUCCESS)
+		{
+			return 0;
+		}
+		if (pWrite)
+		{
+			*pHeapSize = loader.heapSize;
+		}
+		best = elapsed < best ? elapsed : best;
+	} while ((double)(Now() - start) < seconds * 1e9);
+	return best ? best : 1;
+}
+
+static void Report(FILE* pResults, const char* pLabel, const Schema* pSchema, const char* pOp, size_t blockSize,
+	size_t alignBytes, size_t bytes, uint64_t nanoseconds)
+{
+	double mbPerSecond = (double)bytes / 1e6 / ((double)nanoseconds / 1e9);
+	double nsPerObject = (double)nanoseconds / (double)pSchema->objects;
+	printf("%-13s %-11s %6zu %2zu %10.1f MB/s %10.1f ns/object\n", pSchema->pName, pOp, blockSize, alignBytes, mbPerSecond, nsPerObject);
+	if (pResults)
+	{
+		fprintf(pResults, "%s,%s,%s,%zu,%zu,%zu,%zu,%llu,%.3f,%.3f\n", pLabel, pSchema->pName, pOp, blockSize, alignBytes,
+			pSchema->objects, bytes, (unsigned long long)nanoseconds, mbPerSecond, nsPerObject);
+	}
+}
+
+// egspbench [results.csv [seconds [label]]]
+// Appends a line to results.csv for every schema, operation, block size and alignment. The label tells the runs of
+// different library versions apart, and defaults to the version egspbench was built from.
+int main(int argc, char** argv)
+{
+	const char* pPath = argc > 1 ? argv[1] : "egspbench.csv";
+	double seconds = argc > 2 ? atof(argv[2]) : 0.1;
+	const char* pLabel = argc > 3 ? argv[3] : EGSP_BENCH_VERSION;
+	size_t blockSizes[] = { 256, 4096, 65536 };
+	size_t alignments[] = { 2, 8 };
+
+	SetupData();
+	Schema schemas[] = {
+		BENCH_ENTRY(WideSet, s_wide, BENCH_WIDE),
+		BENCH_ENTRY(DeepSet, s_deep, BENCH_DEEP),
+		BENCH_ENTRY(ArraySet, s_array, BENCH_ARRAY * 3),
+		BENCH_ENTRY(ShortStrings, s_short, BENCH_SHORT),
+		BENCH_ENTRY(LongStrings, s_long, BENCH_LONG),
+		BENCH_ENTRY(Graph, s_graph, BENCH_GRAPH),
+		BENCH_ENTRY(Tree, s_tree, BENCH_TREE)
+	};
+
+	FILE* pResults = fopen(pPath, "r");
+	int fresh = !pResults;
+	if (pResults)
+	{
+		fclose(pResults);
+	}
+	pResults = fopen(pPath, "a");
+	if (!pResults)
+	{
+		fprintf(stderr, "Cannot write %s\n", pPath);
+		return 1;
+	}
+	if (fresh)
+	{
+		fprintf(pResults, "label,schema,op,block_size,align_bytes,objects,bytes,ns,mb_per_s,ns_per_object\n");
+	}
+
+	Stream stream = { 0, 0, 0, 0, 0 };
+	int failed = 0;
+	for (size_t b = 0; b < sizeof(blockSizes) / sizeof(blockSizes[0]); ++b)
+	{
+		for (size_t a = 0; a < sizeof(alignments) / sizeof(alignments[0]); ++a)
+		{
+			for (size_t s = 0; s < sizeof(schemas) / sizeof(schemas[0]); ++s)
+			{
+				const Schema* pSchema = &schemas[s];
+				void* pOut = malloc(pSchema->size);
+				const char* pOps[] = { "save", "load", "print", "read", "table_save", "table_load", "table_print", "table_read" };
+				BenchWrite pWrites[] = { pSchema->pSave, 0, pSchema->pPrint, 0, pSchema->pTableSave, 0, pSchema->pTablePrint, 0 };
+				BenchRead pReads[] = { 0, pSchema->pLoad, 0, pSchema->pRead, 0, pSchema->pTableLoad, 0, pSchema->pTableRead };
+				void* pHeap = 0;
+				size_t heapSize = 0;
+				size_t bytes = 0;
+				stream.blockSize = blockSizes[b];
+
+				for (size_t o = 0; o < sizeof(pOps) / sizeof(pOps[0]); ++o)
+				{
+					if (!pWrites[o] && !pReads[o])
+					{
+						continue;
+					}
+					// Loads read back what the save or print before them wrote
+					if (pReads[o])
+					{
+						pHeap = malloc(heapSize ? heapSize : 1);
+					}
+					uint64_t nanoseconds = Measure(&stream, alignments[a], pSchema, pWrites[o], pReads[o], pOut, pHeap, &heapSize, seconds);
+					if (pWrites[o])
+					{
+						bytes = stream.used;
+					}
+					free(pHeap);
+					pHeap = 0;
+					if (!nanoseconds)
+					{
+						fprintf(stderr, "%s %s failed\n", pSchema->pName, pOps[o]);
+						failed = 1;
+						continue;
+					}
+					Report(pResults, pLabel, pSchema, pOps[o], blockSizes[b], alignments[a], bytes, nanoseconds);
+				}
+				free(pOut);
+			}
+		}
+	}
+	fclose(pResults);
+	free(stream.pBase);
+	return failed;
+}
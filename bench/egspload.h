@@ -0,0 +1,5231 @@
+// This file is automatically generated by egsploader.
+
+#ifndef EGSPLOAD_H
+#define EGSPLOAD_H
+
+#include "egsplib.h"
+
+static const uint64_t s_egspSchemaWide = 0x43034aab701afb9full;
+
+static inline void _EgspGetWide(const uint8_t* pRun, Wide* pVal)
+{
+	_EgspGetuint64_t(pRun + 0, &pVal->a0);
+	_EgspGetuint64_t(pRun + 8, &pVal->a1);
+	_EgspGetint64_t(pRun + 16, &pVal->a2);
+	_EgspGetint64_t(pRun + 24, &pVal->a3);
+	_EgspGetdouble(pRun + 32, &pVal->a4);
+	_EgspGetdouble(pRun + 40, &pVal->a5);
+	_EgspGetuint32_t(pRun + 48, &pVal->b0);
+	_EgspGetuint32_t(pRun + 52, &pVal->b1);
+	_EgspGetuint32_t(pRun + 56, &pVal->b2);
+	_EgspGetint32_t(pRun + 60, &pVal->b3);
+	_EgspGetint32_t(pRun + 64, &pVal->b4);
+	_EgspGetint32_t(pRun + 68, &pVal->b5);
+	_EgspGetfloat(pRun + 72, &pVal->b6);
+	_EgspGetfloat(pRun + 76, &pVal->b7);
+	_EgspGetfloat(pRun + 80, &pVal->b8);
+	_EgspGetfloat(pRun + 84, &pVal->b9);
+	_EgspGetuint16_t(pRun + 88, &pVal->c0);
+	_EgspGetuint16_t(pRun + 90, &pVal->c1);
+	_EgspGetint16_t(pRun + 92, &pVal->c2);
+	_EgspGetint16_t(pRun + 94, &pVal->c3);
+	_EgspGetuint8_t(pRun + 96, &pVal->d0);
+	_EgspGetuint8_t(pRun + 97, &pVal->d1);
+	_EgspGetint8_t(pRun + 98, &pVal->d2);
+	_EgspGetint8_t(pRun + 99, &pVal->d3);
+}
+
+static inline void _EgspPutWide(uint8_t* pRun, const Wide* pVal)
+{
+	_EgspPutuint64_t(pRun + 0, &pVal->a0);
+	_EgspPutuint64_t(pRun + 8, &pVal->a1);
+	_EgspPutint64_t(pRun + 16, &pVal->a2);
+	_EgspPutint64_t(pRun + 24, &pVal->a3);
+	_EgspPutdouble(pRun + 32, &pVal->a4);
+	_EgspPutdouble(pRun + 40, &pVal->a5);
+	_EgspPutuint32_t(pRun + 48, &pVal->b0);
+	_EgspPutuint32_t(pRun + 52, &pVal->b1);
+	_EgspPutuint32_t(pRun + 56, &pVal->b2);
+	_EgspPutint32_t(pRun + 60, &pVal->b3);
+	_EgspPutint32_t(pRun + 64, &pVal->b4);
+	_EgspPutint32_t(pRun + 68, &pVal->b5);
+	_EgspPutfloat(pRun + 72, &pVal->b6);
+	_EgspPutfloat(pRun + 76, &pVal->b7);
+	_EgspPutfloat(pRun + 80, &pVal->b8);
+	_EgspPutfloat(pRun + 84, &pVal->b9);
+	_EgspPutuint16_t(pRun + 88, &pVal->c0);
+	_EgspPutuint16_t(pRun + 90, &pVal->c1);
+	_EgspPutint16_t(pRun + 92, &pVal->c2);
+	_EgspPutint16_t(pRun + 94, &pVal->c3);
+	_EgspPutuint8_t(pRun + 96, &pVal->d0);
+	_EgspPutuint8_t(pRun + 97, &pVal->d1);
+	_EgspPutint8_t(pRun + 98, &pVal->d2);
+	_EgspPutint8_t(pRun + 99, &pVal->d3);
+}
+
+static EgspResult _EgspLoadWide(EgspLoader* pLoader, Wide* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 100);
+		if (pRun)
+		{
+			_EgspGetuint64_t(pRun + 0, &pVal->a0);
+			_EgspGetuint64_t(pRun + 8, &pVal->a1);
+			_EgspGetint64_t(pRun + 16, &pVal->a2);
+			_EgspGetint64_t(pRun + 24, &pVal->a3);
+			_EgspGetdouble(pRun + 32, &pVal->a4);
+			_EgspGetdouble(pRun + 40, &pVal->a5);
+			_EgspGetuint32_t(pRun + 48, &pVal->b0);
+			_EgspGetuint32_t(pRun + 52, &pVal->b1);
+			_EgspGetuint32_t(pRun + 56, &pVal->b2);
+			_EgspGetint32_t(pRun + 60, &pVal->b3);
+			_EgspGetint32_t(pRun + 64, &pVal->b4);
+			_EgspGetint32_t(pRun + 68, &pVal->b5);
+			_EgspGetfloat(pRun + 72, &pVal->b6);
+			_EgspGetfloat(pRun + 76, &pVal->b7);
+			_EgspGetfloat(pRun + 80, &pVal->b8);
+			_EgspGetfloat(pRun + 84, &pVal->b9);
+			_EgspGetuint16_t(pRun + 88, &pVal->c0);
+			_EgspGetuint16_t(pRun + 90, &pVal->c1);
+			_EgspGetint16_t(pRun + 92, &pVal->c2);
+			_EgspGetint16_t(pRun + 94, &pVal->c3);
+			_EgspGetuint8_t(pRun + 96, &pVal->d0);
+			_EgspGetuint8_t(pRun + 97, &pVal->d1);
+			_EgspGetint8_t(pRun + 98, &pVal->d2);
+			_EgspGetint8_t(pRun + 99, &pVal->d3);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoaduint64_t(pLoader, &pVal->a0));
+			EGSP_TRY(_EgspLoaduint64_t(pLoader, &pVal->a1));
+			EGSP_TRY(_EgspLoadint64_t(pLoader, &pVal->a2));
+			EGSP_TRY(_EgspLoadint64_t(pLoader, &pVal->a3));
+			EGSP_TRY(_EgspLoaddouble(pLoader, &pVal->a4));
+			EGSP_TRY(_EgspLoaddouble(pLoader, &pVal->a5));
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->b0));
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->b1));
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->b2));
+			EGSP_TRY(_EgspLoadint32_t(pLoader, &pVal->b3));
+			EGSP_TRY(_EgspLoadint32_t(pLoader, &pVal->b4));
+			EGSP_TRY(_EgspLoadint32_t(pLoader, &pVal->b5));
+			EGSP_TRY(_EgspLoadfloat(pLoader, &pVal->b6));
+			EGSP_TRY(_EgspLoadfloat(pLoader, &pVal->b7));
+			EGSP_TRY(_EgspLoadfloat(pLoader, &pVal->b8));
+			EGSP_TRY(_EgspLoadfloat(pLoader, &pVal->b9));
+			EGSP_TRY(_EgspLoaduint16_t(pLoader, &pVal->c0));
+			EGSP_TRY(_EgspLoaduint16_t(pLoader, &pVal->c1));
+			EGSP_TRY(_EgspLoadint16_t(pLoader, &pVal->c2));
+			EGSP_TRY(_EgspLoadint16_t(pLoader, &pVal->c3));
+			EGSP_TRY(_EgspLoaduint8_t(pLoader, &pVal->d0));
+			EGSP_TRY(_EgspLoaduint8_t(pLoader, &pVal->d1));
+			EGSP_TRY(_EgspLoadint8_t(pLoader, &pVal->d2));
+			EGSP_TRY(_EgspLoadint8_t(pLoader, &pVal->d3));
+		}
+	}
+	EGSP_STATS_END(0, "Wide");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadWideEx(EgspLoader* pLoader, Wide* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaWide));
+	return _EgspLoadWide(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadWide(EgspFunc pLoadFunc, Wide* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadWideEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadWideSpan(const uint8_t* pData, size_t size, Wide* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadWideEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureWide(EgspLoader* pLoader, Wide* pVal)
+{
+	_EgspMeasureuint64_t(pLoader, &pVal->a0);
+	_EgspMeasureuint64_t(pLoader, &pVal->a1);
+	_EgspMeasureint64_t(pLoader, &pVal->a2);
+	_EgspMeasureint64_t(pLoader, &pVal->a3);
+	_EgspMeasuredouble(pLoader, &pVal->a4);
+	_EgspMeasuredouble(pLoader, &pVal->a5);
+	_EgspMeasureuint32_t(pLoader, &pVal->b0);
+	_EgspMeasureuint32_t(pLoader, &pVal->b1);
+	_EgspMeasureuint32_t(pLoader, &pVal->b2);
+	_EgspMeasureint32_t(pLoader, &pVal->b3);
+	_EgspMeasureint32_t(pLoader, &pVal->b4);
+	_EgspMeasureint32_t(pLoader, &pVal->b5);
+	_EgspMeasurefloat(pLoader, &pVal->b6);
+	_EgspMeasurefloat(pLoader, &pVal->b7);
+	_EgspMeasurefloat(pLoader, &pVal->b8);
+	_EgspMeasurefloat(pLoader, &pVal->b9);
+	_EgspMeasureuint16_t(pLoader, &pVal->c0);
+	_EgspMeasureuint16_t(pLoader, &pVal->c1);
+	_EgspMeasureint16_t(pLoader, &pVal->c2);
+	_EgspMeasureint16_t(pLoader, &pVal->c3);
+	_EgspMeasureuint8_t(pLoader, &pVal->d0);
+	_EgspMeasureuint8_t(pLoader, &pVal->d1);
+	_EgspMeasureint8_t(pLoader, &pVal->d2);
+	_EgspMeasureint8_t(pLoader, &pVal->d3);
+}
+
+static inline size_t EgspMeasureWideEx(EgspLoader* pLoader, Wide* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureWide(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureWide(Wide* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureWideEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveWide(EgspLoader* pLoader, Wide* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 100);
+		if (pRun)
+		{
+			_EgspPutuint64_t(pRun + 0, &pVal->a0);
+			_EgspPutuint64_t(pRun + 8, &pVal->a1);
+			_EgspPutint64_t(pRun + 16, &pVal->a2);
+			_EgspPutint64_t(pRun + 24, &pVal->a3);
+			_EgspPutdouble(pRun + 32, &pVal->a4);
+			_EgspPutdouble(pRun + 40, &pVal->a5);
+			_EgspPutuint32_t(pRun + 48, &pVal->b0);
+			_EgspPutuint32_t(pRun + 52, &pVal->b1);
+			_EgspPutuint32_t(pRun + 56, &pVal->b2);
+			_EgspPutint32_t(pRun + 60, &pVal->b3);
+			_EgspPutint32_t(pRun + 64, &pVal->b4);
+			_EgspPutint32_t(pRun + 68, &pVal->b5);
+			_EgspPutfloat(pRun + 72, &pVal->b6);
+			_EgspPutfloat(pRun + 76, &pVal->b7);
+			_EgspPutfloat(pRun + 80, &pVal->b8);
+			_EgspPutfloat(pRun + 84, &pVal->b9);
+			_EgspPutuint16_t(pRun + 88, &pVal->c0);
+			_EgspPutuint16_t(pRun + 90, &pVal->c1);
+			_EgspPutint16_t(pRun + 92, &pVal->c2);
+			_EgspPutint16_t(pRun + 94, &pVal->c3);
+			_EgspPutuint8_t(pRun + 96, &pVal->d0);
+			_EgspPutuint8_t(pRun + 97, &pVal->d1);
+			_EgspPutint8_t(pRun + 98, &pVal->d2);
+			_EgspPutint8_t(pRun + 99, &pVal->d3);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveuint64_t(pLoader, &pVal->a0));
+			EGSP_TRY(_EgspSaveuint64_t(pLoader, &pVal->a1));
+			EGSP_TRY(_EgspSaveint64_t(pLoader, &pVal->a2));
+			EGSP_TRY(_EgspSaveint64_t(pLoader, &pVal->a3));
+			EGSP_TRY(_EgspSavedouble(pLoader, &pVal->a4));
+			EGSP_TRY(_EgspSavedouble(pLoader, &pVal->a5));
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->b0));
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->b1));
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->b2));
+			EGSP_TRY(_EgspSaveint32_t(pLoader, &pVal->b3));
+			EGSP_TRY(_EgspSaveint32_t(pLoader, &pVal->b4));
+			EGSP_TRY(_EgspSaveint32_t(pLoader, &pVal->b5));
+			EGSP_TRY(_EgspSavefloat(pLoader, &pVal->b6));
+			EGSP_TRY(_EgspSavefloat(pLoader, &pVal->b7));
+			EGSP_TRY(_EgspSavefloat(pLoader, &pVal->b8));
+			EGSP_TRY(_EgspSavefloat(pLoader, &pVal->b9));
+			EGSP_TRY(_EgspSaveuint16_t(pLoader, &pVal->c0));
+			EGSP_TRY(_EgspSaveuint16_t(pLoader, &pVal->c1));
+			EGSP_TRY(_EgspSaveint16_t(pLoader, &pVal->c2));
+			EGSP_TRY(_EgspSaveint16_t(pLoader, &pVal->c3));
+			EGSP_TRY(_EgspSaveuint8_t(pLoader, &pVal->d0));
+			EGSP_TRY(_EgspSaveuint8_t(pLoader, &pVal->d1));
+			EGSP_TRY(_EgspSaveint8_t(pLoader, &pVal->d2));
+			EGSP_TRY(_EgspSaveint8_t(pLoader, &pVal->d3));
+		}
+	}
+	EGSP_STATS_END(0, "Wide");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveWideEx(EgspLoader* pLoader, Wide* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureWideEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaWide, size, heapSize));
+	EGSP_TRY(_EgspSaveWide(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveWide(EgspFunc pFlushFunc, Wide* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveWideEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveWideSpan(uint8_t* pData, size_t size, Wide* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveWideEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsWide[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, a0), sizeof(((Wide*)0)->a0), 0, 0, 0, "a0" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, a1), sizeof(((Wide*)0)->a1), 0, 0, 0, "a1" },
+	{ EGSP_KIND_SIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, a2), sizeof(((Wide*)0)->a2), 0, 0, 0, "a2" },
+	{ EGSP_KIND_SIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, a3), sizeof(((Wide*)0)->a3), 0, 0, 0, "a3" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Wide, a4), sizeof(((Wide*)0)->a4), 0, 0, 0, "a4" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Wide, a5), sizeof(((Wide*)0)->a5), 0, 0, 0, "a5" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, b0), sizeof(((Wide*)0)->b0), 0, 0, 0, "b0" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, b1), sizeof(((Wide*)0)->b1), 0, 0, 0, "b1" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, b2), sizeof(((Wide*)0)->b2), 0, 0, 0, "b2" },
+	{ EGSP_KIND_SIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, b3), sizeof(((Wide*)0)->b3), 0, 0, 0, "b3" },
+	{ EGSP_KIND_SIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, b4), sizeof(((Wide*)0)->b4), 0, 0, 0, "b4" },
+	{ EGSP_KIND_SIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, b5), sizeof(((Wide*)0)->b5), 0, 0, 0, "b5" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Wide, b6), sizeof(((Wide*)0)->b6), 0, 0, 0, "b6" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Wide, b7), sizeof(((Wide*)0)->b7), 0, 0, 0, "b7" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Wide, b8), sizeof(((Wide*)0)->b8), 0, 0, 0, "b8" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Wide, b9), sizeof(((Wide*)0)->b9), 0, 0, 0, "b9" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, c0), sizeof(((Wide*)0)->c0), 0, 0, 0, "c0" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, c1), sizeof(((Wide*)0)->c1), 0, 0, 0, "c1" },
+	{ EGSP_KIND_SIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, c2), sizeof(((Wide*)0)->c2), 0, 0, 0, "c2" },
+	{ EGSP_KIND_SIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, c3), sizeof(((Wide*)0)->c3), 0, 0, 0, "c3" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, d0), sizeof(((Wide*)0)->d0), 0, 0, 0, "d0" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, d1), sizeof(((Wide*)0)->d1), 0, 0, 0, "d1" },
+	{ EGSP_KIND_SIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, d2), sizeof(((Wide*)0)->d2), 0, 0, 0, "d2" },
+	{ EGSP_KIND_SIGNED, EGSP_SHAPE_VALUE, offsetof(Wide, d3), sizeof(((Wide*)0)->d3), 0, 0, 0, "d3" },
+};
+
+static const EgspStructInfo s_egspInfoWide = { sizeof(Wide), s_egspFieldsWide, 24, 0, s_egspSchemaWide, 100, "Wide", 0 };
+
+static EgspResult _EgspPrintWide(EgspLoader* pLoader, Wide* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"a0\":", 5));
+	EGSP_TRY(_EgspPrintuint64_t(pLoader, &pVal->a0));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"a1\":", 5));
+	EGSP_TRY(_EgspPrintuint64_t(pLoader, &pVal->a1));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"a2\":", 5));
+	EGSP_TRY(_EgspPrintint64_t(pLoader, &pVal->a2));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"a3\":", 5));
+	EGSP_TRY(_EgspPrintint64_t(pLoader, &pVal->a3));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"a4\":", 5));
+	EGSP_TRY(_EgspPrintdouble(pLoader, &pVal->a4));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"a5\":", 5));
+	EGSP_TRY(_EgspPrintdouble(pLoader, &pVal->a5));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"b0\":", 5));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->b0));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"b1\":", 5));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->b1));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"b2\":", 5));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->b2));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"b3\":", 5));
+	EGSP_TRY(_EgspPrintint32_t(pLoader, &pVal->b3));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"b4\":", 5));
+	EGSP_TRY(_EgspPrintint32_t(pLoader, &pVal->b4));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"b5\":", 5));
+	EGSP_TRY(_EgspPrintint32_t(pLoader, &pVal->b5));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"b6\":", 5));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->b6));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"b7\":", 5));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->b7));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"b8\":", 5));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->b8));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"b9\":", 5));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->b9));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"c0\":", 5));
+	EGSP_TRY(_EgspPrintuint16_t(pLoader, &pVal->c0));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"c1\":", 5));
+	EGSP_TRY(_EgspPrintuint16_t(pLoader, &pVal->c1));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"c2\":", 5));
+	EGSP_TRY(_EgspPrintint16_t(pLoader, &pVal->c2));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"c3\":", 5));
+	EGSP_TRY(_EgspPrintint16_t(pLoader, &pVal->c3));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"d0\":", 5));
+	EGSP_TRY(_EgspPrintuint8_t(pLoader, &pVal->d0));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"d1\":", 5));
+	EGSP_TRY(_EgspPrintuint8_t(pLoader, &pVal->d1));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"d2\":", 5));
+	EGSP_TRY(_EgspPrintint8_t(pLoader, &pVal->d2));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"d3\":", 5));
+	EGSP_TRY(_EgspPrintint8_t(pLoader, &pVal->d3));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(0, "Wide");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintWideEx(EgspLoader* pLoader, Wide* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintWide(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintWide(EgspFunc pFlushFunc, Wide* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintWideEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadWide(EgspLoader* pLoader, Wide* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint64_t(pLoader, &pVal->a0));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint64_t(pLoader, &pVal->a1));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadint64_t(pLoader, &pVal->a2));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadint64_t(pLoader, &pVal->a3));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaddouble(pLoader, &pVal->a4));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaddouble(pLoader, &pVal->a5));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->b0));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->b1));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->b2));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadint32_t(pLoader, &pVal->b3));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadint32_t(pLoader, &pVal->b4));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadint32_t(pLoader, &pVal->b5));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->b6));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->b7));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->b8));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->b9));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint16_t(pLoader, &pVal->c0));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint16_t(pLoader, &pVal->c1));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadint16_t(pLoader, &pVal->c2));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadint16_t(pLoader, &pVal->c3));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint8_t(pLoader, &pVal->d0));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint8_t(pLoader, &pVal->d1));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadint8_t(pLoader, &pVal->d2));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadint8_t(pLoader, &pVal->d3));
+	EGSP_STATS_END(0, "Wide");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadWideEx(EgspLoader* pLoader, Wide* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadWide(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadWide(EgspFunc pLoadFunc, Wide* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadWideEx(&loader, pVal, pHeap, heapSize);
+}
+
+static EgspResult _EgspSaveElementWide(EgspLoader* pLoader, const void* pVal)
+{
+	return _EgspSaveWide(pLoader, (Wide*)pVal);
+}
+
+static const uint64_t s_egspSchemaWideSet = 0xc093f12e0b757334ull;
+
+static EgspResult _EgspLoadWideSet(EgspLoader* pLoader, WideSet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->count));
+	if ((pVal->items = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->items)) * pVal->count)))
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspLoadWide(pLoader, pVal->items + i));
+		}
+	}
+	EGSP_STATS_END(1, "WideSet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadWideSetEx(EgspLoader* pLoader, WideSet* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaWideSet));
+	return _EgspLoadWideSet(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadWideSet(EgspFunc pLoadFunc, WideSet* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadWideSetEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadWideSetSpan(const uint8_t* pData, size_t size, WideSet* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadWideSetEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureWideSet(EgspLoader* pLoader, WideSet* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->count);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->items)) * pVal->count;
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		_EgspMeasureWide(pLoader, pVal->items + i);
+	}
+}
+
+static inline size_t EgspMeasureWideSetEx(EgspLoader* pLoader, WideSet* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureWideSet(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureWideSet(WideSet* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureWideSetEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveWideSet(EgspLoader* pLoader, WideSet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->items)) * pVal->count;
+	if (_EgspParallel(pLoader, pVal->count))
+	{
+		EGSP_TRY(_EgspSaveArrayParallel(pLoader, pVal->items, pVal->count, sizeof(*pVal->items), _EgspSaveElementWide));
+	}
+	else
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspSaveWide(pLoader, pVal->items + i));
+		}
+	}
+	EGSP_STATS_END(1, "WideSet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveWideSetEx(EgspLoader* pLoader, WideSet* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureWideSetEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaWideSet, size, heapSize));
+	EGSP_TRY(_EgspSaveWideSet(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveWideSet(EgspFunc pFlushFunc, WideSet* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveWideSetEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveWideSetSpan(uint8_t* pData, size_t size, WideSet* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveWideSetEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsWideSet[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(WideSet, count), sizeof(((WideSet*)0)->count), 0, 0, 0, "count" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_ARRAY, offsetof(WideSet, items), sizeof(*((WideSet*)0)->items), offsetof(WideSet, count), sizeof(((WideSet*)0)->count), &s_egspInfoWide, "items" },
+};
+
+static const EgspStructInfo s_egspInfoWideSet = { sizeof(WideSet), s_egspFieldsWideSet, 2, 0, s_egspSchemaWideSet, 0, "WideSet", 1 };
+
+static EgspResult _EgspPrintWideSet(EgspLoader* pLoader, WideSet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"count\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->items)) * pVal->count;
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"items\":", 8));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		EGSP_TRY(_EgspPrintWide(pLoader, pVal->items + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"))
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(1, "WideSet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintWideSetEx(EgspLoader* pLoader, WideSet* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintWideSet(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintWideSet(EgspFunc pFlushFunc, WideSet* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintWideSetEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadWideSet(EgspLoader* pLoader, WideSet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->count));
+	if ((pVal->items = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->items)) * pVal->count)))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspReadWide(pLoader, pVal->items + i));
+		}
+	}
+	EGSP_STATS_END(1, "WideSet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadWideSetEx(EgspLoader* pLoader, WideSet* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadWideSet(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadWideSet(EgspFunc pLoadFunc, WideSet* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadWideSetEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaDeep7 = 0x33412b92b3d352acull;
+
+static inline void _EgspGetDeep7(const uint8_t* pRun, Deep7* pVal)
+{
+	_EgspGetuint32_t(pRun + 0, &pVal->value);
+}
+
+static inline void _EgspPutDeep7(uint8_t* pRun, const Deep7* pVal)
+{
+	_EgspPutuint32_t(pRun + 0, &pVal->value);
+}
+
+static EgspResult _EgspLoadDeep7(EgspLoader* pLoader, Deep7* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->value));
+	EGSP_STATS_END(2, "Deep7");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadDeep7Ex(EgspLoader* pLoader, Deep7* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaDeep7));
+	return _EgspLoadDeep7(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadDeep7(EgspFunc pLoadFunc, Deep7* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadDeep7Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadDeep7Span(const uint8_t* pData, size_t size, Deep7* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadDeep7Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureDeep7(EgspLoader* pLoader, Deep7* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->value);
+}
+
+static inline size_t EgspMeasureDeep7Ex(EgspLoader* pLoader, Deep7* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureDeep7(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureDeep7(Deep7* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureDeep7Ex(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveDeep7(EgspLoader* pLoader, Deep7* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->value));
+	EGSP_STATS_END(2, "Deep7");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep7Ex(EgspLoader* pLoader, Deep7* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureDeep7Ex(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaDeep7, size, heapSize));
+	EGSP_TRY(_EgspSaveDeep7(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveDeep7(EgspFunc pFlushFunc, Deep7* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveDeep7Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep7Span(uint8_t* pData, size_t size, Deep7* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveDeep7Ex(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsDeep7[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Deep7, value), sizeof(((Deep7*)0)->value), 0, 0, 0, "value" },
+};
+
+static const EgspStructInfo s_egspInfoDeep7 = { sizeof(Deep7), s_egspFieldsDeep7, 1, 0, s_egspSchemaDeep7, 4, "Deep7", 2 };
+
+static EgspResult _EgspPrintDeep7(EgspLoader* pLoader, Deep7* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"value\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(2, "Deep7");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintDeep7Ex(EgspLoader* pLoader, Deep7* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintDeep7(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintDeep7(EgspFunc pFlushFunc, Deep7* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintDeep7Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadDeep7(EgspLoader* pLoader, Deep7* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->value));
+	EGSP_STATS_END(2, "Deep7");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadDeep7Ex(EgspLoader* pLoader, Deep7* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadDeep7(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadDeep7(EgspFunc pLoadFunc, Deep7* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadDeep7Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaDeep6 = 0x1e9424dfda08d1efull;
+
+static inline void _EgspGetDeep6(const uint8_t* pRun, Deep6* pVal)
+{
+	_EgspGetuint32_t(pRun + 0, &pVal->value);
+	_EgspGetDeep7(pRun + 4, &pVal->next);
+}
+
+static inline void _EgspPutDeep6(uint8_t* pRun, const Deep6* pVal)
+{
+	_EgspPutuint32_t(pRun + 0, &pVal->value);
+	_EgspPutDeep7(pRun + 4, &pVal->next);
+}
+
+static EgspResult _EgspLoadDeep6(EgspLoader* pLoader, Deep6* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 8);
+		if (pRun)
+		{
+			_EgspGetuint32_t(pRun + 0, &pVal->value);
+			_EgspGetDeep7(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspLoadDeep7(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(3, "Deep6");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadDeep6Ex(EgspLoader* pLoader, Deep6* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaDeep6));
+	return _EgspLoadDeep6(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadDeep6(EgspFunc pLoadFunc, Deep6* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadDeep6Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadDeep6Span(const uint8_t* pData, size_t size, Deep6* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadDeep6Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureDeep6(EgspLoader* pLoader, Deep6* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->value);
+	_EgspMeasureDeep7(pLoader, &pVal->next);
+}
+
+static inline size_t EgspMeasureDeep6Ex(EgspLoader* pLoader, Deep6* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureDeep6(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureDeep6(Deep6* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureDeep6Ex(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveDeep6(EgspLoader* pLoader, Deep6* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 8);
+		if (pRun)
+		{
+			_EgspPutuint32_t(pRun + 0, &pVal->value);
+			_EgspPutDeep7(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspSaveDeep7(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(3, "Deep6");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep6Ex(EgspLoader* pLoader, Deep6* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureDeep6Ex(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaDeep6, size, heapSize));
+	EGSP_TRY(_EgspSaveDeep6(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveDeep6(EgspFunc pFlushFunc, Deep6* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveDeep6Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep6Span(uint8_t* pData, size_t size, Deep6* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveDeep6Ex(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsDeep6[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Deep6, value), sizeof(((Deep6*)0)->value), 0, 0, 0, "value" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_VALUE, offsetof(Deep6, next), sizeof(((Deep6*)0)->next), 0, 0, &s_egspInfoDeep7, "next" },
+};
+
+static const EgspStructInfo s_egspInfoDeep6 = { sizeof(Deep6), s_egspFieldsDeep6, 2, 0, s_egspSchemaDeep6, 8, "Deep6", 3 };
+
+static EgspResult _EgspPrintDeep6(EgspLoader* pLoader, Deep6* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"value\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"next\":", 7));
+	EGSP_TRY(_EgspPrintDeep7(pLoader, &pVal->next));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(3, "Deep6");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintDeep6Ex(EgspLoader* pLoader, Deep6* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintDeep6(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintDeep6(EgspFunc pFlushFunc, Deep6* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintDeep6Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadDeep6(EgspLoader* pLoader, Deep6* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadDeep7(pLoader, &pVal->next));
+	EGSP_STATS_END(3, "Deep6");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadDeep6Ex(EgspLoader* pLoader, Deep6* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadDeep6(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadDeep6(EgspFunc pLoadFunc, Deep6* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadDeep6Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaDeep5 = 0x583ab0be69c1a8dfull;
+
+static inline void _EgspGetDeep5(const uint8_t* pRun, Deep5* pVal)
+{
+	_EgspGetuint32_t(pRun + 0, &pVal->value);
+	_EgspGetDeep6(pRun + 4, &pVal->next);
+}
+
+static inline void _EgspPutDeep5(uint8_t* pRun, const Deep5* pVal)
+{
+	_EgspPutuint32_t(pRun + 0, &pVal->value);
+	_EgspPutDeep6(pRun + 4, &pVal->next);
+}
+
+static EgspResult _EgspLoadDeep5(EgspLoader* pLoader, Deep5* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 12);
+		if (pRun)
+		{
+			_EgspGetuint32_t(pRun + 0, &pVal->value);
+			_EgspGetDeep6(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspLoadDeep6(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(4, "Deep5");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadDeep5Ex(EgspLoader* pLoader, Deep5* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaDeep5));
+	return _EgspLoadDeep5(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadDeep5(EgspFunc pLoadFunc, Deep5* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadDeep5Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadDeep5Span(const uint8_t* pData, size_t size, Deep5* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadDeep5Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureDeep5(EgspLoader* pLoader, Deep5* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->value);
+	_EgspMeasureDeep6(pLoader, &pVal->next);
+}
+
+static inline size_t EgspMeasureDeep5Ex(EgspLoader* pLoader, Deep5* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureDeep5(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureDeep5(Deep5* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureDeep5Ex(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveDeep5(EgspLoader* pLoader, Deep5* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 12);
+		if (pRun)
+		{
+			_EgspPutuint32_t(pRun + 0, &pVal->value);
+			_EgspPutDeep6(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspSaveDeep6(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(4, "Deep5");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep5Ex(EgspLoader* pLoader, Deep5* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureDeep5Ex(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaDeep5, size, heapSize));
+	EGSP_TRY(_EgspSaveDeep5(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveDeep5(EgspFunc pFlushFunc, Deep5* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveDeep5Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep5Span(uint8_t* pData, size_t size, Deep5* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveDeep5Ex(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsDeep5[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Deep5, value), sizeof(((Deep5*)0)->value), 0, 0, 0, "value" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_VALUE, offsetof(Deep5, next), sizeof(((Deep5*)0)->next), 0, 0, &s_egspInfoDeep6, "next" },
+};
+
+static const EgspStructInfo s_egspInfoDeep5 = { sizeof(Deep5), s_egspFieldsDeep5, 2, 0, s_egspSchemaDeep5, 12, "Deep5", 4 };
+
+static EgspResult _EgspPrintDeep5(EgspLoader* pLoader, Deep5* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"value\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"next\":", 7));
+	EGSP_TRY(_EgspPrintDeep6(pLoader, &pVal->next));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(4, "Deep5");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintDeep5Ex(EgspLoader* pLoader, Deep5* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintDeep5(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintDeep5(EgspFunc pFlushFunc, Deep5* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintDeep5Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadDeep5(EgspLoader* pLoader, Deep5* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadDeep6(pLoader, &pVal->next));
+	EGSP_STATS_END(4, "Deep5");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadDeep5Ex(EgspLoader* pLoader, Deep5* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadDeep5(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadDeep5(EgspFunc pLoadFunc, Deep5* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadDeep5Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaDeep4 = 0x797ccd78a39137a9ull;
+
+static inline void _EgspGetDeep4(const uint8_t* pRun, Deep4* pVal)
+{
+	_EgspGetuint32_t(pRun + 0, &pVal->value);
+	_EgspGetDeep5(pRun + 4, &pVal->next);
+}
+
+static inline void _EgspPutDeep4(uint8_t* pRun, const Deep4* pVal)
+{
+	_EgspPutuint32_t(pRun + 0, &pVal->value);
+	_EgspPutDeep5(pRun + 4, &pVal->next);
+}
+
+static EgspResult _EgspLoadDeep4(EgspLoader* pLoader, Deep4* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 16);
+		if (pRun)
+		{
+			_EgspGetuint32_t(pRun + 0, &pVal->value);
+			_EgspGetDeep5(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspLoadDeep5(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(5, "Deep4");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadDeep4Ex(EgspLoader* pLoader, Deep4* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaDeep4));
+	return _EgspLoadDeep4(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadDeep4(EgspFunc pLoadFunc, Deep4* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadDeep4Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadDeep4Span(const uint8_t* pData, size_t size, Deep4* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadDeep4Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureDeep4(EgspLoader* pLoader, Deep4* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->value);
+	_EgspMeasureDeep5(pLoader, &pVal->next);
+}
+
+static inline size_t EgspMeasureDeep4Ex(EgspLoader* pLoader, Deep4* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureDeep4(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureDeep4(Deep4* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureDeep4Ex(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveDeep4(EgspLoader* pLoader, Deep4* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 16);
+		if (pRun)
+		{
+			_EgspPutuint32_t(pRun + 0, &pVal->value);
+			_EgspPutDeep5(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspSaveDeep5(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(5, "Deep4");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep4Ex(EgspLoader* pLoader, Deep4* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureDeep4Ex(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaDeep4, size, heapSize));
+	EGSP_TRY(_EgspSaveDeep4(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveDeep4(EgspFunc pFlushFunc, Deep4* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveDeep4Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep4Span(uint8_t* pData, size_t size, Deep4* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveDeep4Ex(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsDeep4[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Deep4, value), sizeof(((Deep4*)0)->value), 0, 0, 0, "value" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_VALUE, offsetof(Deep4, next), sizeof(((Deep4*)0)->next), 0, 0, &s_egspInfoDeep5, "next" },
+};
+
+static const EgspStructInfo s_egspInfoDeep4 = { sizeof(Deep4), s_egspFieldsDeep4, 2, 0, s_egspSchemaDeep4, 16, "Deep4", 5 };
+
+static EgspResult _EgspPrintDeep4(EgspLoader* pLoader, Deep4* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"value\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"next\":", 7));
+	EGSP_TRY(_EgspPrintDeep5(pLoader, &pVal->next));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(5, "Deep4");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintDeep4Ex(EgspLoader* pLoader, Deep4* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintDeep4(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintDeep4(EgspFunc pFlushFunc, Deep4* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintDeep4Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadDeep4(EgspLoader* pLoader, Deep4* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadDeep5(pLoader, &pVal->next));
+	EGSP_STATS_END(5, "Deep4");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadDeep4Ex(EgspLoader* pLoader, Deep4* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadDeep4(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadDeep4(EgspFunc pLoadFunc, Deep4* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadDeep4Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaDeep3 = 0x045703f14a073540ull;
+
+static inline void _EgspGetDeep3(const uint8_t* pRun, Deep3* pVal)
+{
+	_EgspGetuint32_t(pRun + 0, &pVal->value);
+	_EgspGetDeep4(pRun + 4, &pVal->next);
+}
+
+static inline void _EgspPutDeep3(uint8_t* pRun, const Deep3* pVal)
+{
+	_EgspPutuint32_t(pRun + 0, &pVal->value);
+	_EgspPutDeep4(pRun + 4, &pVal->next);
+}
+
+static EgspResult _EgspLoadDeep3(EgspLoader* pLoader, Deep3* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 20);
+		if (pRun)
+		{
+			_EgspGetuint32_t(pRun + 0, &pVal->value);
+			_EgspGetDeep4(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspLoadDeep4(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(6, "Deep3");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadDeep3Ex(EgspLoader* pLoader, Deep3* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaDeep3));
+	return _EgspLoadDeep3(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadDeep3(EgspFunc pLoadFunc, Deep3* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadDeep3Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadDeep3Span(const uint8_t* pData, size_t size, Deep3* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadDeep3Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureDeep3(EgspLoader* pLoader, Deep3* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->value);
+	_EgspMeasureDeep4(pLoader, &pVal->next);
+}
+
+static inline size_t EgspMeasureDeep3Ex(EgspLoader* pLoader, Deep3* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureDeep3(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureDeep3(Deep3* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureDeep3Ex(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveDeep3(EgspLoader* pLoader, Deep3* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 20);
+		if (pRun)
+		{
+			_EgspPutuint32_t(pRun + 0, &pVal->value);
+			_EgspPutDeep4(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspSaveDeep4(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(6, "Deep3");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep3Ex(EgspLoader* pLoader, Deep3* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureDeep3Ex(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaDeep3, size, heapSize));
+	EGSP_TRY(_EgspSaveDeep3(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveDeep3(EgspFunc pFlushFunc, Deep3* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveDeep3Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep3Span(uint8_t* pData, size_t size, Deep3* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveDeep3Ex(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsDeep3[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Deep3, value), sizeof(((Deep3*)0)->value), 0, 0, 0, "value" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_VALUE, offsetof(Deep3, next), sizeof(((Deep3*)0)->next), 0, 0, &s_egspInfoDeep4, "next" },
+};
+
+static const EgspStructInfo s_egspInfoDeep3 = { sizeof(Deep3), s_egspFieldsDeep3, 2, 0, s_egspSchemaDeep3, 20, "Deep3", 6 };
+
+static EgspResult _EgspPrintDeep3(EgspLoader* pLoader, Deep3* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"value\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"next\":", 7));
+	EGSP_TRY(_EgspPrintDeep4(pLoader, &pVal->next));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(6, "Deep3");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintDeep3Ex(EgspLoader* pLoader, Deep3* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintDeep3(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintDeep3(EgspFunc pFlushFunc, Deep3* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintDeep3Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadDeep3(EgspLoader* pLoader, Deep3* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadDeep4(pLoader, &pVal->next));
+	EGSP_STATS_END(6, "Deep3");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadDeep3Ex(EgspLoader* pLoader, Deep3* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadDeep3(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadDeep3(EgspFunc pLoadFunc, Deep3* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadDeep3Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaDeep2 = 0x0f84c7593cbc7555ull;
+
+static inline void _EgspGetDeep2(const uint8_t* pRun, Deep2* pVal)
+{
+	_EgspGetuint32_t(pRun + 0, &pVal->value);
+	_EgspGetDeep3(pRun + 4, &pVal->next);
+}
+
+static inline void _EgspPutDeep2(uint8_t* pRun, const Deep2* pVal)
+{
+	_EgspPutuint32_t(pRun + 0, &pVal->value);
+	_EgspPutDeep3(pRun + 4, &pVal->next);
+}
+
+static EgspResult _EgspLoadDeep2(EgspLoader* pLoader, Deep2* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 24);
+		if (pRun)
+		{
+			_EgspGetuint32_t(pRun + 0, &pVal->value);
+			_EgspGetDeep3(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspLoadDeep3(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(7, "Deep2");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadDeep2Ex(EgspLoader* pLoader, Deep2* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaDeep2));
+	return _EgspLoadDeep2(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadDeep2(EgspFunc pLoadFunc, Deep2* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadDeep2Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadDeep2Span(const uint8_t* pData, size_t size, Deep2* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadDeep2Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureDeep2(EgspLoader* pLoader, Deep2* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->value);
+	_EgspMeasureDeep3(pLoader, &pVal->next);
+}
+
+static inline size_t EgspMeasureDeep2Ex(EgspLoader* pLoader, Deep2* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureDeep2(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureDeep2(Deep2* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureDeep2Ex(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveDeep2(EgspLoader* pLoader, Deep2* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 24);
+		if (pRun)
+		{
+			_EgspPutuint32_t(pRun + 0, &pVal->value);
+			_EgspPutDeep3(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspSaveDeep3(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(7, "Deep2");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep2Ex(EgspLoader* pLoader, Deep2* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureDeep2Ex(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaDeep2, size, heapSize));
+	EGSP_TRY(_EgspSaveDeep2(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveDeep2(EgspFunc pFlushFunc, Deep2* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveDeep2Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep2Span(uint8_t* pData, size_t size, Deep2* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveDeep2Ex(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsDeep2[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Deep2, value), sizeof(((Deep2*)0)->value), 0, 0, 0, "value" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_VALUE, offsetof(Deep2, next), sizeof(((Deep2*)0)->next), 0, 0, &s_egspInfoDeep3, "next" },
+};
+
+static const EgspStructInfo s_egspInfoDeep2 = { sizeof(Deep2), s_egspFieldsDeep2, 2, 0, s_egspSchemaDeep2, 24, "Deep2", 7 };
+
+static EgspResult _EgspPrintDeep2(EgspLoader* pLoader, Deep2* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"value\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"next\":", 7));
+	EGSP_TRY(_EgspPrintDeep3(pLoader, &pVal->next));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(7, "Deep2");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintDeep2Ex(EgspLoader* pLoader, Deep2* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintDeep2(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintDeep2(EgspFunc pFlushFunc, Deep2* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintDeep2Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadDeep2(EgspLoader* pLoader, Deep2* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadDeep3(pLoader, &pVal->next));
+	EGSP_STATS_END(7, "Deep2");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadDeep2Ex(EgspLoader* pLoader, Deep2* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadDeep2(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadDeep2(EgspFunc pLoadFunc, Deep2* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadDeep2Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaDeep1 = 0x0d5e2ba829831407ull;
+
+static inline void _EgspGetDeep1(const uint8_t* pRun, Deep1* pVal)
+{
+	_EgspGetuint32_t(pRun + 0, &pVal->value);
+	_EgspGetDeep2(pRun + 4, &pVal->next);
+}
+
+static inline void _EgspPutDeep1(uint8_t* pRun, const Deep1* pVal)
+{
+	_EgspPutuint32_t(pRun + 0, &pVal->value);
+	_EgspPutDeep2(pRun + 4, &pVal->next);
+}
+
+static EgspResult _EgspLoadDeep1(EgspLoader* pLoader, Deep1* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 28);
+		if (pRun)
+		{
+			_EgspGetuint32_t(pRun + 0, &pVal->value);
+			_EgspGetDeep2(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspLoadDeep2(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(8, "Deep1");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadDeep1Ex(EgspLoader* pLoader, Deep1* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaDeep1));
+	return _EgspLoadDeep1(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadDeep1(EgspFunc pLoadFunc, Deep1* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadDeep1Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadDeep1Span(const uint8_t* pData, size_t size, Deep1* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadDeep1Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureDeep1(EgspLoader* pLoader, Deep1* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->value);
+	_EgspMeasureDeep2(pLoader, &pVal->next);
+}
+
+static inline size_t EgspMeasureDeep1Ex(EgspLoader* pLoader, Deep1* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureDeep1(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureDeep1(Deep1* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureDeep1Ex(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveDeep1(EgspLoader* pLoader, Deep1* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 28);
+		if (pRun)
+		{
+			_EgspPutuint32_t(pRun + 0, &pVal->value);
+			_EgspPutDeep2(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspSaveDeep2(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(8, "Deep1");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep1Ex(EgspLoader* pLoader, Deep1* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureDeep1Ex(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaDeep1, size, heapSize));
+	EGSP_TRY(_EgspSaveDeep1(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveDeep1(EgspFunc pFlushFunc, Deep1* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveDeep1Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep1Span(uint8_t* pData, size_t size, Deep1* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveDeep1Ex(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsDeep1[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Deep1, value), sizeof(((Deep1*)0)->value), 0, 0, 0, "value" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_VALUE, offsetof(Deep1, next), sizeof(((Deep1*)0)->next), 0, 0, &s_egspInfoDeep2, "next" },
+};
+
+static const EgspStructInfo s_egspInfoDeep1 = { sizeof(Deep1), s_egspFieldsDeep1, 2, 0, s_egspSchemaDeep1, 28, "Deep1", 8 };
+
+static EgspResult _EgspPrintDeep1(EgspLoader* pLoader, Deep1* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"value\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"next\":", 7));
+	EGSP_TRY(_EgspPrintDeep2(pLoader, &pVal->next));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(8, "Deep1");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintDeep1Ex(EgspLoader* pLoader, Deep1* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintDeep1(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintDeep1(EgspFunc pFlushFunc, Deep1* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintDeep1Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadDeep1(EgspLoader* pLoader, Deep1* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadDeep2(pLoader, &pVal->next));
+	EGSP_STATS_END(8, "Deep1");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadDeep1Ex(EgspLoader* pLoader, Deep1* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadDeep1(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadDeep1(EgspFunc pLoadFunc, Deep1* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadDeep1Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaDeep0 = 0x968df07ec969c9c3ull;
+
+static inline void _EgspGetDeep0(const uint8_t* pRun, Deep0* pVal)
+{
+	_EgspGetuint32_t(pRun + 0, &pVal->value);
+	_EgspGetDeep1(pRun + 4, &pVal->next);
+}
+
+static inline void _EgspPutDeep0(uint8_t* pRun, const Deep0* pVal)
+{
+	_EgspPutuint32_t(pRun + 0, &pVal->value);
+	_EgspPutDeep1(pRun + 4, &pVal->next);
+}
+
+static EgspResult _EgspLoadDeep0(EgspLoader* pLoader, Deep0* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 32);
+		if (pRun)
+		{
+			_EgspGetuint32_t(pRun + 0, &pVal->value);
+			_EgspGetDeep1(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspLoadDeep1(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(9, "Deep0");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadDeep0Ex(EgspLoader* pLoader, Deep0* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaDeep0));
+	return _EgspLoadDeep0(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadDeep0(EgspFunc pLoadFunc, Deep0* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadDeep0Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadDeep0Span(const uint8_t* pData, size_t size, Deep0* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadDeep0Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureDeep0(EgspLoader* pLoader, Deep0* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->value);
+	_EgspMeasureDeep1(pLoader, &pVal->next);
+}
+
+static inline size_t EgspMeasureDeep0Ex(EgspLoader* pLoader, Deep0* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureDeep0(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureDeep0(Deep0* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureDeep0Ex(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveDeep0(EgspLoader* pLoader, Deep0* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 32);
+		if (pRun)
+		{
+			_EgspPutuint32_t(pRun + 0, &pVal->value);
+			_EgspPutDeep1(pRun + 4, &pVal->next);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->value));
+			EGSP_TRY(_EgspSaveDeep1(pLoader, &pVal->next));
+		}
+	}
+	EGSP_STATS_END(9, "Deep0");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep0Ex(EgspLoader* pLoader, Deep0* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureDeep0Ex(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaDeep0, size, heapSize));
+	EGSP_TRY(_EgspSaveDeep0(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveDeep0(EgspFunc pFlushFunc, Deep0* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveDeep0Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeep0Span(uint8_t* pData, size_t size, Deep0* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveDeep0Ex(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsDeep0[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Deep0, value), sizeof(((Deep0*)0)->value), 0, 0, 0, "value" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_VALUE, offsetof(Deep0, next), sizeof(((Deep0*)0)->next), 0, 0, &s_egspInfoDeep1, "next" },
+};
+
+static const EgspStructInfo s_egspInfoDeep0 = { sizeof(Deep0), s_egspFieldsDeep0, 2, 0, s_egspSchemaDeep0, 32, "Deep0", 9 };
+
+static EgspResult _EgspPrintDeep0(EgspLoader* pLoader, Deep0* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"value\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"next\":", 7));
+	EGSP_TRY(_EgspPrintDeep1(pLoader, &pVal->next));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(9, "Deep0");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintDeep0Ex(EgspLoader* pLoader, Deep0* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintDeep0(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintDeep0(EgspFunc pFlushFunc, Deep0* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintDeep0Ex(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadDeep0(EgspLoader* pLoader, Deep0* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->value));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadDeep1(pLoader, &pVal->next));
+	EGSP_STATS_END(9, "Deep0");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadDeep0Ex(EgspLoader* pLoader, Deep0* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadDeep0(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadDeep0(EgspFunc pLoadFunc, Deep0* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadDeep0Ex(&loader, pVal, pHeap, heapSize);
+}
+
+static EgspResult _EgspSaveElementDeep0(EgspLoader* pLoader, const void* pVal)
+{
+	return _EgspSaveDeep0(pLoader, (Deep0*)pVal);
+}
+
+static const uint64_t s_egspSchemaDeepSet = 0x277541836ff4df00ull;
+
+static EgspResult _EgspLoadDeepSet(EgspLoader* pLoader, DeepSet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->count));
+	if ((pVal->items = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->items)) * pVal->count)))
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspLoadDeep0(pLoader, pVal->items + i));
+		}
+	}
+	EGSP_STATS_END(10, "DeepSet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadDeepSetEx(EgspLoader* pLoader, DeepSet* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaDeepSet));
+	return _EgspLoadDeepSet(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadDeepSet(EgspFunc pLoadFunc, DeepSet* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadDeepSetEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadDeepSetSpan(const uint8_t* pData, size_t size, DeepSet* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadDeepSetEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureDeepSet(EgspLoader* pLoader, DeepSet* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->count);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->items)) * pVal->count;
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		_EgspMeasureDeep0(pLoader, pVal->items + i);
+	}
+}
+
+static inline size_t EgspMeasureDeepSetEx(EgspLoader* pLoader, DeepSet* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureDeepSet(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureDeepSet(DeepSet* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureDeepSetEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveDeepSet(EgspLoader* pLoader, DeepSet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->items)) * pVal->count;
+	if (_EgspParallel(pLoader, pVal->count))
+	{
+		EGSP_TRY(_EgspSaveArrayParallel(pLoader, pVal->items, pVal->count, sizeof(*pVal->items), _EgspSaveElementDeep0));
+	}
+	else
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspSaveDeep0(pLoader, pVal->items + i));
+		}
+	}
+	EGSP_STATS_END(10, "DeepSet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeepSetEx(EgspLoader* pLoader, DeepSet* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureDeepSetEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaDeepSet, size, heapSize));
+	EGSP_TRY(_EgspSaveDeepSet(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveDeepSet(EgspFunc pFlushFunc, DeepSet* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveDeepSetEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveDeepSetSpan(uint8_t* pData, size_t size, DeepSet* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveDeepSetEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsDeepSet[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(DeepSet, count), sizeof(((DeepSet*)0)->count), 0, 0, 0, "count" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_ARRAY, offsetof(DeepSet, items), sizeof(*((DeepSet*)0)->items), offsetof(DeepSet, count), sizeof(((DeepSet*)0)->count), &s_egspInfoDeep0, "items" },
+};
+
+static const EgspStructInfo s_egspInfoDeepSet = { sizeof(DeepSet), s_egspFieldsDeepSet, 2, 0, s_egspSchemaDeepSet, 0, "DeepSet", 10 };
+
+static EgspResult _EgspPrintDeepSet(EgspLoader* pLoader, DeepSet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"count\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->items)) * pVal->count;
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"items\":", 8));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		EGSP_TRY(_EgspPrintDeep0(pLoader, pVal->items + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"))
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(10, "DeepSet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintDeepSetEx(EgspLoader* pLoader, DeepSet* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintDeepSet(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintDeepSet(EgspFunc pFlushFunc, DeepSet* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintDeepSetEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadDeepSet(EgspLoader* pLoader, DeepSet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->count));
+	if ((pVal->items = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->items)) * pVal->count)))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspReadDeep0(pLoader, pVal->items + i));
+		}
+	}
+	EGSP_STATS_END(10, "DeepSet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadDeepSetEx(EgspLoader* pLoader, DeepSet* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadDeepSet(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadDeepSet(EgspFunc pLoadFunc, DeepSet* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadDeepSetEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaPoint = 0xf02d54a9fe6084ceull;
+
+static inline void _EgspGetPoint(const uint8_t* pRun, Point* pVal)
+{
+	_EgspGetfloat(pRun + 0, &pVal->x);
+	_EgspGetfloat(pRun + 4, &pVal->y);
+	_EgspGetfloat(pRun + 8, &pVal->z);
+	_EgspGetuint32_t(pRun + 12, &pVal->id);
+}
+
+static inline void _EgspPutPoint(uint8_t* pRun, const Point* pVal)
+{
+	_EgspPutfloat(pRun + 0, &pVal->x);
+	_EgspPutfloat(pRun + 4, &pVal->y);
+	_EgspPutfloat(pRun + 8, &pVal->z);
+	_EgspPutuint32_t(pRun + 12, &pVal->id);
+}
+
+static EgspResult _EgspLoadPoint(EgspLoader* pLoader, Point* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 16);
+		if (pRun)
+		{
+			_EgspGetfloat(pRun + 0, &pVal->x);
+			_EgspGetfloat(pRun + 4, &pVal->y);
+			_EgspGetfloat(pRun + 8, &pVal->z);
+			_EgspGetuint32_t(pRun + 12, &pVal->id);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoadfloat(pLoader, &pVal->x));
+			EGSP_TRY(_EgspLoadfloat(pLoader, &pVal->y));
+			EGSP_TRY(_EgspLoadfloat(pLoader, &pVal->z));
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->id));
+		}
+	}
+	EGSP_STATS_END(11, "Point");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadPointEx(EgspLoader* pLoader, Point* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaPoint));
+	return _EgspLoadPoint(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadPoint(EgspFunc pLoadFunc, Point* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadPointEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadPointSpan(const uint8_t* pData, size_t size, Point* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadPointEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasurePoint(EgspLoader* pLoader, Point* pVal)
+{
+	_EgspMeasurefloat(pLoader, &pVal->x);
+	_EgspMeasurefloat(pLoader, &pVal->y);
+	_EgspMeasurefloat(pLoader, &pVal->z);
+	_EgspMeasureuint32_t(pLoader, &pVal->id);
+}
+
+static inline size_t EgspMeasurePointEx(EgspLoader* pLoader, Point* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasurePoint(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasurePoint(Point* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasurePointEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSavePoint(EgspLoader* pLoader, Point* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 16);
+		if (pRun)
+		{
+			_EgspPutfloat(pRun + 0, &pVal->x);
+			_EgspPutfloat(pRun + 4, &pVal->y);
+			_EgspPutfloat(pRun + 8, &pVal->z);
+			_EgspPutuint32_t(pRun + 12, &pVal->id);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSavefloat(pLoader, &pVal->x));
+			EGSP_TRY(_EgspSavefloat(pLoader, &pVal->y));
+			EGSP_TRY(_EgspSavefloat(pLoader, &pVal->z));
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->id));
+		}
+	}
+	EGSP_STATS_END(11, "Point");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSavePointEx(EgspLoader* pLoader, Point* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasurePointEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaPoint, size, heapSize));
+	EGSP_TRY(_EgspSavePoint(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSavePoint(EgspFunc pFlushFunc, Point* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSavePointEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSavePointSpan(uint8_t* pData, size_t size, Point* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSavePointEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsPoint[] = {
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Point, x), sizeof(((Point*)0)->x), 0, 0, 0, "x" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Point, y), sizeof(((Point*)0)->y), 0, 0, 0, "y" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Point, z), sizeof(((Point*)0)->z), 0, 0, 0, "z" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Point, id), sizeof(((Point*)0)->id), 0, 0, 0, "id" },
+};
+
+static const EgspStructInfo s_egspInfoPoint = { sizeof(Point), s_egspFieldsPoint, 4, 0, s_egspSchemaPoint, 16, "Point", 11 };
+
+static EgspResult _EgspPrintPoint(EgspLoader* pLoader, Point* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"x\":", 4));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->x));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"y\":", 4));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->y));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"z\":", 4));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->z));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"id\":", 5));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->id));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(11, "Point");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintPointEx(EgspLoader* pLoader, Point* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintPoint(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintPoint(EgspFunc pFlushFunc, Point* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintPointEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadPoint(EgspLoader* pLoader, Point* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->x));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->y));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->z));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->id));
+	EGSP_STATS_END(11, "Point");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadPointEx(EgspLoader* pLoader, Point* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadPoint(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadPoint(EgspFunc pLoadFunc, Point* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadPointEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaPixel = 0xa03a3231a7b56428ull;
+
+EGSP_STATIC_ASSERT(offsetof(Pixel, x) == 0, Pixel_x);
+EGSP_STATIC_ASSERT(offsetof(Pixel, y) == 4, Pixel_y);
+EGSP_STATIC_ASSERT(offsetof(Pixel, z) == 8, Pixel_z);
+EGSP_STATIC_ASSERT(offsetof(Pixel, color) == 12, Pixel_color);
+EGSP_STATIC_ASSERT(sizeof(Pixel) == 16, Pixel_size);
+static const uint8_t s_egspLayoutPixel[] = { 4, 4, 4, 4, 0 };
+
+static inline void _EgspGetPixel(const uint8_t* pRun, Pixel* pVal)
+{
+	memcpy(pVal, pRun, sizeof(Pixel));
+	_EgspFixRaw(pVal, 1, s_egspLayoutPixel);
+}
+
+static inline void _EgspPutPixel(uint8_t* pRun, const Pixel* pVal)
+{
+	memcpy(pRun, pVal, sizeof(Pixel));
+	_EgspFixRaw(pRun, 1, s_egspLayoutPixel);
+}
+
+static EgspResult _EgspLoadPixel(EgspLoader* pLoader, Pixel* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoadRaw(pLoader, pVal, 1, sizeof(Pixel), s_egspLayoutPixel));
+	EGSP_STATS_END(12, "Pixel");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadPixelEx(EgspLoader* pLoader, Pixel* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaPixel));
+	return _EgspLoadPixel(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadPixel(EgspFunc pLoadFunc, Pixel* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadPixelEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadPixelSpan(const uint8_t* pData, size_t size, Pixel* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadPixelEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasurePixel(EgspLoader* pLoader, Pixel* pVal)
+{
+	(void)pVal;
+	_EgspMeasureBytes(pLoader, sizeof(Pixel));
+}
+
+static inline size_t EgspMeasurePixelEx(EgspLoader* pLoader, Pixel* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasurePixel(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasurePixel(Pixel* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasurePixelEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSavePixel(EgspLoader* pLoader, Pixel* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveRaw(pLoader, pVal, 1, sizeof(Pixel), s_egspLayoutPixel));
+	EGSP_STATS_END(12, "Pixel");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSavePixelEx(EgspLoader* pLoader, Pixel* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasurePixelEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaPixel, size, heapSize));
+	EGSP_TRY(_EgspSavePixel(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSavePixel(EgspFunc pFlushFunc, Pixel* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSavePixelEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSavePixelSpan(uint8_t* pData, size_t size, Pixel* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSavePixelEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsPixel[] = {
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Pixel, x), sizeof(((Pixel*)0)->x), 0, 0, 0, "x" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Pixel, y), sizeof(((Pixel*)0)->y), 0, 0, 0, "y" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Pixel, z), sizeof(((Pixel*)0)->z), 0, 0, 0, "z" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Pixel, color), sizeof(((Pixel*)0)->color), 0, 0, 0, "color" },
+};
+
+static const EgspStructInfo s_egspInfoPixel = { sizeof(Pixel), s_egspFieldsPixel, 0, s_egspLayoutPixel, s_egspSchemaPixel, 16, "Pixel", 12 };
+
+static EgspResult _EgspPrintPixel(EgspLoader* pLoader, Pixel* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"x\":", 4));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->x));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"y\":", 4));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->y));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"z\":", 4));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->z));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"color\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->color));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(12, "Pixel");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintPixelEx(EgspLoader* pLoader, Pixel* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintPixel(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintPixel(EgspFunc pFlushFunc, Pixel* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintPixelEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadPixel(EgspLoader* pLoader, Pixel* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->x));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->y));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->z));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->color));
+	EGSP_STATS_END(12, "Pixel");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadPixelEx(EgspLoader* pLoader, Pixel* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadPixel(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadPixel(EgspFunc pLoadFunc, Pixel* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadPixelEx(&loader, pVal, pHeap, heapSize);
+}
+
+static EgspResult _EgspSaveElementPoint(EgspLoader* pLoader, const void* pVal)
+{
+	return _EgspSavePoint(pLoader, (Point*)pVal);
+}
+
+static const uint64_t s_egspSchemaArraySet = 0x0c93a1651c6e5618ull;
+
+static EgspResult _EgspLoadArraySet(EgspLoader* pLoader, ArraySet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->count));
+	if ((pVal->points = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->points)) * pVal->count)))
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspLoadPoint(pLoader, pVal->points + i));
+		}
+	}
+	if ((pVal->pixels = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->pixels)) * pVal->count)))
+	{
+		EGSP_TRY(_EgspLoadRaw(pLoader, pVal->pixels, pVal->count, sizeof(*pVal->pixels), s_egspLayoutPixel));
+	}
+	if ((pVal->values = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->values) * pVal->count))))
+	{
+		EGSP_TRY(_EgspLoadArray(pLoader, (void*)pVal->values, pVal->count, sizeof(*pVal->values), EGSP_KIND_UNSIGNED));
+	}
+	EGSP_STATS_END(13, "ArraySet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadArraySetEx(EgspLoader* pLoader, ArraySet* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaArraySet));
+	return _EgspLoadArraySet(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadArraySet(EgspFunc pLoadFunc, ArraySet* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadArraySetEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadArraySetSpan(const uint8_t* pData, size_t size, ArraySet* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadArraySetEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureArraySet(EgspLoader* pLoader, ArraySet* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->count);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->points)) * pVal->count;
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		_EgspMeasurePoint(pLoader, pVal->points + i);
+	}
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->pixels)) * pVal->count;
+	_EgspMeasureBytes(pLoader, sizeof(*pVal->pixels) * pVal->count);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->values) * pVal->count);
+	_EgspMeasureArray(pLoader, pVal->values, pVal->count, sizeof(*pVal->values), EGSP_KIND_UNSIGNED);
+}
+
+static inline size_t EgspMeasureArraySetEx(EgspLoader* pLoader, ArraySet* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureArraySet(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureArraySet(ArraySet* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureArraySetEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveArraySet(EgspLoader* pLoader, ArraySet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->points)) * pVal->count;
+	if (_EgspParallel(pLoader, pVal->count))
+	{
+		EGSP_TRY(_EgspSaveArrayParallel(pLoader, pVal->points, pVal->count, sizeof(*pVal->points), _EgspSaveElementPoint));
+	}
+	else
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspSavePoint(pLoader, pVal->points + i));
+		}
+	}
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->pixels)) * pVal->count;
+	EGSP_TRY(_EgspSaveRaw(pLoader, pVal->pixels, pVal->count, sizeof(*pVal->pixels), s_egspLayoutPixel));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->values) * pVal->count);
+	EGSP_TRY(_EgspSaveArray(pLoader, pVal->values, pVal->count, sizeof(*pVal->values), EGSP_KIND_UNSIGNED));
+	EGSP_STATS_END(13, "ArraySet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveArraySetEx(EgspLoader* pLoader, ArraySet* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureArraySetEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaArraySet, size, heapSize));
+	EGSP_TRY(_EgspSaveArraySet(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveArraySet(EgspFunc pFlushFunc, ArraySet* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveArraySetEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveArraySetSpan(uint8_t* pData, size_t size, ArraySet* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveArraySetEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsArraySet[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(ArraySet, count), sizeof(((ArraySet*)0)->count), 0, 0, 0, "count" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_ARRAY, offsetof(ArraySet, points), sizeof(*((ArraySet*)0)->points), offsetof(ArraySet, count), sizeof(((ArraySet*)0)->count), &s_egspInfoPoint, "points" },
+	{ EGSP_KIND_RAW, EGSP_SHAPE_ARRAY, offsetof(ArraySet, pixels), sizeof(*((ArraySet*)0)->pixels), offsetof(ArraySet, count), sizeof(((ArraySet*)0)->count), &s_egspInfoPixel, "pixels" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_ARRAY, offsetof(ArraySet, values), sizeof(*((ArraySet*)0)->values), offsetof(ArraySet, count), sizeof(((ArraySet*)0)->count), 0, "values" },
+};
+
+static const EgspStructInfo s_egspInfoArraySet = { sizeof(ArraySet), s_egspFieldsArraySet, 4, 0, s_egspSchemaArraySet, 0, "ArraySet", 13 };
+
+static EgspResult _EgspPrintArraySet(EgspLoader* pLoader, ArraySet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"count\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->points)) * pVal->count;
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"points\":", 9));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		EGSP_TRY(_EgspPrintPoint(pLoader, pVal->points + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"))
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->pixels)) * pVal->count;
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"pixels\":", 9));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		EGSP_TRY(_EgspPrintPixel(pLoader, pVal->pixels + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"))
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->values) * pVal->count);
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"values\":", 9));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		EGSP_TRY(_EgspPrintuint32_t(pLoader, (uint32_t*)pVal->values + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(13, "ArraySet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintArraySetEx(EgspLoader* pLoader, ArraySet* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintArraySet(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintArraySet(EgspFunc pFlushFunc, ArraySet* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintArraySetEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadArraySet(EgspLoader* pLoader, ArraySet* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->count));
+	if ((pVal->points = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->points)) * pVal->count)))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspReadPoint(pLoader, pVal->points + i));
+		}
+	}
+	if ((pVal->pixels = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->pixels)) * pVal->count)))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspReadPixel(pLoader, pVal->pixels + i));
+		}
+	}
+	if ((pVal->values = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->values) * pVal->count))))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspSkipList(pLoader));
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspReaduint32_t(pLoader, (uint32_t*)pVal->values + i));
+		}
+	}
+	EGSP_STATS_END(13, "ArraySet");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadArraySetEx(EgspLoader* pLoader, ArraySet* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadArraySet(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadArraySet(EgspFunc pLoadFunc, ArraySet* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadArraySetEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaWord = 0x8e8c29aae71bc739ull;
+
+static EgspResult _EgspLoadWord(EgspLoader* pLoader, Word* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoadstring(pLoader, &pVal->text));
+	EGSP_STATS_END(14, "Word");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadWordEx(EgspLoader* pLoader, Word* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaWord));
+	return _EgspLoadWord(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadWord(EgspFunc pLoadFunc, Word* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadWordEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadWordSpan(const uint8_t* pData, size_t size, Word* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadWordEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureWord(EgspLoader* pLoader, Word* pVal)
+{
+	_EgspMeasurestring(pLoader, &pVal->text);
+}
+
+static inline size_t EgspMeasureWordEx(EgspLoader* pLoader, Word* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureWord(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureWord(Word* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureWordEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveWord(EgspLoader* pLoader, Word* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSavestring(pLoader, &pVal->text));
+	EGSP_STATS_END(14, "Word");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveWordEx(EgspLoader* pLoader, Word* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureWordEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaWord, size, heapSize));
+	EGSP_TRY(_EgspSaveWord(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveWord(EgspFunc pFlushFunc, Word* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveWordEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveWordSpan(uint8_t* pData, size_t size, Word* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveWordEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsWord[] = {
+	{ EGSP_KIND_STRING, EGSP_SHAPE_VALUE, offsetof(Word, text), sizeof(((Word*)0)->text), 0, 0, 0, "text" },
+};
+
+static const EgspStructInfo s_egspInfoWord = { sizeof(Word), s_egspFieldsWord, 1, 0, s_egspSchemaWord, 0, "Word", 14 };
+
+static EgspResult _EgspPrintWord(EgspLoader* pLoader, Word* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"text\":", 7));
+	EGSP_TRY(_EgspPrintstring(pLoader, &pVal->text));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(14, "Word");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintWordEx(EgspLoader* pLoader, Word* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintWord(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintWord(EgspFunc pFlushFunc, Word* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintWordEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadWord(EgspLoader* pLoader, Word* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadstring(pLoader, &pVal->text));
+	EGSP_STATS_END(14, "Word");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadWordEx(EgspLoader* pLoader, Word* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadWord(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadWord(EgspFunc pLoadFunc, Word* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadWordEx(&loader, pVal, pHeap, heapSize);
+}
+
+static EgspResult _EgspSaveElementWord(EgspLoader* pLoader, const void* pVal)
+{
+	return _EgspSaveWord(pLoader, (Word*)pVal);
+}
+
+static const uint64_t s_egspSchemaShortStrings = 0x452d6a194d84dad6ull;
+
+static EgspResult _EgspLoadShortStrings(EgspLoader* pLoader, ShortStrings* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->count));
+	if ((pVal->words = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->words)) * pVal->count)))
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspLoadWord(pLoader, pVal->words + i));
+		}
+	}
+	EGSP_STATS_END(15, "ShortStrings");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadShortStringsEx(EgspLoader* pLoader, ShortStrings* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaShortStrings));
+	return _EgspLoadShortStrings(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadShortStrings(EgspFunc pLoadFunc, ShortStrings* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadShortStringsEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadShortStringsSpan(const uint8_t* pData, size_t size, ShortStrings* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadShortStringsEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureShortStrings(EgspLoader* pLoader, ShortStrings* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->count);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->words)) * pVal->count;
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		_EgspMeasureWord(pLoader, pVal->words + i);
+	}
+}
+
+static inline size_t EgspMeasureShortStringsEx(EgspLoader* pLoader, ShortStrings* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureShortStrings(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureShortStrings(ShortStrings* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureShortStringsEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveShortStrings(EgspLoader* pLoader, ShortStrings* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->words)) * pVal->count;
+	if (_EgspParallel(pLoader, pVal->count))
+	{
+		EGSP_TRY(_EgspSaveArrayParallel(pLoader, pVal->words, pVal->count, sizeof(*pVal->words), _EgspSaveElementWord));
+	}
+	else
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspSaveWord(pLoader, pVal->words + i));
+		}
+	}
+	EGSP_STATS_END(15, "ShortStrings");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveShortStringsEx(EgspLoader* pLoader, ShortStrings* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureShortStringsEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaShortStrings, size, heapSize));
+	EGSP_TRY(_EgspSaveShortStrings(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveShortStrings(EgspFunc pFlushFunc, ShortStrings* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveShortStringsEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveShortStringsSpan(uint8_t* pData, size_t size, ShortStrings* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveShortStringsEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsShortStrings[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(ShortStrings, count), sizeof(((ShortStrings*)0)->count), 0, 0, 0, "count" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_ARRAY, offsetof(ShortStrings, words), sizeof(*((ShortStrings*)0)->words), offsetof(ShortStrings, count), sizeof(((ShortStrings*)0)->count), &s_egspInfoWord, "words" },
+};
+
+static const EgspStructInfo s_egspInfoShortStrings = { sizeof(ShortStrings), s_egspFieldsShortStrings, 2, 0, s_egspSchemaShortStrings, 0, "ShortStrings", 15 };
+
+static EgspResult _EgspPrintShortStrings(EgspLoader* pLoader, ShortStrings* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"count\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->words)) * pVal->count;
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"words\":", 8));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		EGSP_TRY(_EgspPrintWord(pLoader, pVal->words + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"))
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(15, "ShortStrings");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintShortStringsEx(EgspLoader* pLoader, ShortStrings* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintShortStrings(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintShortStrings(EgspFunc pFlushFunc, ShortStrings* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintShortStringsEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadShortStrings(EgspLoader* pLoader, ShortStrings* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->count));
+	if ((pVal->words = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->words)) * pVal->count)))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspReadWord(pLoader, pVal->words + i));
+		}
+	}
+	EGSP_STATS_END(15, "ShortStrings");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadShortStringsEx(EgspLoader* pLoader, ShortStrings* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadShortStrings(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadShortStrings(EgspFunc pLoadFunc, ShortStrings* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadShortStringsEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaLongStrings = 0x452d6a194d84dad6ull;
+
+static EgspResult _EgspLoadLongStrings(EgspLoader* pLoader, LongStrings* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->count));
+	if ((pVal->pages = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->pages)) * pVal->count)))
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspLoadWord(pLoader, pVal->pages + i));
+		}
+	}
+	EGSP_STATS_END(16, "LongStrings");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadLongStringsEx(EgspLoader* pLoader, LongStrings* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaLongStrings));
+	return _EgspLoadLongStrings(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadLongStrings(EgspFunc pLoadFunc, LongStrings* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadLongStringsEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadLongStringsSpan(const uint8_t* pData, size_t size, LongStrings* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadLongStringsEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureLongStrings(EgspLoader* pLoader, LongStrings* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->count);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->pages)) * pVal->count;
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		_EgspMeasureWord(pLoader, pVal->pages + i);
+	}
+}
+
+static inline size_t EgspMeasureLongStringsEx(EgspLoader* pLoader, LongStrings* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureLongStrings(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureLongStrings(LongStrings* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureLongStringsEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveLongStrings(EgspLoader* pLoader, LongStrings* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->pages)) * pVal->count;
+	if (_EgspParallel(pLoader, pVal->count))
+	{
+		EGSP_TRY(_EgspSaveArrayParallel(pLoader, pVal->pages, pVal->count, sizeof(*pVal->pages), _EgspSaveElementWord));
+	}
+	else
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspSaveWord(pLoader, pVal->pages + i));
+		}
+	}
+	EGSP_STATS_END(16, "LongStrings");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveLongStringsEx(EgspLoader* pLoader, LongStrings* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureLongStringsEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaLongStrings, size, heapSize));
+	EGSP_TRY(_EgspSaveLongStrings(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveLongStrings(EgspFunc pFlushFunc, LongStrings* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveLongStringsEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveLongStringsSpan(uint8_t* pData, size_t size, LongStrings* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveLongStringsEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsLongStrings[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(LongStrings, count), sizeof(((LongStrings*)0)->count), 0, 0, 0, "count" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_ARRAY, offsetof(LongStrings, pages), sizeof(*((LongStrings*)0)->pages), offsetof(LongStrings, count), sizeof(((LongStrings*)0)->count), &s_egspInfoWord, "pages" },
+};
+
+static const EgspStructInfo s_egspInfoLongStrings = { sizeof(LongStrings), s_egspFieldsLongStrings, 2, 0, s_egspSchemaLongStrings, 0, "LongStrings", 16 };
+
+static EgspResult _EgspPrintLongStrings(EgspLoader* pLoader, LongStrings* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"count\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->pages)) * pVal->count;
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"pages\":", 8));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		EGSP_TRY(_EgspPrintWord(pLoader, pVal->pages + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"))
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(16, "LongStrings");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintLongStringsEx(EgspLoader* pLoader, LongStrings* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintLongStrings(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintLongStrings(EgspFunc pFlushFunc, LongStrings* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintLongStringsEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadLongStrings(EgspLoader* pLoader, LongStrings* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->count));
+	if ((pVal->pages = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->pages)) * pVal->count)))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspReadWord(pLoader, pVal->pages + i));
+		}
+	}
+	EGSP_STATS_END(16, "LongStrings");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadLongStringsEx(EgspLoader* pLoader, LongStrings* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadLongStrings(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadLongStrings(EgspFunc pLoadFunc, LongStrings* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadLongStringsEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaLeaf = 0xa86637725dded461ull;
+
+static inline void _EgspGetLeaf(const uint8_t* pRun, Leaf* pVal)
+{
+	_EgspGetuint64_t(pRun + 0, &pVal->key);
+	_EgspGetfloat(pRun + 8, &pVal->weight);
+}
+
+static inline void _EgspPutLeaf(uint8_t* pRun, const Leaf* pVal)
+{
+	_EgspPutuint64_t(pRun + 0, &pVal->key);
+	_EgspPutfloat(pRun + 8, &pVal->weight);
+}
+
+static EgspResult _EgspLoadLeaf(EgspLoader* pLoader, Leaf* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 12);
+		if (pRun)
+		{
+			_EgspGetuint64_t(pRun + 0, &pVal->key);
+			_EgspGetfloat(pRun + 8, &pVal->weight);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoaduint64_t(pLoader, &pVal->key));
+			EGSP_TRY(_EgspLoadfloat(pLoader, &pVal->weight));
+		}
+	}
+	EGSP_STATS_END(17, "Leaf");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadLeafEx(EgspLoader* pLoader, Leaf* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaLeaf));
+	return _EgspLoadLeaf(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadLeaf(EgspFunc pLoadFunc, Leaf* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadLeafEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadLeafSpan(const uint8_t* pData, size_t size, Leaf* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadLeafEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureLeaf(EgspLoader* pLoader, Leaf* pVal)
+{
+	_EgspMeasureuint64_t(pLoader, &pVal->key);
+	_EgspMeasurefloat(pLoader, &pVal->weight);
+}
+
+static inline size_t EgspMeasureLeafEx(EgspLoader* pLoader, Leaf* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureLeaf(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureLeaf(Leaf* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureLeafEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveLeaf(EgspLoader* pLoader, Leaf* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 12);
+		if (pRun)
+		{
+			_EgspPutuint64_t(pRun + 0, &pVal->key);
+			_EgspPutfloat(pRun + 8, &pVal->weight);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveuint64_t(pLoader, &pVal->key));
+			EGSP_TRY(_EgspSavefloat(pLoader, &pVal->weight));
+		}
+	}
+	EGSP_STATS_END(17, "Leaf");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveLeafEx(EgspLoader* pLoader, Leaf* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureLeafEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaLeaf, size, heapSize));
+	EGSP_TRY(_EgspSaveLeaf(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveLeaf(EgspFunc pFlushFunc, Leaf* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveLeafEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveLeafSpan(uint8_t* pData, size_t size, Leaf* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveLeafEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsLeaf[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Leaf, key), sizeof(((Leaf*)0)->key), 0, 0, 0, "key" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Leaf, weight), sizeof(((Leaf*)0)->weight), 0, 0, 0, "weight" },
+};
+
+static const EgspStructInfo s_egspInfoLeaf = { sizeof(Leaf), s_egspFieldsLeaf, 2, 0, s_egspSchemaLeaf, 12, "Leaf", 17 };
+
+static EgspResult _EgspPrintLeaf(EgspLoader* pLoader, Leaf* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"key\":", 6));
+	EGSP_TRY(_EgspPrintuint64_t(pLoader, &pVal->key));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"weight\":", 9));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->weight));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(17, "Leaf");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintLeafEx(EgspLoader* pLoader, Leaf* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintLeaf(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintLeaf(EgspFunc pFlushFunc, Leaf* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintLeafEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadLeaf(EgspLoader* pLoader, Leaf* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint64_t(pLoader, &pVal->key));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->weight));
+	EGSP_STATS_END(17, "Leaf");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadLeafEx(EgspLoader* pLoader, Leaf* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadLeaf(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadLeaf(EgspFunc pLoadFunc, Leaf* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadLeafEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaGraphNode = 0x74374440b11ba4d4ull;
+
+static EgspResult _EgspLoadGraphNode(EgspLoader* pLoader, GraphNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->id));
+	uint8_t egspNullCheck = 0;
+	EGSP_TRY(_EgspLoaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->a = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(Leaf))))
+		EGSP_TRY(_EgspLoadLeaf(pLoader, pVal->a));
+	}
+	else
+	{
+		pVal->a = 0;
+	}
+	EGSP_TRY(_EgspLoaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->b = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(Leaf))))
+		EGSP_TRY(_EgspLoadLeaf(pLoader, pVal->b));
+	}
+	else
+	{
+		pVal->b = 0;
+	}
+	EGSP_TRY(_EgspLoaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->c = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(Leaf))))
+		EGSP_TRY(_EgspLoadLeaf(pLoader, pVal->c));
+	}
+	else
+	{
+		pVal->c = 0;
+	}
+	EGSP_TRY(_EgspLoaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->d = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(Leaf))))
+		EGSP_TRY(_EgspLoadLeaf(pLoader, pVal->d));
+	}
+	else
+	{
+		pVal->d = 0;
+	}
+	EGSP_STATS_END(18, "GraphNode");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadGraphNodeEx(EgspLoader* pLoader, GraphNode* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaGraphNode));
+	return _EgspLoadGraphNode(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadGraphNode(EgspFunc pLoadFunc, GraphNode* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadGraphNodeEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadGraphNodeSpan(const uint8_t* pData, size_t size, GraphNode* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadGraphNodeEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureGraphNode(EgspLoader* pLoader, GraphNode* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->id);
+	_EgspMeasureBytes(pLoader, sizeof(uint8_t));
+	if (pVal->a)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->a));
+		_EgspMeasureLeaf(pLoader, pVal->a);
+	}
+	_EgspMeasureBytes(pLoader, sizeof(uint8_t));
+	if (pVal->b)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->b));
+		_EgspMeasureLeaf(pLoader, pVal->b);
+	}
+	_EgspMeasureBytes(pLoader, sizeof(uint8_t));
+	if (pVal->c)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->c));
+		_EgspMeasureLeaf(pLoader, pVal->c);
+	}
+	_EgspMeasureBytes(pLoader, sizeof(uint8_t));
+	if (pVal->d)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->d));
+		_EgspMeasureLeaf(pLoader, pVal->d);
+	}
+}
+
+static inline size_t EgspMeasureGraphNodeEx(EgspLoader* pLoader, GraphNode* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureGraphNode(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureGraphNode(GraphNode* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureGraphNodeEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveGraphNode(EgspLoader* pLoader, GraphNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->id));
+	if (pVal->a)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->a));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspSaveLeaf(pLoader, pVal->a));
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+	}
+	if (pVal->b)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->b));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspSaveLeaf(pLoader, pVal->b));
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+	}
+	if (pVal->c)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->c));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspSaveLeaf(pLoader, pVal->c));
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+	}
+	if (pVal->d)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->d));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspSaveLeaf(pLoader, pVal->d));
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+	}
+	EGSP_STATS_END(18, "GraphNode");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveGraphNodeEx(EgspLoader* pLoader, GraphNode* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureGraphNodeEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaGraphNode, size, heapSize));
+	EGSP_TRY(_EgspSaveGraphNode(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveGraphNode(EgspFunc pFlushFunc, GraphNode* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveGraphNodeEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveGraphNodeSpan(uint8_t* pData, size_t size, GraphNode* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveGraphNodeEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsGraphNode[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(GraphNode, id), sizeof(((GraphNode*)0)->id), 0, 0, 0, "id" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_POINTER, offsetof(GraphNode, a), sizeof(*((GraphNode*)0)->a), 0, 0, &s_egspInfoLeaf, "a" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_POINTER, offsetof(GraphNode, b), sizeof(*((GraphNode*)0)->b), 0, 0, &s_egspInfoLeaf, "b" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_POINTER, offsetof(GraphNode, c), sizeof(*((GraphNode*)0)->c), 0, 0, &s_egspInfoLeaf, "c" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_POINTER, offsetof(GraphNode, d), sizeof(*((GraphNode*)0)->d), 0, 0, &s_egspInfoLeaf, "d" },
+};
+
+static const EgspStructInfo s_egspInfoGraphNode = { sizeof(GraphNode), s_egspFieldsGraphNode, 5, 0, s_egspSchemaGraphNode, 0, "GraphNode", 18 };
+
+static EgspResult _EgspPrintGraphNode(EgspLoader* pLoader, GraphNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"id\":", 5));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->id));
+	if (pVal->a)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->a));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"a is not null. Processing\":", 28));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"a\":", 4));
+		EGSP_TRY(_EgspPrintLeaf(pLoader, pVal->a))
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"a is null. Skipping.\":", 23));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+	}
+	if (pVal->b)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->b));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"b is not null. Processing\":", 28));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"b\":", 4));
+		EGSP_TRY(_EgspPrintLeaf(pLoader, pVal->b))
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"b is null. Skipping.\":", 23));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+	}
+	if (pVal->c)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->c));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"c is not null. Processing\":", 28));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"c\":", 4));
+		EGSP_TRY(_EgspPrintLeaf(pLoader, pVal->c))
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"c is null. Skipping.\":", 23));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+	}
+	if (pVal->d)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->d));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"d is not null. Processing\":", 28));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"d\":", 4));
+		EGSP_TRY(_EgspPrintLeaf(pLoader, pVal->d))
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"d is null. Skipping.\":", 23));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(18, "GraphNode");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintGraphNodeEx(EgspLoader* pLoader, GraphNode* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintGraphNode(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintGraphNode(EgspFunc pFlushFunc, GraphNode* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintGraphNodeEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadGraphNode(EgspLoader* pLoader, GraphNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->id));
+	uint8_t egspNullCheck = 0;
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->a = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(Leaf))))
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspReadLeaf(pLoader, pVal->a));
+	}
+	else
+	{
+		pVal->a = 0;
+	}
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->b = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(Leaf))))
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspReadLeaf(pLoader, pVal->b));
+	}
+	else
+	{
+		pVal->b = 0;
+	}
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->c = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(Leaf))))
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspReadLeaf(pLoader, pVal->c));
+	}
+	else
+	{
+		pVal->c = 0;
+	}
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->d = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(Leaf))))
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspReadLeaf(pLoader, pVal->d));
+	}
+	else
+	{
+		pVal->d = 0;
+	}
+	EGSP_STATS_END(18, "GraphNode");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadGraphNodeEx(EgspLoader* pLoader, GraphNode* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadGraphNode(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadGraphNode(EgspFunc pLoadFunc, GraphNode* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadGraphNodeEx(&loader, pVal, pHeap, heapSize);
+}
+
+static EgspResult _EgspSaveElementGraphNode(EgspLoader* pLoader, const void* pVal)
+{
+	return _EgspSaveGraphNode(pLoader, (GraphNode*)pVal);
+}
+
+static const uint64_t s_egspSchemaGraph = 0xacce7ffa2c6ef8c8ull;
+
+static EgspResult _EgspLoadGraph(EgspLoader* pLoader, Graph* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->count));
+	if ((pVal->nodes = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->nodes)) * pVal->count)))
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspLoadGraphNode(pLoader, pVal->nodes + i));
+		}
+	}
+	EGSP_STATS_END(19, "Graph");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadGraphEx(EgspLoader* pLoader, Graph* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaGraph));
+	return _EgspLoadGraph(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadGraph(EgspFunc pLoadFunc, Graph* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadGraphEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadGraphSpan(const uint8_t* pData, size_t size, Graph* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadGraphEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureGraph(EgspLoader* pLoader, Graph* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->count);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->nodes)) * pVal->count;
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		_EgspMeasureGraphNode(pLoader, pVal->nodes + i);
+	}
+}
+
+static inline size_t EgspMeasureGraphEx(EgspLoader* pLoader, Graph* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureGraph(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureGraph(Graph* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureGraphEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveGraph(EgspLoader* pLoader, Graph* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->nodes)) * pVal->count;
+	if (_EgspParallel(pLoader, pVal->count))
+	{
+		EGSP_TRY(_EgspSaveArrayParallel(pLoader, pVal->nodes, pVal->count, sizeof(*pVal->nodes), _EgspSaveElementGraphNode));
+	}
+	else
+	{
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspSaveGraphNode(pLoader, pVal->nodes + i));
+		}
+	}
+	EGSP_STATS_END(19, "Graph");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveGraphEx(EgspLoader* pLoader, Graph* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureGraphEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaGraph, size, heapSize));
+	EGSP_TRY(_EgspSaveGraph(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveGraph(EgspFunc pFlushFunc, Graph* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveGraphEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveGraphSpan(uint8_t* pData, size_t size, Graph* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveGraphEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsGraph[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Graph, count), sizeof(((Graph*)0)->count), 0, 0, 0, "count" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_ARRAY, offsetof(Graph, nodes), sizeof(*((Graph*)0)->nodes), offsetof(Graph, count), sizeof(((Graph*)0)->count), &s_egspInfoGraphNode, "nodes" },
+};
+
+static const EgspStructInfo s_egspInfoGraph = { sizeof(Graph), s_egspFieldsGraph, 2, 0, s_egspSchemaGraph, 0, "Graph", 19 };
+
+static EgspResult _EgspPrintGraph(EgspLoader* pLoader, Graph* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"count\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->count));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->nodes)) * pVal->count;
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"nodes\":", 8));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->count; ++i)
+	{
+		EGSP_TRY(_EgspPrintGraphNode(pLoader, pVal->nodes + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"))
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(19, "Graph");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintGraphEx(EgspLoader* pLoader, Graph* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintGraph(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintGraph(EgspFunc pFlushFunc, Graph* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintGraphEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadGraph(EgspLoader* pLoader, Graph* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->count));
+	if ((pVal->nodes = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->nodes)) * pVal->count)))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		for (size_t i = 0; i < pVal->count; ++i)
+		{
+			EGSP_TRY(_EgspReadGraphNode(pLoader, pVal->nodes + i));
+		}
+	}
+	EGSP_STATS_END(19, "Graph");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadGraphEx(EgspLoader* pLoader, Graph* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadGraph(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadGraph(EgspFunc pLoadFunc, Graph* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadGraphEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaTreeNode = 0x62a0cf0a303b300aull;
+
+static EgspResult _EgspLoadTreeNode(EgspLoader* pLoader, TreeNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 8);
+		if (pRun)
+		{
+			_EgspGetuint32_t(pRun + 0, &pVal->id);
+			_EgspGetfloat(pRun + 4, &pVal->weight);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->id));
+			EGSP_TRY(_EgspLoadfloat(pLoader, &pVal->weight));
+		}
+	}
+	uint8_t egspNullCheck = 0;
+	EGSP_TRY(_EgspLoaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->left = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(TreeNode))))
+		EGSP_TRY(_EgspLoadTreeNode(pLoader, pVal->left));
+	}
+	else
+	{
+		pVal->left = 0;
+	}
+	EGSP_TRY(_EgspLoaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->right = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(TreeNode))))
+		EGSP_TRY(_EgspLoadTreeNode(pLoader, pVal->right));
+	}
+	else
+	{
+		pVal->right = 0;
+	}
+	EGSP_STATS_END(20, "TreeNode");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadTreeNodeEx(EgspLoader* pLoader, TreeNode* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaTreeNode));
+	return _EgspLoadTreeNode(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadTreeNode(EgspFunc pLoadFunc, TreeNode* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadTreeNodeEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadTreeNodeSpan(const uint8_t* pData, size_t size, TreeNode* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadTreeNodeEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureTreeNode(EgspLoader* pLoader, TreeNode* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->id);
+	_EgspMeasurefloat(pLoader, &pVal->weight);
+	_EgspMeasureBytes(pLoader, sizeof(uint8_t));
+	if (pVal->left)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->left));
+		_EgspMeasureTreeNode(pLoader, pVal->left);
+	}
+	_EgspMeasureBytes(pLoader, sizeof(uint8_t));
+	if (pVal->right)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->right));
+		_EgspMeasureTreeNode(pLoader, pVal->right);
+	}
+}
+
+static inline size_t EgspMeasureTreeNodeEx(EgspLoader* pLoader, TreeNode* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureTreeNode(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureTreeNode(TreeNode* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureTreeNodeEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveTreeNode(EgspLoader* pLoader, TreeNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 8);
+		if (pRun)
+		{
+			_EgspPutuint32_t(pRun + 0, &pVal->id);
+			_EgspPutfloat(pRun + 4, &pVal->weight);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->id));
+			EGSP_TRY(_EgspSavefloat(pLoader, &pVal->weight));
+		}
+	}
+	if (pVal->left)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->left));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspSaveTreeNode(pLoader, pVal->left));
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+	}
+	if (pVal->right)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->right));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspSaveTreeNode(pLoader, pVal->right));
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+	}
+	EGSP_STATS_END(20, "TreeNode");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveTreeNodeEx(EgspLoader* pLoader, TreeNode* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureTreeNodeEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaTreeNode, size, heapSize));
+	EGSP_TRY(_EgspSaveTreeNode(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveTreeNode(EgspFunc pFlushFunc, TreeNode* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveTreeNodeEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveTreeNodeSpan(uint8_t* pData, size_t size, TreeNode* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveTreeNodeEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspStructInfo s_egspInfoTreeNode;
+
+static const EgspField s_egspFieldsTreeNode[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(TreeNode, id), sizeof(((TreeNode*)0)->id), 0, 0, 0, "id" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(TreeNode, weight), sizeof(((TreeNode*)0)->weight), 0, 0, 0, "weight" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_POINTER, offsetof(TreeNode, left), sizeof(*((TreeNode*)0)->left), 0, 0, &s_egspInfoTreeNode, "left" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_POINTER, offsetof(TreeNode, right), sizeof(*((TreeNode*)0)->right), 0, 0, &s_egspInfoTreeNode, "right" },
+};
+
+static const EgspStructInfo s_egspInfoTreeNode = { sizeof(TreeNode), s_egspFieldsTreeNode, 4, 0, s_egspSchemaTreeNode, 0, "TreeNode", 20 };
+
+static EgspResult _EgspPrintTreeNode(EgspLoader* pLoader, TreeNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"id\":", 5));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->id));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"weight\":", 9));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->weight));
+	if (pVal->left)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->left));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"left is not null. Processing\":", 31));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"left\":", 7));
+		EGSP_TRY(_EgspPrintTreeNode(pLoader, pVal->left))
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"left is null. Skipping.\":", 26));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+	}
+	if (pVal->right)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->right));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"right is not null. Processing\":", 32));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"right\":", 8));
+		EGSP_TRY(_EgspPrintTreeNode(pLoader, pVal->right))
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"right is null. Skipping.\":", 27));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(20, "TreeNode");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintTreeNodeEx(EgspLoader* pLoader, TreeNode* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintTreeNode(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintTreeNode(EgspFunc pFlushFunc, TreeNode* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintTreeNodeEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadTreeNode(EgspLoader* pLoader, TreeNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->id));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->weight));
+	uint8_t egspNullCheck = 0;
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->left = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(TreeNode))))
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspReadTreeNode(pLoader, pVal->left));
+	}
+	else
+	{
+		pVal->left = 0;
+	}
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->right = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(TreeNode))))
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspReadTreeNode(pLoader, pVal->right));
+	}
+	else
+	{
+		pVal->right = 0;
+	}
+	EGSP_STATS_END(20, "TreeNode");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadTreeNodeEx(EgspLoader* pLoader, TreeNode* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadTreeNode(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadTreeNode(EgspFunc pLoadFunc, TreeNode* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadTreeNodeEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaTree = 0x36e36d13c2d1f0e6ull;
+
+static EgspResult _EgspLoadTree(EgspLoader* pLoader, Tree* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->count));
+	uint8_t egspNullCheck = 0;
+	EGSP_TRY(_EgspLoaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->root = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(TreeNode))))
+		EGSP_TRY(_EgspLoadTreeNode(pLoader, pVal->root));
+	}
+	else
+	{
+		pVal->root = 0;
+	}
+	EGSP_STATS_END(21, "Tree");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadTreeEx(EgspLoader* pLoader, Tree* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaTree));
+	return _EgspLoadTree(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadTree(EgspFunc pLoadFunc, Tree* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadTreeEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadTreeSpan(const uint8_t* pData, size_t size, Tree* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadTreeEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureTree(EgspLoader* pLoader, Tree* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->count);
+	_EgspMeasureBytes(pLoader, sizeof(uint8_t));
+	if (pVal->root)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->root));
+		_EgspMeasureTreeNode(pLoader, pVal->root);
+	}
+}
+
+static inline size_t EgspMeasureTreeEx(EgspLoader* pLoader, Tree* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureTree(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureTree(Tree* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureTreeEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveTree(EgspLoader* pLoader, Tree* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->count));
+	if (pVal->root)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->root));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspSaveTreeNode(pLoader, pVal->root));
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+	}
+	EGSP_STATS_END(21, "Tree");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveTreeEx(EgspLoader* pLoader, Tree* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureTreeEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaTree, size, heapSize));
+	EGSP_TRY(_EgspSaveTree(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveTree(EgspFunc pFlushFunc, Tree* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveTreeEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveTreeSpan(uint8_t* pData, size_t size, Tree* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveTreeEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsTree[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Tree, count), sizeof(((Tree*)0)->count), 0, 0, 0, "count" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_POINTER, offsetof(Tree, root), sizeof(*((Tree*)0)->root), 0, 0, &s_egspInfoTreeNode, "root" },
+};
+
+static const EgspStructInfo s_egspInfoTree = { sizeof(Tree), s_egspFieldsTree, 2, 0, s_egspSchemaTree, 0, "Tree", 21 };
+
+static EgspResult _EgspPrintTree(EgspLoader* pLoader, Tree* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"count\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->count));
+	if (pVal->root)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->root));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"root is not null. Processing\":", 31));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"root\":", 7));
+		EGSP_TRY(_EgspPrintTreeNode(pLoader, pVal->root))
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"root is null. Skipping.\":", 26));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(21, "Tree");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintTreeEx(EgspLoader* pLoader, Tree* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintTree(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintTree(EgspFunc pFlushFunc, Tree* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintTreeEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadTree(EgspLoader* pLoader, Tree* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->count));
+	uint8_t egspNullCheck = 0;
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->root = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(TreeNode))))
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspReadTreeNode(pLoader, pVal->root));
+	}
+	else
+	{
+		pVal->root = 0;
+	}
+	EGSP_STATS_END(21, "Tree");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadTreeEx(EgspLoader* pLoader, Tree* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadTree(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadTree(EgspFunc pLoadFunc, Tree* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadTreeEx(&loader, pVal, pHeap, heapSize);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,289 @@
+#include "egspasync.h"
+#include <string.h>
+
+size_t EgspAsyncMemory(size_t blockSize, size_t depth)
+{
+	// Reader blocks keep a block of room in front for what the decoder has not used yet, and the
+	// last block of the ring a block of room behind it for a decoder reading past the end of the file
+	return depth * (sizeof(size_t) + 2 * blockSize) + blockSize;
+}
+
+#ifndef _WIN32
+#include <errno.h>
+#include <unistd.h>
+
+static int WriteAll(int fd, const uint8_t* pData, size_t size)
+{
+	while (size)
+	{
+		ssize_t written = write(fd, pData, size);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return 0;
+		}
+		pData += written;
+		size -= (size_t)written;
+	}
+	return 1;
+}
+
+// Reads until the block is full or the file ends. Returns -1 on error.
+static ssize_t ReadAll(int fd, uint8_t* pData, size_t size)
+{
+	size_t total = 0;
+	while (total < size)
+	{
+		ssize_t got = read(fd, pData + total, size - total);
+		if (got < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return -1;
+		}
+		if (got == 0)
+		{
+			break;
+		}
+		total += (size_t)got;
+	}
+	return (ssize_t)total;
+}
+
+static void* WriterThread(void* pArg)
+{
+	EgspAsync* pAsync = (EgspAsync*)pArg;
+	pthread_mutex_lock(&pAsync->lock);
+	while (1)
+	{
+		if (pAsync->consumed == pAsync->produced && !pAsync->done)
+		{
+			++pAsync->ioStalls;
+			while (pAsync->consumed == pAsync->produced && !pAsync->done)
+			{
+				pthread_cond_wait(&pAsync->cond, &pAsync->lock);
+			}
+		}
+		if (pAsync->consumed == pAsync->produced)
+		{
+			break;
+		}
+
+		size_t slot = pAsync->consumed % pAsync->depth;
+		pthread_mutex_unlock(&pAsync->lock);
+		int ok = WriteAll(pAsync->fd, pAsync->pRing + slot * pAsync->slotSize, pAsync->pSizes[slot]);
+		pthread_mutex_lock(&pAsync->lock);
+
+		pAsync->error |= !ok;
+		++pAsync->consumed;
+		pthread_cond_broadcast(&pAsync->cond);
+	}
+	pthread_mutex_unlock(&pAsync->lock);
+	return 0;
+}
+
+static void* ReaderThread(void* pArg)
+{
+	EgspAsync* pAsync = (EgspAsync*)pArg;
+	pthread_mutex_lock(&pAsync->lock);
+	while (!pAsync->done)
+	{
+		if (pAsync->produced - pAsync->consumed >= pAsync->depth)
+		{
+			++pAsync->ioStalls;
+			pthread_cond_wait(&pAsync->cond, &pAsync->lock);
+			continue;
+		}
+
+		size_t slot = pAsync->produced % pAsync->depth;
+		pthread_mutex_unlock(&pAsync->lock);
+		ssize_t got = ReadAll(pAsync->fd, pAsync->pRing + slot * pAsync->slotSize + pAsync->blockSize, pAsync->blockSize);
+		pthread_mutex_lock(&pAsync->lock);
+
+		if (got > 0)
+		{
+			pAsync->pSizes[slot] = (size_t)got;
+			++pAsync->produced;
+		}
+		if (got < (ssize_t)pAsync->blockSize)
+		{
+			pAsync->error |= got < 0;
+			pAsync->done = 1;
+		}
+		pthread_cond_broadcast(&pAsync->cond);
+	}
+	pthread_mutex_unlock(&pAsync->lock);
+	return 0;
+}
+
+static EgspResult Open(EgspAsync* pAsync, int fd, void* pMemory, size_t blockSize, size_t depth, int writing)
+{
+	EGSP_TEST(depth >= 2);
+	pAsync->fd = fd;
+	pAsync->writing = writing;
+	pAsync->pSizes = (size_t*)pMemory;
+	pAsync->pRing = (uint8_t*)(pAsync->pSizes + depth);
+	pAsync->blockSize = blockSize;
+	pAsync->slotSize = writing ? blockSize : 2 * blockSize;
+	pAsync->depth = depth;
+	pAsync->produced = 0;
+	pAsync->consumed = 0;
+	pAsync->done = 0;
+	pAsync->error = 0;
+	pAsync->active = 0;
+	pAsync->start = 0;
+	pAsync->length = 0;
+	pAsync->stalls = 0;
+	pAsync->ioStalls = 0;
+
+	EGSP_TEST(pthread_mutex_init(&pAsync->lock, 0) == 0);
+	if (pthread_cond_init(&pAsync->cond, 0) != 0)
+	{
+		pthread_mutex_destroy(&pAsync->lock);
+		return EGSP_FAIL;
+	}
+	if (pthread_create(&pAsync->thread, 0, writing ? WriterThread : ReaderThread, pAsync) != 0)
+	{
+		pthread_cond_destroy(&pAsync->cond);
+		pthread_mutex_destroy(&pAsync->lock);
+		return EGSP_FAIL;
+	}
+	return EGSP_SUCCESS;
+}
+
+EgspResult EgspAsyncOpenWriter(EgspAsync* pAsync, int fd, void* pMemory, size_t blockSize, size_t depth)
+{
+	return Open(pAsync, fd, pMemory, blockSize, depth, 1);
+}
+
+EgspResult EgspAsyncOpenReader(EgspAsync* pAsync, int fd, void* pMemory, size_t blockSize, size_t depth)
+{
+	return Open(pAsync, fd, pMemory, blockSize, depth, 0);
+}
+
+EgspResult EgspAsyncClose(EgspAsync* pAsync)
+{
+	pthread_mutex_lock(&pAsync->lock);
+	pAsync->done = 1;
+	pthread_cond_broadcast(&pAsync->cond);
+	pthread_mutex_unlock(&pAsync->lock);
+
+	pthread_join(pAsync->thread, 0);
+	pthread_cond_destroy(&pAsync->cond);
+	pthread_mutex_destroy(&pAsync->lock);
+	return pAsync->error ? EGSP_FAIL : EGSP_SUCCESS;
+}
+
+static uint8_t* WriterFunc(EgspAsync* pAsync, size_t size)
+{
+	uint8_t* pBlock = 0;
+	pthread_mutex_lock(&pAsync->lock);
+	if (pAsync->active && size)
+	{
+		pAsync->pSizes[pAsync->produced % pAsync->depth] = size;
+		++pAsync->produced;
+		pthread_cond_broadcast(&pAsync->cond);
+	}
+
+	if (pAsync->produced - pAsync->consumed >= pAsync->depth)
+	{
+		++pAsync->stalls;
+		while (pAsync->produced - pAsync->consumed >= pAsync->depth)
+		{
+			pthread_cond_wait(&pAsync->cond, &pAsync->lock);
+		}
+	}
+
+	if (!pAsync->error)
+	{
+		pAsync->active = 1;
+		pBlock = pAsync->pRing + (pAsync->produced % pAsync->depth) * pAsync->slotSize;
+	}
+	pthread_mutex_unlock(&pAsync->lock);
+	return pBlock;
+}
+
+static uint8_t* ReaderFunc(EgspAsync* pAsync, size_t size)
+{
+	uint8_t* pBlock = 0;
+	pthread_mutex_lock(&pAsync->lock);
+
+	// Whatever the decoder did not use moves to the front of the next block
+	size_t leftover = pAsync->active && size < pAsync->length ? pAsync->length - size : 0;
+	uint8_t* pLeftover = pAsync->pRing + (pAsync->consumed % pAsync->depth) * pAsync->slotSize + pAsync->start + size;
+	size_t next = pAsync->active ? pAsync->consumed + 1 : pAsync->consumed;
+
+	// Streamed blocks leave their last byte unused, so the leftovers grow by a byte per block.
+	// Once they make up a whole block, the decoder carries on in the current one instead.
+	if (leftover < pAsync->blockSize)
+	{
+		if (next >= pAsync->produced && !pAsync->done)
+		{
+			++pAsync->stalls;
+			while (next >= pAsync->produced && !pAsync->done)
+			{
+				pthread_cond_wait(&pAsync->cond, &pAsync->lock);
+			}
+		}
+
+		if (next < pAsync->produced)
+		{
+			size_t slot = next % pAsync->depth;
+			uint8_t* pSlot = pAsync->pRing + slot * pAsync->slotSize;
+			memcpy(pSlot + pAsync->blockSize - leftover, pLeftover, leftover);
+			if (pAsync->active)
+			{
+				++pAsync->consumed;
+				pthread_cond_broadcast(&pAsync->cond);
+			}
+			pAsync->active = 1;
+			pAsync->start = pAsync->blockSize - leftover;
+			pAsync->length = leftover + pAsync->pSizes[slot];
+			pBlock = pSlot + pAsync->start;
+		}
+	}
+
+	if (!pBlock && leftover && !pAsync->error)
+	{
+		// The file has ended or a whole block is left over, and either way the rest is in the current block
+		pAsync->start += size;
+		pAsync->length = leftover;
+		pBlock = pLeftover;
+	}
+	pthread_mutex_unlock(&pAsync->lock);
+	return pBlock;
+}
+
+uint8_t* EgspAsyncFunc(void* pUser, size_t size)
+{
+	EgspAsync* pAsync = (EgspAsync*)pUser;
+	return pAsync->writing ? WriterFunc(pAsync, size) : ReaderFunc(pAsync, size);
+}
+
+#else
+// Not supported on this platform yet
+EgspResult EgspAsyncOpenWriter(EgspAsync* pAsync, int fd, void* pMemory, size_t blockSize, size_t depth)
+{
+	return EGSP_FAIL;
+}
+
+EgspResult EgspAsyncOpenReader(EgspAsync* pAsync, int fd, void* pMemory, size_t blockSize, size_t depth)
+{
+	return EGSP_FAIL;
+}
+
+EgspResult EgspAsyncClose(EgspAsync* pAsync)
+{
+	return EGSP_FAIL;
+}
+
+uint8_t* EgspAsyncFunc(void* pUser, size_t size)
+{
+	return 0;
+}
+#endif
@@ -0,0 +1,55 @@
+#ifndef EGSPASYNC_H
+#define EGSPASYNC_H
+
+#include "egsplib.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+// A ring of blocks drained to (or filled from) a file descriptor by a background thread, so that
+// encoding and I/O overlap. Pass EgspAsyncFunc with the EgspAsync as pUser to EgspInitLoader.
+// The writer hands each filled block to the thread and carries on with the next free one. The reader
+// keeps reading ahead until every block in the ring is full.
+typedef struct
+{
+	int fd;
+	int writing;
+	uint8_t* pRing;
+	size_t* pSizes;
+	size_t blockSize;
+	size_t slotSize;
+	size_t depth;
+
+	// Blocks handed to the consumer of the ring, and blocks it has handed back
+	size_t produced;
+	size_t consumed;
+	int done;
+	int error;
+
+	// Whether a block is with the encoder or decoder, and which part of it holds data
+	int active;
+	size_t start;
+	size_t length;
+
+	// Times the encoder/decoder had to wait for I/O, and the I/O thread for the encoder/decoder
+	size_t stalls;
+	size_t ioStalls;
+
+#ifndef _WIN32
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+#endif
+} EgspAsync;
+
+// Bytes of memory to hand to EgspAsyncOpen* for a ring of depth blocks. depth must be at least 2.
+size_t EgspAsyncMemory(size_t blockSize, size_t depth);
+EgspResult EgspAsyncOpenWriter(EgspAsync* pAsync, int fd, void* pMemory, size_t blockSize, size_t depth);
+EgspResult EgspAsyncOpenReader(EgspAsync* pAsync, int fd, void* pMemory, size_t blockSize, size_t depth);
+
+// Waits for the outstanding writes. Fails if any write failed.
+EgspResult EgspAsyncClose(EgspAsync* pAsync);
+uint8_t* EgspAsyncFunc(void* pUser, size_t size);
+
+#endif
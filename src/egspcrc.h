@@ -0,0 +1,48 @@
+#ifndef EGSPCRC_H
+#define EGSPCRC_H
+
+#include "egsplib.h"
+
+// Puts a CRC32C after every block Save hands over and checks it before Load sees any of the block, passing the
+// blocks on to another block function. Pass EgspCrcFunc with the EgspCrc as pUser to EgspInitLoader, with the
+// loader's block size set to blockSize. Each block becomes a frame in the inner stream: its size, the block, then
+// the checksum of both. Frames that fit in what is left of an inner block are written and checked in place,
+// the rest go through a block of their own which is reused, so EGSP_FLAG_ZERO_COPY strings may not survive it.
+typedef struct
+{
+	EgspFuncEx pFunc;
+	void* pUser;
+	size_t innerBlockSize;
+	int writing;
+
+	// The inner block being filled or read, and how far into it
+	uint8_t* pInner;
+	size_t pos;
+
+	// Where the loader's block is, in the inner block or in pBlock
+	size_t blockSize;
+	uint8_t* pBlock;
+	int direct;
+
+	// Blocks handed over or checked so far, and the first one that failed its check or SIZE_MAX
+	size_t blocks;
+	size_t corruptBlock;
+} EgspCrc;
+
+// Bytes of memory to hand to EgspCrcOpen* for loader blocks of blockSize
+size_t EgspCrcMemory(size_t blockSize);
+
+// pFunc and pUser are the inner block function, which hands out blocks of innerBlockSize
+EgspResult EgspCrcOpenWriter(EgspCrc* pCrc, EgspFuncEx pFunc, void* pUser, size_t innerBlockSize, void* pMemory, size_t blockSize);
+EgspResult EgspCrcOpenReader(EgspCrc* pCrc, EgspFuncEx pFunc, void* pUser, size_t innerBlockSize, void* pMemory, size_t blockSize);
+
+// Hands the last inner block over when writing. Returns EGSP_CORRUPT when a loaded block failed its check,
+// the one in corruptBlock. The load itself just fails.
+EgspResult EgspCrcClose(EgspCrc* pCrc);
+uint8_t* EgspCrcFunc(void* pUser, size_t size);
+
+// CRC32C (Castagnoli) of size bytes, carrying on from crc. Start with 0.
+// Uses the SSE4.2 or ARMv8 crc32 instructions when the library is built for them.
+uint32_t EgspCrc32c(uint32_t crc, const void* pData, size_t size);
+
+#endif
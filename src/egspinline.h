@@ -0,0 +1,496 @@
+#ifndef EGSPINLINE_H
+#define EGSPINLINE_H
+
+// The number primitives the generated code calls for each field, and the block checks under them.
+// egsplib.h includes this when EGSP_INLINE is defined, so that they are static inline wherever the generated
+// header goes and the struct functions can be inlined and scheduled whole. egsplib.c includes it with
+// EGSP_PRIMITIVE empty for the copies in the egspload library, which code without EGSP_INLINE links against.
+// Everything else, from moving to the next block to strings, arrays and the Json text, stays in the library.
+
+#include "egsplib.h"
+#ifdef EGSP_JSON
+#include "egspnum.h"
+#endif
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+#ifndef EGSP_PRIMITIVE
+#define EGSP_PRIMITIVE static inline
+#endif
+
+// Whole word big-endian conversion
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define EGSP_BE16(X) (X)
+#define EGSP_BE32(X) (X)
+#define EGSP_BE64(X) (X)
+#elif defined(_MSC_VER)
+#define EGSP_BE16(X) _byteswap_ushort(X)
+#define EGSP_BE32(X) _byteswap_ulong(X)
+#define EGSP_BE64(X) _byteswap_uint64(X)
+#else
+#define EGSP_BE16(X) __builtin_bswap16(X)
+#define EGSP_BE32(X) __builtin_bswap32(X)
+#define EGSP_BE64(X) __builtin_bswap64(X)
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define EGSP_BIG_ENDIAN 1
+#else
+#define EGSP_BIG_ENDIAN 0
+#endif
+
+#ifdef EGSP_STATS
+// Returns X from a primitive, adding it and the bytes it moved the stream on by to the counters for KIND
+#define EGSP_COUNTED(KIND, COUNT, X) { uint64_t egspStart = _EgspStatsPosition(pLoader); EgspResult egspResult = X; \
+	_EgspStatsKind(pLoader, KIND, COUNT, egspStart); return egspResult; }
+#else
+#define EGSP_COUNTED(KIND, COUNT, X) return X;
+#endif // EGSP_STATS
+
+static inline int _EgspStreamed(EgspLoader* pLoader)
+{
+	return pLoader->pFunc || pLoader->pFuncEx;
+}
+
+static inline EgspResult _EgspCheckOverFlow(EgspLoader* pLoader)
+{
+	if (pLoader->offset + 1 >= pLoader->blockSize)
+	{
+		// A single span has no next block to move on to
+		if (!_EgspStreamed(pLoader))
+		{
+			return pLoader->offset < pLoader->blockSize ? EGSP_SUCCESS : EGSP_FAIL;
+		}
+		EGSP_TRY(_EgspNextBlock(pLoader, pLoader->offset));
+	}
+	return EGSP_SUCCESS;
+}
+
+// Bytes that fit in the current block without calling _EgspCheckOverFlow for each one.
+// Streamed blocks keep their last byte unused, exactly like the byte by byte path.
+static inline size_t _EgspAvailable(EgspLoader* pLoader)
+{
+	size_t end = _EgspStreamed(pLoader) ? pLoader->blockSize - 1 : pLoader->blockSize;
+	return pLoader->offset < end ? end - pLoader->offset : 0;
+}
+
+// Varints, see EGSP_FLAG_VARINT. Signed numbers are zigzagged first so that small negative ones stay short.
+static inline uint64_t _EgspZigZag(int64_t val)
+{
+	return ((uint64_t)val << 1) ^ (uint64_t)(val >> 63);
+}
+
+static inline EgspResult _EgspSaveVarint(EgspLoader* pLoader, uint64_t val)
+{
+	if (_EgspAvailable(pLoader) >= EGSP_VARINT_MAX)
+	{
+		uint8_t* pDst = pLoader->pData + pLoader->offset;
+		for (; val >= 0x80; val >>= 7)
+		{
+			*pDst++ = (uint8_t)(val | 0x80);
+		}
+		*pDst++ = (uint8_t)val;
+		pLoader->offset = pDst - pLoader->pData;
+		return EGSP_SUCCESS;
+	}
+
+	do
+	{
+		EGSP_TRY(_EgspCheckOverFlow(pLoader));
+		pLoader->pData[pLoader->offset++] = (uint8_t)(val >= 0x80 ? val | 0x80 : val);
+		val >>= 7;
+	} while (val);
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult _EgspLoadVarint(EgspLoader* pLoader, uint64_t* pVal)
+{
+	uint64_t val = 0;
+	if (_EgspAvailable(pLoader) >= EGSP_VARINT_MAX)
+	{
+		const uint8_t* pSrc = pLoader->pData + pLoader->offset;
+#if !EGSP_BIG_ENDIAN && defined(__GNUC__)
+		// Up to 8 bytes at once: the first byte without its top bit set ends the number,
+		// then the 7 bit groups are squeezed together in three steps
+		uint64_t word;
+		memcpy(&word, pSrc, 8);
+		uint64_t stops = ~word & 0x8080808080808080ull;
+		if (stops)
+		{
+			word &= (stops ^ (stops - 1)) & 0x7F7F7F7F7F7F7F7Full;
+			word = ((word & 0x7F007F007F007F00ull) >> 1) | (word & 0x007F007F007F007Full);
+			word = ((word & 0x3FFF00003FFF0000ull) >> 2) | (word & 0x00003FFF00003FFFull);
+			word = ((word & 0x0FFFFFFF00000000ull) >> 4) | (word & 0x000000000FFFFFFFull);
+			*pVal = word;
+			pLoader->offset += (__builtin_ctzll(stops) >> 3) + 1;
+			return EGSP_SUCCESS;
+		}
+#endif
+		for (size_t i = 0; i < EGSP_VARINT_MAX; ++i)
+		{
+			val |= (uint64_t)(pSrc[i] & 0x7F) << (7 * i);
+			if (!(pSrc[i] & 0x80))
+			{
+				*pVal = val;
+				pLoader->offset += i + 1;
+				return EGSP_SUCCESS;
+			}
+		}
+		return EGSP_FAIL;
+	}
+
+	for (size_t i = 0; i < EGSP_VARINT_MAX; ++i)
+	{
+		EGSP_TRY(_EgspCheckOverFlow(pLoader));
+		uint8_t byte = pLoader->pData[pLoader->offset++];
+		val |= (uint64_t)(byte & 0x7F) << (7 * i);
+		if (!(byte & 0x80))
+		{
+			*pVal = val;
+			return EGSP_SUCCESS;
+		}
+	}
+	return EGSP_FAIL;
+}
+
+// Reads a varint into a number of size bytes
+static inline EgspResult _EgspLoadVarintAs(EgspLoader* pLoader, void* pVal, size_t size, EgspKind kind)
+{
+	uint64_t val = 0;
+	EGSP_TRY(_EgspLoadVarint(pLoader, &val));
+	EGSP_TRY(_EgspVarintValue(&val, size, kind));
+	switch (size)
+	{
+	case 2: { uint16_t v = (uint16_t)val; memcpy(pVal, &v, 2); break; }
+	case 4: { uint32_t v = (uint32_t)val; memcpy(pVal, &v, 4); break; }
+	default: memcpy(pVal, &val, 8);
+	}
+	return EGSP_SUCCESS;
+}
+
+static inline int _EgspVarint(EgspLoader* pLoader)
+{
+	return (pLoader->flags & EGSP_FLAG_VARINT) != 0;
+}
+
+// 64 bit
+static inline EgspResult _EgspLoadBig64(EgspLoader* pLoader, uint64_t* pVal)
+{
+	if (_EgspAvailable(pLoader) >= 8)
+	{
+		uint64_t val;
+		memcpy(&val, pLoader->pData + pLoader->offset, 8);
+		*pVal = EGSP_BE64(val);
+		pLoader->offset += 8;
+		return EGSP_SUCCESS;
+	}
+
+	*pVal = 0;
+	for (int i = 0; i < 8; ++i)
+	{
+		EGSP_TRY(_EgspCheckOverFlow(pLoader));
+		*pVal <<= 8;
+		*pVal += (pLoader->pData)[pLoader->offset++];
+	}
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult _EgspSaveBig64(EgspLoader* pLoader, uint64_t* pVal)
+{
+	if (_EgspAvailable(pLoader) >= 8)
+	{
+		uint64_t val = EGSP_BE64(*pVal);
+		memcpy(pLoader->pData + pLoader->offset, &val, 8);
+		pLoader->offset += 8;
+		return EGSP_SUCCESS;
+	}
+
+	for (int i = 7; i >= 0; --i)
+	{
+		EGSP_TRY(_EgspCheckOverFlow(pLoader));
+		pLoader->pData[pLoader->offset++] = (uint8_t)((*pVal >> (8 * i)) & 0xFF);
+	}
+	return EGSP_SUCCESS;
+}
+
+EGSP_PRIMITIVE EgspResult _EgspLoaduint64_t(EgspLoader* pLoader, uint64_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspVarint(pLoader) ? _EgspLoadVarint(pLoader, pVal) : _EgspLoadBig64(pLoader, pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspSaveuint64_t(EgspLoader* pLoader, uint64_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspVarint(pLoader) ? _EgspSaveVarint(pLoader, *pVal) : _EgspSaveBig64(pLoader, pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspLoadint64_t(EgspLoader* pLoader, int64_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspVarint(pLoader) ? _EgspLoadVarintAs(pLoader, pVal, 8, EGSP_KIND_SIGNED) : _EgspLoadBig64(pLoader, (uint64_t*)pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspSaveint64_t(EgspLoader* pLoader, int64_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspVarint(pLoader) ? _EgspSaveVarint(pLoader, _EgspZigZag(*pVal)) : _EgspSaveBig64(pLoader, (uint64_t*)pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspLoaddouble(EgspLoader* pLoader, double* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_FLOAT, 1, _EgspLoadBig64(pLoader, (uint64_t*)pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspSavedouble(EgspLoader* pLoader, double* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_FLOAT, 1, _EgspSaveBig64(pLoader, (uint64_t*)pVal));
+}
+
+// 32 bit
+static inline EgspResult _EgspLoadBig32(EgspLoader* pLoader, uint32_t* pVal)
+{
+	if (_EgspAvailable(pLoader) >= 4)
+	{
+		uint32_t val;
+		memcpy(&val, pLoader->pData + pLoader->offset, 4);
+		*pVal = EGSP_BE32(val);
+		pLoader->offset += 4;
+		return EGSP_SUCCESS;
+	}
+
+	*pVal = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		EGSP_TRY(_EgspCheckOverFlow(pLoader));
+		*pVal <<= 8;
+		*pVal += (pLoader->pData)[pLoader->offset++];
+	}
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult _EgspSaveBig32(EgspLoader* pLoader, uint32_t* pVal)
+{
+	if (_EgspAvailable(pLoader) >= 4)
+	{
+		uint32_t val = EGSP_BE32(*pVal);
+		memcpy(pLoader->pData + pLoader->offset, &val, 4);
+		pLoader->offset += 4;
+		return EGSP_SUCCESS;
+	}
+
+	for (int i = 3; i >= 0; --i)
+	{
+		EGSP_TRY(_EgspCheckOverFlow(pLoader));
+		pLoader->pData[pLoader->offset++] = (uint8_t)((*pVal >> (8 * i)) & 0xFF);
+	}
+	return EGSP_SUCCESS;
+}
+
+EGSP_PRIMITIVE EgspResult _EgspLoaduint32_t(EgspLoader* pLoader, uint32_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspVarint(pLoader) ? _EgspLoadVarintAs(pLoader, pVal, 4, EGSP_KIND_UNSIGNED) : _EgspLoadBig32(pLoader, pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspSaveuint32_t(EgspLoader* pLoader, uint32_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspVarint(pLoader) ? _EgspSaveVarint(pLoader, *pVal) : _EgspSaveBig32(pLoader, pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspLoadint32_t(EgspLoader* pLoader, int32_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspVarint(pLoader) ? _EgspLoadVarintAs(pLoader, pVal, 4, EGSP_KIND_SIGNED) : _EgspLoadBig32(pLoader, (uint32_t*)pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspSaveint32_t(EgspLoader* pLoader, int32_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspVarint(pLoader) ? _EgspSaveVarint(pLoader, _EgspZigZag(*pVal)) : _EgspSaveBig32(pLoader, (uint32_t*)pVal));
+}
+
+
+EGSP_PRIMITIVE EgspResult _EgspLoadfloat(EgspLoader* pLoader, float* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_FLOAT, 1, _EgspLoadBig32(pLoader, (uint32_t*)pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspSavefloat(EgspLoader* pLoader, float* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_FLOAT, 1, _EgspSaveBig32(pLoader, (uint32_t*)pVal));
+}
+
+// 16 bit
+static inline EgspResult _EgspLoadBig16(EgspLoader* pLoader, uint16_t* pVal)
+{
+	if (_EgspAvailable(pLoader) >= 2)
+	{
+		uint16_t val;
+		memcpy(&val, pLoader->pData + pLoader->offset, 2);
+		*pVal = EGSP_BE16(val);
+		pLoader->offset += 2;
+		return EGSP_SUCCESS;
+	}
+
+	*pVal = 0;
+	for (int i = 0; i < 2; ++i)
+	{
+		EGSP_TRY(_EgspCheckOverFlow(pLoader));
+		*pVal <<= 8;
+		*pVal += (pLoader->pData)[pLoader->offset++];
+	}
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult _EgspSaveBig16(EgspLoader* pLoader, uint16_t* pVal)
+{
+	if (_EgspAvailable(pLoader) >= 2)
+	{
+		uint16_t val = EGSP_BE16(*pVal);
+		memcpy(pLoader->pData + pLoader->offset, &val, 2);
+		pLoader->offset += 2;
+		return EGSP_SUCCESS;
+	}
+
+	for (int i = 1; i >= 0; --i)
+	{
+		EGSP_TRY(_EgspCheckOverFlow(pLoader));
+		pLoader->pData[pLoader->offset++] = (uint8_t)((*pVal >> (8 * i)) & 0xFF);
+	}
+	return EGSP_SUCCESS;
+}
+
+EGSP_PRIMITIVE EgspResult _EgspLoaduint16_t(EgspLoader* pLoader, uint16_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspVarint(pLoader) ? _EgspLoadVarintAs(pLoader, pVal, 2, EGSP_KIND_UNSIGNED) : _EgspLoadBig16(pLoader, pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspSaveuint16_t(EgspLoader* pLoader, uint16_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspVarint(pLoader) ? _EgspSaveVarint(pLoader, *pVal) : _EgspSaveBig16(pLoader, pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspLoadint16_t(EgspLoader* pLoader, int16_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspVarint(pLoader) ? _EgspLoadVarintAs(pLoader, pVal, 2, EGSP_KIND_SIGNED) : _EgspLoadBig16(pLoader, (uint16_t*)pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspSaveint16_t(EgspLoader* pLoader, int16_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspVarint(pLoader) ? _EgspSaveVarint(pLoader, _EgspZigZag(*pVal)) : _EgspSaveBig16(pLoader, (uint16_t*)pVal));
+}
+
+// 8 bit
+static inline EgspResult _EgspLoadByte(EgspLoader* pLoader, uint8_t* pVal)
+{
+	EGSP_TRY(_EgspCheckOverFlow(pLoader));
+	*pVal = pLoader->pData[pLoader->offset++];
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult _EgspSaveByte(EgspLoader* pLoader, uint8_t* pVal)
+{
+
+	EGSP_TRY(_EgspCheckOverFlow(pLoader));
+	pLoader->pData[pLoader->offset++] = *pVal;
+	return EGSP_SUCCESS;
+}
+
+EGSP_PRIMITIVE EgspResult _EgspLoaduint8_t(EgspLoader* pLoader, uint8_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspLoadByte(pLoader, pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspSaveuint8_t(EgspLoader* pLoader, uint8_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspSaveByte(pLoader, pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspLoadint8_t(EgspLoader* pLoader, int8_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspLoadByte(pLoader, (uint8_t*)pVal));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspSaveint8_t(EgspLoader* pLoader, int8_t* pVal)
+{
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspSaveByte(pLoader, (uint8_t*)pVal));
+}
+
+// Runs of fixed width fields
+EGSP_PRIMITIVE uint8_t* _EgspRun(EgspLoader* pLoader, size_t size)
+{
+#ifdef EGSP_STATS
+	// Field by field, so that each one is counted
+	if (pLoader->pStats)
+	{
+		return 0;
+	}
+#endif
+	if (_EgspVarint(pLoader) || _EgspAvailable(pLoader) < size)
+	{
+		return 0;
+	}
+	uint8_t* pRun = pLoader->pData + pLoader->offset;
+	pLoader->offset += size;
+	return pRun;
+}
+
+#ifdef EGSP_JSON
+// Json numbers
+EGSP_PRIMITIVE EgspResult _EgspPrintuint64_t(EgspLoader* pLoader, uint64_t* pVal)
+{
+	char buffer[EGSP_NUMBER_LENGTH];
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspWriteNumber(pLoader, buffer, EgspUint64ToText(buffer, *pVal)));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspPrintint64_t(EgspLoader* pLoader, int64_t* pVal)
+{
+	char buffer[EGSP_NUMBER_LENGTH];
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspWriteNumber(pLoader, buffer, EgspInt64ToText(buffer, *pVal)));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspPrintdouble(EgspLoader* pLoader, double* pVal)
+{
+	char buffer[EGSP_NUMBER_LENGTH];
+	EGSP_COUNTED(EGSP_KIND_FLOAT, 1, _EgspWriteNumber(pLoader, buffer, EgspDoubleToText(buffer, *pVal)));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspPrintuint32_t(EgspLoader* pLoader, uint32_t* pVal)
+{
+	char buffer[EGSP_NUMBER_LENGTH];
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspWriteNumber(pLoader, buffer, EgspUint64ToText(buffer, *pVal)));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspPrintint32_t(EgspLoader* pLoader, int32_t* pVal)
+{
+	char buffer[EGSP_NUMBER_LENGTH];
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspWriteNumber(pLoader, buffer, EgspInt64ToText(buffer, *pVal)));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspPrintfloat(EgspLoader* pLoader, float* pVal)
+{
+	char buffer[EGSP_NUMBER_LENGTH];
+	EGSP_COUNTED(EGSP_KIND_FLOAT, 1, _EgspWriteNumber(pLoader, buffer, EgspFloatToText(buffer, *pVal)));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspPrintuint16_t(EgspLoader* pLoader, uint16_t* pVal)
+{
+	char buffer[EGSP_NUMBER_LENGTH];
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspWriteNumber(pLoader, buffer, EgspUint64ToText(buffer, *pVal)));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspPrintint16_t(EgspLoader* pLoader, int16_t* pVal)
+{
+	char buffer[EGSP_NUMBER_LENGTH];
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspWriteNumber(pLoader, buffer, EgspInt64ToText(buffer, *pVal)));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspPrintuint8_t(EgspLoader* pLoader, uint8_t* pVal)
+{
+	char buffer[EGSP_NUMBER_LENGTH];
+	EGSP_COUNTED(EGSP_KIND_UNSIGNED, 1, _EgspWriteNumber(pLoader, buffer, EgspUint64ToText(buffer, *pVal)));
+}
+
+EGSP_PRIMITIVE EgspResult _EgspPrintint8_t(EgspLoader* pLoader, int8_t* pVal)
+{
+	char buffer[EGSP_NUMBER_LENGTH];
+	EGSP_COUNTED(EGSP_KIND_SIGNED, 1, _EgspWriteNumber(pLoader, buffer, EgspInt64ToText(buffer, *pVal)));
+}
+#endif // EGSP_JSON
+
+#endif
@@ -1,49 +1,195 @@
+#if defined(EGSP_STATS) && defined(__linux__)
+#define _GNU_SOURCE
+#endif
+// The library always has its own copies of the primitives, whether the code using it inlines them or not
+#undef EGSP_INLINE
 #include "egsplib.h"
+#define EGSP_PRIMITIVE
+#include "egspinline.h"
+#include "egspnum.h"
 #include <string.h>
 #include <stdlib.h>
-#include <stdio.h>
 #include <assert.h>
+#ifdef EGSP_STATS
+#include <time.h>
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 #define EGSP_NUMERIC_BUFFER_LENGTH 256
 
 static size_t EGSP_BLOCK_SIZE = 4096;
 static size_t ALIGN_BYTES = 2;
-
+static uint32_t FLAGS = 0;
 
 // Utility
-size_t EgspPad(size_t bytes)
+void EgspInitLoader(EgspLoader* pLoader, EgspFuncEx pFunc, void* pUser)
 {
-	return bytes + (ALIGN_BYTES - (bytes % ALIGN_BYTES)) % ALIGN_BYTES;
+	pLoader->pData = 0;
+	pLoader->offset = 0;
+	pLoader->blockSize = EGSP_BLOCK_SIZE;
+	pLoader->alignBytes = ALIGN_BYTES;
+	pLoader->pFunc = 0;
+	pLoader->pFuncEx = pFunc;
+	pLoader->pUser = pUser;
+	pLoader->flags = FLAGS;
+	pLoader->pHeap = 0;
+	pLoader->heapSize = 0;
+	pLoader->last = 0;
+	pLoader->indent = 0;
+	pLoader->pPool = 0;
+	pLoader->pChunk = 0;
+	pLoader->measured = 0;
+	pLoader->pStats = 0;
 }
 
-void* EgspAlloc(EgspLoader* pLoader, size_t size)
+#ifdef EGSP_STATS
+static uint64_t _EgspNanoseconds()
 {
-	size_t padded = EgspPad(size);
-	if (padded > pLoader->heapSize)
+	struct timespec time;
+#if defined(_WIN32)
+	timespec_get(&time, TIME_UTC);
+#else
+	clock_gettime(CLOCK_MONOTONIC, &time);
+#endif
+	return (uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_nsec;
+}
+
+uint64_t _EgspStatsPosition(EgspLoader* pLoader)
+{
+	return pLoader->pStats ? pLoader->pStats->streamed + pLoader->offset : 0;
+}
+
+void _EgspStatsStruct(EgspLoader* pLoader, int index, const char* pName, uint64_t start)
+{
+	EgspStats* pStats = pLoader->pStats;
+	if (pStats && index < EGSP_STATS_STRUCTS)
 	{
-		assert(0 && "Buffer overflow");
-		return 0;
+		pStats->structs[index].pName = pName;
+		++pStats->structs[index].calls;
+		pStats->structs[index].bytes += _EgspStatsPosition(pLoader) - start;
 	}
+}
 
-	pLoader->heapSize -= padded;
-	return (uint8_t*)pLoader->pHeap + pLoader->heapSize;
+void _EgspStatsKind(EgspLoader* pLoader, EgspKind kind, size_t count, uint64_t start)
+{
+	EgspStats* pStats = pLoader->pStats;
+	if (pStats)
+	{
+		pStats->kindCalls[kind] += count;
+		pStats->kindBytes[kind] += _EgspStatsPosition(pLoader) - start;
+	}
 }
 
-EgspResult EgspFlush(EgspLoader* pLoader)
+static void _EgspStatsFunc(EgspStats* pStats, size_t size, uint64_t nanoseconds)
+{
+	size_t bucket = 0;
+	for (uint64_t rest = nanoseconds >> 8; rest && bucket + 1 < EGSP_STATS_BUCKETS; rest >>= 1)
+	{
+		++bucket;
+	}
+	++pStats->funcCalls;
+	pStats->funcNanoseconds += nanoseconds;
+	++pStats->funcHistogram[bucket];
+	pStats->streamed += size;
+}
+
+static void _EgspStatsAlloc(EgspLoader* pLoader, size_t size, size_t padded)
+{
+	EgspStats* pStats = pLoader->pStats;
+	if (pStats)
+	{
+		++pStats->allocCalls;
+		pStats->allocBytes += size;
+		pStats->allocPadding += padded - size;
+		if (pStats->heapStart > pLoader->heapSize && pStats->heapStart - pLoader->heapSize > pStats->heapHighWater)
+		{
+			pStats->heapHighWater = pStats->heapStart - pLoader->heapSize;
+		}
+	}
+}
+#endif // EGSP_STATS
+
+// Hands the used part of the current block over and moves on to the next one
+EgspResult _EgspNextBlock(EgspLoader* pLoader, size_t size)
 {
-	EgspResult retval = (pLoader->pData = pLoader->pFunc(pLoader->offset)) ? EGSP_SUCCESS : EGSP_FAIL;
+	// A single span has no next block. Staying at its end tells callers it ran out rather than failed.
+	if (!_EgspStreamed(pLoader))
+	{
+		pLoader->offset = pLoader->blockSize;
+		return EGSP_FAIL;
+	}
+#ifdef EGSP_STATS
+	uint64_t start = pLoader->pStats ? _EgspNanoseconds() : 0;
+#endif
+	if (pLoader->pFuncEx)
+	{
+		pLoader->pData = pLoader->pFuncEx(pLoader->pUser, size);
+	}
+	else
+	{
+		pLoader->pData = pLoader->pFunc(size);
+	}
+#ifdef EGSP_STATS
+	if (pLoader->pStats)
+	{
+		_EgspStatsFunc(pLoader->pStats, size, _EgspNanoseconds() - start);
+	}
+#endif
 	pLoader->offset = 0;
-	return retval;
+	return pLoader->pData ? EGSP_SUCCESS : EGSP_FAIL;
 }
 
-static EgspResult CheckOverFlow(EgspLoader* pLoader)
+EgspResult EgspBegin(EgspLoader* pLoader)
 {
-	if (pLoader->offset + 1 >= EGSP_BLOCK_SIZE)
+	pLoader->offset = 0;
+	pLoader->last = 0;
+	pLoader->indent = 0;
+#ifdef EGSP_STATS
+	if (pLoader->pStats)
 	{
-		EGSP_TEST(pLoader->pData = pLoader->pFunc(pLoader->offset));
-		pLoader->offset = 0;
+		pLoader->pStats->heapStart = pLoader->heapSize;
 	}
-	return EGSP_SUCCESS;
+#endif
+	return _EgspStreamed(pLoader) ? _EgspNextBlock(pLoader, 0) : EGSP_SUCCESS;
+}
+
+EgspResult EgspFlush(EgspLoader* pLoader)
+{
+	return _EgspStreamed(pLoader) ? _EgspNextBlock(pLoader, pLoader->offset) : EGSP_SUCCESS;
+}
+
+size_t EgspPad(size_t bytes)
+{
+	return bytes + (ALIGN_BYTES - (bytes % ALIGN_BYTES)) % ALIGN_BYTES;
+}
+
+size_t _EgspPad(EgspLoader* pLoader, size_t bytes)
+{
+	return bytes + (pLoader->alignBytes - (bytes % pLoader->alignBytes)) % pLoader->alignBytes;
+}
+
+void* EgspAlloc(EgspLoader* pLoader, size_t size)
+{
+	size_t padded = _EgspPad(pLoader, size);
+	if (padded > pLoader->heapSize)
+	{
+		assert(0 && "Buffer overflow");
+		return 0;
+	}
+
+	pLoader->heapSize -= padded;
+#ifdef EGSP_STATS
+	_EgspStatsAlloc(pLoader, size, padded);
+#endif
+	return (uint8_t*)pLoader->pHeap + pLoader->heapSize;
 }
 
 void EgspSetAlignBytes(size_t bytes)
@@ -66,250 +212,649 @@ size_t EgspBlockSize()
 	return EGSP_BLOCK_SIZE;
 }
 
-// 64 bit
-EgspResult _EgspLoaduint64_t(EgspLoader* pLoader, uint64_t* pVal)
+void EgspSetFlags(uint32_t flags)
+{
+	FLAGS = flags;
+}
+
+uint32_t EgspFlags()
+{
+	return FLAGS;
+}
+
+// Varints, see EGSP_FLAG_VARINT. Reading and writing them is in egspinline.h.
+static size_t _EgspVarintSize(uint64_t val)
 {
-	*pVal = 0;
-	for (int i = 0; i < 8; ++i)
+	size_t size = 1;
+	while (val >= 0x80)
 	{
-		EGSP_TRY(CheckOverFlow(pLoader));
-		*pVal <<= 8;
-		*pVal += (pLoader->pData)[pLoader->offset++];
+		val >>= 7;
+		++size;
 	}
-	return EGSP_SUCCESS;
+	return size;
 }
 
-EgspResult _EgspSaveuint64_t(EgspLoader* pLoader, uint64_t* pVal)
+EgspResult _EgspVarintValue(uint64_t* pVal, size_t size, EgspKind kind)
 {
-	for (int i = 7; i >= 0; --i)
+	if (kind == EGSP_KIND_SIGNED || kind == EGSP_KIND_ENUM)
 	{
-		EGSP_TRY(CheckOverFlow(pLoader));
-		pLoader->pData[pLoader->offset++] = (uint8_t)((*pVal >> (8 * i)) & 0xFF);
+		int64_t val = (int64_t)(*pVal >> 1) ^ -(int64_t)(*pVal & 1);
+		EGSP_TEST(size == 8 || (val >= -((int64_t)1 << (8 * size - 1)) && val < ((int64_t)1 << (8 * size - 1))));
+		*pVal = (uint64_t)val;
+		return EGSP_SUCCESS;
 	}
+	EGSP_TEST(size == 8 || *pVal < ((uint64_t)1 << (8 * size)));
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspLoadint64_t(EgspLoader* pLoader, int64_t* pVal)
+// Arrays
+#if defined(__SSSE3__) || defined(__AVX2__)
+// Byte shuffles reversing every 2, 4 and 8 byte lane
+static const uint8_t s_swapMasks[3][16] = {
+	{ 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 },
+	{ 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 },
+	{ 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 }
+};
+#endif
+
+// Copies count elements of size bytes, converting each between native and big-endian
+static void _EgspSwapCopy(uint8_t* pDst, const uint8_t* pSrc, size_t count, size_t size)
 {
-	return _EgspLoaduint64_t(pLoader, (uint64_t*)pVal);
-}
+	size_t bytes = count * size;
+	size_t i = 0;
+	if (EGSP_BIG_ENDIAN || size == 1)
+	{
+		memcpy(pDst, pSrc, bytes);
+		return;
+	}
 
-EgspResult _EgspSaveint64_t(EgspLoader* pLoader, int64_t* pVal)
-{
-	return _EgspSaveuint64_t(pLoader, (uint64_t*)pVal);
-}
+#if defined(__SSSE3__) || defined(__AVX2__)
+	__m128i mask = _mm_loadu_si128((const __m128i*)s_swapMasks[size >> 2]);
+#if defined(__AVX2__)
+	__m256i mask256 = _mm256_broadcastsi128_si256(mask);
+	for (; i + 32 <= bytes; i += 32)
+	{
+		__m256i val = _mm256_loadu_si256((const __m256i*)(pSrc + i));
+		_mm256_storeu_si256((__m256i*)(pDst + i), _mm256_shuffle_epi8(val, mask256));
+	}
+#endif
+	for (; i + 16 <= bytes; i += 16)
+	{
+		__m128i val = _mm_loadu_si128((const __m128i*)(pSrc + i));
+		_mm_storeu_si128((__m128i*)(pDst + i), _mm_shuffle_epi8(val, mask));
+	}
+#elif defined(__SSE2__) || defined(_M_X64)
+	// No byte shuffle, so swap the 16 bit words within each element and then the bytes within each word
+	for (; i + 16 <= bytes; i += 16)
+	{
+		__m128i val = _mm_loadu_si128((const __m128i*)(pSrc + i));
+		if (size == 4)
+		{
+			val = _mm_shufflehi_epi16(_mm_shufflelo_epi16(val, 0xB1), 0xB1);
+		}
+		else if (size == 8)
+		{
+			val = _mm_shufflehi_epi16(_mm_shufflelo_epi16(val, 0x1B), 0x1B);
+		}
+		val = _mm_or_si128(_mm_slli_epi16(val, 8), _mm_srli_epi16(val, 8));
+		_mm_storeu_si128((__m128i*)(pDst + i), val);
+	}
+#endif
 
-EgspResult _EgspLoadDouble(EgspLoader* pLoader, double* pVal)
-{
-	return _EgspLoaduint64_t(pLoader, (uint64_t*)pVal);
+	for (; i < bytes; i += size)
+	{
+		switch (size)
+		{
+		case 2:
+		{
+			uint16_t val;
+			memcpy(&val, pSrc + i, 2);
+			val = EGSP_BE16(val);
+			memcpy(pDst + i, &val, 2);
+			break;
+		}
+		case 4:
+		{
+			uint32_t val;
+			memcpy(&val, pSrc + i, 4);
+			val = EGSP_BE32(val);
+			memcpy(pDst + i, &val, 4);
+			break;
+		}
+		default:
+		{
+			uint64_t val;
+			memcpy(&val, pSrc + i, 8);
+			val = EGSP_BE64(val);
+			memcpy(pDst + i, &val, 8);
+		}
+		}
+	}
 }
 
-EgspResult _EgspSaveDouble(EgspLoader* pLoader, double* pVal)
+// Integers go one varint at a time when the stream has them, everything else is copied across in runs
+static int _EgspVarintArray(EgspLoader* pLoader, size_t size, EgspKind kind)
 {
-	return _EgspSaveuint64_t(pLoader, (uint64_t*)pVal);
+	return _EgspVarint(pLoader) && size > 1 && kind != EGSP_KIND_FLOAT;
 }
 
-// 32 bit
-EgspResult _EgspLoaduint32_t(EgspLoader* pLoader, uint32_t* pVal)
+static EgspResult _EgspLoadNumbers(EgspLoader* pLoader, void* pVals, size_t count, size_t size, EgspKind kind)
 {
-	*pVal = 0;
-	for (int i = 0; i < 4; ++i)
+	uint8_t* pDst = (uint8_t*)pVals;
+	if (_EgspVarintArray(pLoader, size, kind))
 	{
-		EGSP_TRY(CheckOverFlow(pLoader));
-		*pVal <<= 8;
-		*pVal += (pLoader->pData)[pLoader->offset++];
+		for (size_t i = 0; i < count; ++i)
+		{
+			EGSP_TRY(_EgspLoadVarintAs(pLoader, pDst + i * size, size, kind));
+		}
+		return EGSP_SUCCESS;
 	}
-	return EGSP_SUCCESS;
-}
 
-EgspResult _EgspSaveuint32_t(EgspLoader* pLoader, uint32_t* pVal)
-{
-	for (int i = 3; i >= 0; --i)
+	while (count)
 	{
-		EGSP_TRY(CheckOverFlow(pLoader));
-		pLoader->pData[pLoader->offset++] = (uint8_t)((*pVal >> (8 * i)) & 0xFF);
+		size_t run = _EgspAvailable(pLoader) / size;
+		run = run < count ? run : count;
+		_EgspSwapCopy(pDst, pLoader->pData + pLoader->offset, run, size);
+		pLoader->offset += run * size;
+		pDst += run * size;
+		count -= run;
+
+		// The next element straddles two blocks
+		if (count)
+		{
+			switch (size)
+			{
+			case 1: EGSP_TRY(_EgspLoadByte(pLoader, (uint8_t*)pDst)); break;
+			case 2: EGSP_TRY(_EgspLoadBig16(pLoader, (uint16_t*)pDst)); break;
+			case 4: EGSP_TRY(_EgspLoadBig32(pLoader, (uint32_t*)pDst)); break;
+			case 8: EGSP_TRY(_EgspLoadBig64(pLoader, (uint64_t*)pDst)); break;
+			default: return EGSP_FAIL;
+			}
+			pDst += size;
+			--count;
+		}
 	}
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspLoadint32_t(EgspLoader* pLoader, int32_t* pVal)
+static uint64_t _EgspVarintOf(const uint8_t* pSrc, size_t size, EgspKind kind)
 {
-	return _EgspLoaduint32_t(pLoader, (uint32_t*)pVal);
+	switch (size)
+	{
+	case 2: { uint16_t v; memcpy(&v, pSrc, 2); return kind == EGSP_KIND_SIGNED ? _EgspZigZag((int16_t)v) : v; }
+	case 4: { uint32_t v; memcpy(&v, pSrc, 4); return kind == EGSP_KIND_SIGNED ? _EgspZigZag((int32_t)v) : v; }
+	default: { uint64_t v; memcpy(&v, pSrc, 8); return kind == EGSP_KIND_SIGNED ? _EgspZigZag((int64_t)v) : v; }
+	}
 }
 
-EgspResult _EgspSaveint32_t(EgspLoader* pLoader, int32_t* pVal)
+static EgspResult _EgspSaveNumbers(EgspLoader* pLoader, const void* pVals, size_t count, size_t size, EgspKind kind)
 {
-	return _EgspSaveuint32_t(pLoader, (uint32_t*)pVal);
-}
+	const uint8_t* pSrc = (const uint8_t*)pVals;
+	if (_EgspVarintArray(pLoader, size, kind))
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			EGSP_TRY(_EgspSaveVarint(pLoader, _EgspVarintOf(pSrc + i * size, size, kind)));
+		}
+		return EGSP_SUCCESS;
+	}
 
+	while (count)
+	{
+		size_t run = _EgspAvailable(pLoader) / size;
+		run = run < count ? run : count;
+		_EgspSwapCopy(pLoader->pData + pLoader->offset, pSrc, run, size);
+		pLoader->offset += run * size;
+		pSrc += run * size;
+		count -= run;
+
+		// The next element straddles two blocks
+		if (count)
+		{
+			switch (size)
+			{
+			case 1: EGSP_TRY(_EgspSaveByte(pLoader, (uint8_t*)pSrc)); break;
+			case 2: EGSP_TRY(_EgspSaveBig16(pLoader, (uint16_t*)pSrc)); break;
+			case 4: EGSP_TRY(_EgspSaveBig32(pLoader, (uint32_t*)pSrc)); break;
+			case 8: EGSP_TRY(_EgspSaveBig64(pLoader, (uint64_t*)pSrc)); break;
+			default: return EGSP_FAIL;
+			}
+			pSrc += size;
+			--count;
+		}
+	}
+	return EGSP_SUCCESS;
+}
 
-EgspResult _EgspLoadfloat(EgspLoader* pLoader, float* pVal)
+EgspResult _EgspLoadArray(EgspLoader* pLoader, void* pVals, size_t count, size_t size, EgspKind kind)
 {
-	return _EgspLoaduint32_t(pLoader, (uint32_t*)pVal);
+	EGSP_COUNTED(kind, count, _EgspLoadNumbers(pLoader, pVals, count, size, kind));
 }
 
-EgspResult _EgspSavefloat(EgspLoader* pLoader, float* pVal)
+EgspResult _EgspSaveArray(EgspLoader* pLoader, const void* pVals, size_t count, size_t size, EgspKind kind)
 {
-	return _EgspSaveuint32_t(pLoader, (uint32_t*)pVal);
+	EGSP_COUNTED(kind, count, _EgspSaveNumbers(pLoader, pVals, count, size, kind));
 }
 
-// 16 bit
-EgspResult _EgspLoaduint16_t(EgspLoader* pLoader, uint16_t* pVal)
+// Raw
+EgspResult _EgspLoadBytes(EgspLoader* pLoader, void* pBytes, size_t size)
 {
-	*pVal = 0;
-	for (int i = 0; i < 2; ++i)
+	uint8_t* pDst = (uint8_t*)pBytes;
+	while (size)
 	{
-		EGSP_TRY(CheckOverFlow(pLoader));
-		*pVal <<= 8;
-		*pVal += (pLoader->pData)[pLoader->offset++];
+		size_t run = _EgspAvailable(pLoader);
+		if (run == 0)
+		{
+			EGSP_TRY(_EgspCheckOverFlow(pLoader));
+			run = _EgspAvailable(pLoader) ? _EgspAvailable(pLoader) : 1;
+		}
+		run = run < size ? run : size;
+		memcpy(pDst, pLoader->pData + pLoader->offset, run);
+		pLoader->offset += run;
+		pDst += run;
+		size -= run;
 	}
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspSaveuint16_t(EgspLoader* pLoader, uint16_t* pVal)
+EgspResult _EgspSaveBytes(EgspLoader* pLoader, const void* pBytes, size_t size)
 {
-	for (int i = 1; i >= 0; --i)
+	const uint8_t* pSrc = (const uint8_t*)pBytes;
+	while (size)
 	{
-		EGSP_TRY(CheckOverFlow(pLoader));
-		pLoader->pData[pLoader->offset++] = (uint8_t)((*pVal >> (8 * i)) & 0xFF);
+		size_t run = _EgspAvailable(pLoader);
+		if (run == 0)
+		{
+			EGSP_TRY(_EgspCheckOverFlow(pLoader));
+			run = _EgspAvailable(pLoader) ? _EgspAvailable(pLoader) : 1;
+		}
+		run = run < size ? run : size;
+		memcpy(pLoader->pData + pLoader->offset, pSrc, run);
+		pLoader->offset += run;
+		pSrc += run;
+		size -= run;
 	}
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspLoadint16_t(EgspLoader* pLoader, int16_t* pVal)
+static void _EgspReverse(uint8_t* pDst, const uint8_t* pSrc, size_t size)
 {
-	return _EgspLoaduint16_t(pLoader, (uint16_t*)pVal);
+	for (size_t i = 0; i < size; ++i)
+	{
+		pDst[i] = pSrc[size - 1 - i];
+	}
 }
 
-EgspResult _EgspSaveint16_t(EgspLoader* pLoader, int16_t* pVal)
+// Turns raw structs that were just copied in from the stream into native byte order
+void _EgspFixRaw(void* pVals, size_t count, const uint8_t* pLayout)
 {
-	return _EgspSaveuint16_t(pLoader, (uint16_t*)pVal);
+	if (EGSP_BIG_ENDIAN)
+	{
+		uint8_t* pField = (uint8_t*)pVals;
+		for (size_t i = 0; i < count; ++i)
+		{
+			for (const uint8_t* pSize = pLayout; *pSize; pField += *pSize++)
+			{
+				uint8_t tmp[8];
+				memcpy(tmp, pField, *pSize);
+				_EgspReverse(pField, tmp, *pSize);
+			}
+		}
+	}
 }
 
-// 8 bit
-EgspResult _EgspLoaduint8_t(EgspLoader* pLoader, uint8_t* pVal)
+static EgspResult _EgspLoadRawStructs(EgspLoader* pLoader, void* pVals, size_t count, size_t size, const uint8_t* pLayout)
 {
-	EGSP_TRY(CheckOverFlow(pLoader));
-	*pVal = pLoader->pData[pLoader->offset++];
+	EGSP_TRY(_EgspLoadBytes(pLoader, pVals, count * size));
+	_EgspFixRaw(pVals, count, pLayout);
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspSaveuint8_t(EgspLoader* pLoader, uint8_t* pVal)
+static EgspResult _EgspSaveRawStructs(EgspLoader* pLoader, const void* pVals, size_t count, size_t size, const uint8_t* pLayout)
 {
+	if (!EGSP_BIG_ENDIAN)
+	{
+		return _EgspSaveBytes(pLoader, pVals, count * size);
+	}
 
-	EGSP_TRY(CheckOverFlow(pLoader));
-	pLoader->pData[pLoader->offset++] = *pVal;
+	const uint8_t* pField = (const uint8_t*)pVals;
+	for (size_t i = 0; i < count; ++i)
+	{
+		for (const uint8_t* pSize = pLayout; *pSize; pField += *pSize++)
+		{
+			uint8_t tmp[8];
+			_EgspReverse(tmp, pField, *pSize);
+			EGSP_TRY(_EgspSaveBytes(pLoader, tmp, *pSize));
+		}
+	}
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspLoadint8_t(EgspLoader* pLoader, uint8_t* pVal)
+EgspResult _EgspLoadRaw(EgspLoader* pLoader, void* pVals, size_t count, size_t size, const uint8_t* pLayout)
 {
-	return _EgspLoaduint8_t(pLoader, (uint8_t*)pVal);
+	EGSP_COUNTED(EGSP_KIND_RAW, count, _EgspLoadRawStructs(pLoader, pVals, count, size, pLayout));
 }
 
-EgspResult _EgspSaveInt8(EgspLoader* pLoader, int8_t* pVal)
+EgspResult _EgspSaveRaw(EgspLoader* pLoader, const void* pVals, size_t count, size_t size, const uint8_t* pLayout)
 {
-	return _EgspSaveuint8_t(pLoader, (uint8_t*)pVal);
+	EGSP_COUNTED(EGSP_KIND_RAW, count, _EgspSaveRawStructs(pLoader, pVals, count, size, pLayout));
 }
 
 // String
-EgspResult _EgspLoadstring(EgspLoader* pLoader, const char** ppString)
+// Lengths go like any uint32_t, but count as part of their string
+static EgspResult _EgspLoadLength(EgspLoader* pLoader, uint32_t* pLength)
+{
+	return _EgspVarint(pLoader) ? _EgspLoadVarintAs(pLoader, pLength, 4, EGSP_KIND_UNSIGNED) : _EgspLoadBig32(pLoader, pLength);
+}
+
+static EgspResult _EgspSaveLength(EgspLoader* pLoader, uint32_t* pLength)
+{
+	return _EgspVarint(pLoader) ? _EgspSaveVarint(pLoader, *pLength) : _EgspSaveBig32(pLoader, pLength);
+}
+
+// Zero copy streams store the terminator as well, so that a string within one block can be used in place.
+static EgspResult _EgspLoadText(EgspLoader* pLoader, const char** ppString)
 {
 	uint32_t length = 0;
-	EGSP_TRY(_EgspLoaduint32_t(pLoader, &length));
-	EGSP_TRY(CheckOverFlow(pLoader));
+	EGSP_TRY(_EgspLoadLength(pLoader, &length));
+	size_t stored = (pLoader->flags & EGSP_FLAG_ZERO_COPY) ? (size_t)length + 1 : length;
+	if (stored)
+	{
+		EGSP_TRY(_EgspCheckOverFlow(pLoader));
+	}
+
+	if ((pLoader->flags & EGSP_FLAG_ZERO_COPY) && stored <= pLoader->blockSize - pLoader->offset)
+	{
+		EGSP_TEST(pLoader->pData[pLoader->offset + length] == '\0');
+		*ppString = (const char*)pLoader->pData + pLoader->offset;
+		pLoader->offset += stored;
+		return EGSP_SUCCESS;
+	}
 
 	char* pbuffer = EgspAlloc(pLoader, length + 1);
+	EGSP_TEST(pbuffer);
 	size_t pos = 0;
-	for (size_t remain = EGSP_BLOCK_SIZE - pLoader->offset; remain < length - pos; pos += remain)
+	for (size_t remain = pLoader->blockSize - pLoader->offset; remain < stored - pos; remain = pLoader->blockSize)
 	{
 		memcpy(pbuffer + pos, pLoader->pData + pLoader->offset, remain);
-		EGSP_TEST(pLoader->pData = pLoader->pFunc(EGSP_BLOCK_SIZE));
-		pLoader->offset = 0;
-		remain = EGSP_BLOCK_SIZE;
+		pos += remain;
+		EGSP_TRY(_EgspNextBlock(pLoader, pLoader->blockSize));
 	}
-	memcpy(pbuffer + pos, pLoader->pData + pLoader->offset, length - pos);
-	pLoader->offset += length - pos;
+	memcpy(pbuffer + pos, pLoader->pData + pLoader->offset, stored - pos);
+	pLoader->offset += stored - pos;
 	pbuffer[length] = '\0';
 	*ppString = pbuffer;
 
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspSavestring(EgspLoader* pLoader, const char** ppString)
+static EgspResult _EgspSaveText(EgspLoader* pLoader, const char** ppString)
 {
 	uint32_t length = (uint32_t)strlen(*ppString);
-	pLoader->heapSize += EgspPad(length + 1);
+	size_t stored = (pLoader->flags & EGSP_FLAG_ZERO_COPY) ? (size_t)length + 1 : length;
 
-	EGSP_TRY(_EgspSaveuint32_t(pLoader, &length));
-	EGSP_TRY(CheckOverFlow(pLoader));
+	EGSP_TRY(_EgspSaveLength(pLoader, &length));
+	return _EgspSaveChars(pLoader, *ppString, length, stored);
+}
+
+EgspResult _EgspLoadstring(EgspLoader* pLoader, const char** ppString)
+{
+	EGSP_COUNTED(EGSP_KIND_STRING, 1, _EgspLoadText(pLoader, ppString));
+}
+
+EgspResult _EgspSavestring(EgspLoader* pLoader, const char** ppString)
+{
+	EGSP_COUNTED(EGSP_KIND_STRING, 1, _EgspSaveText(pLoader, ppString));
+}
+
+// The characters of a string after its length. Unlike everything else they fill blocks up to the last byte.
+EgspResult _EgspSaveChars(EgspLoader* pLoader, const char* pChars, size_t length, size_t stored)
+{
+	if (stored)
+	{
+		EGSP_TRY(_EgspCheckOverFlow(pLoader));
+	}
+
+	// Parallel save workers do not know where their blocks will end up, so the
+	// heap for their strings is worked out when the chunks are stitched together
+	if (pLoader->pChunk)
+	{
+		EGSP_TRY(_EgspRecordString(pLoader->pChunk, pLoader->offset, length, stored));
+	}
+	// The loader only needs heap for strings it cannot point at
+	else if (!(pLoader->flags & EGSP_FLAG_ZERO_COPY) || stored > pLoader->blockSize - pLoader->offset)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, length + 1);
+	}
 
 	size_t pos = 0;
-	for (size_t remain = EGSP_BLOCK_SIZE - pLoader->offset; remain < length - pos; pos += remain)
+	for (size_t remain = pLoader->blockSize - pLoader->offset; remain < stored - pos; remain = pLoader->blockSize)
+	{
+		memcpy(pLoader->pData + pLoader->offset, pChars + pos, remain);
+		pos += remain;
+		EGSP_TRY(_EgspNextBlock(pLoader, pLoader->blockSize));
+	}
+
+	memcpy(pLoader->pData + pLoader->offset, pChars + pos, stored - pos);
+	pLoader->offset += stored - pos;
+	return EGSP_SUCCESS;
+}
+
+// Measure
+// Mirrors the block layout of Save without touching pData. A single span is measured as if it had no end,
+// so the result is the span size Save needs. Whole blocks moved past are counted in measured.
+static size_t _EgspMeasureBlockSize(EgspLoader* pLoader)
+{
+	return _EgspStreamed(pLoader) ? pLoader->blockSize : SIZE_MAX;
+}
+
+void _EgspMeasureBytes(EgspLoader* pLoader, size_t size)
+{
+	// Everything but string characters leaves the last byte of a streamed block unused
+	size_t end = _EgspMeasureBlockSize(pLoader) - (_EgspStreamed(pLoader) ? 1 : 0);
+	while (size)
+	{
+		if (pLoader->offset >= end)
+		{
+			pLoader->measured += pLoader->offset;
+			pLoader->offset = 0;
+		}
+		size_t run = end - pLoader->offset;
+		run = run < size ? run : size;
+		pLoader->offset += run;
+		size -= run;
+	}
+}
+
+// Numbers take their fixed width, or as many bytes as their varint needs
+static void _EgspMeasureNumber(EgspLoader* pLoader, uint64_t varint, size_t size)
+{
+	_EgspMeasureBytes(pLoader, _EgspVarint(pLoader) ? _EgspVarintSize(varint) : size);
+}
+
+void _EgspMeasureuint64_t(EgspLoader* pLoader, uint64_t* pVal) { _EgspMeasureNumber(pLoader, *pVal, 8); }
+void _EgspMeasureint64_t(EgspLoader* pLoader, int64_t* pVal) { _EgspMeasureNumber(pLoader, _EgspZigZag(*pVal), 8); }
+void _EgspMeasuredouble(EgspLoader* pLoader, double* pVal) { (void)pVal; _EgspMeasureBytes(pLoader, 8); }
+void _EgspMeasureuint32_t(EgspLoader* pLoader, uint32_t* pVal) { _EgspMeasureNumber(pLoader, *pVal, 4); }
+void _EgspMeasureint32_t(EgspLoader* pLoader, int32_t* pVal) { _EgspMeasureNumber(pLoader, _EgspZigZag(*pVal), 4); }
+void _EgspMeasurefloat(EgspLoader* pLoader, float* pVal) { (void)pVal; _EgspMeasureBytes(pLoader, 4); }
+void _EgspMeasureuint16_t(EgspLoader* pLoader, uint16_t* pVal) { _EgspMeasureNumber(pLoader, *pVal, 2); }
+void _EgspMeasureint16_t(EgspLoader* pLoader, int16_t* pVal) { _EgspMeasureNumber(pLoader, _EgspZigZag(*pVal), 2); }
+void _EgspMeasureuint8_t(EgspLoader* pLoader, uint8_t* pVal) { (void)pVal; _EgspMeasureBytes(pLoader, 1); }
+void _EgspMeasureint8_t(EgspLoader* pLoader, int8_t* pVal) { (void)pVal; _EgspMeasureBytes(pLoader, 1); }
+
+void _EgspMeasureArray(EgspLoader* pLoader, const void* pVals, size_t count, size_t size, EgspKind kind)
+{
+	if (!_EgspVarintArray(pLoader, size, kind))
+	{
+		_EgspMeasureBytes(pLoader, count * size);
+		return;
+	}
+	for (size_t i = 0; i < count; ++i)
 	{
-		memcpy(pLoader->pData + pLoader->offset, *ppString + pos, remain);
-		EGSP_TEST(pLoader->pData = pLoader->pFunc(EGSP_BLOCK_SIZE));
+		_EgspMeasureBytes(pLoader, _EgspVarintSize(_EgspVarintOf((const uint8_t*)pVals + i * size, size, kind)));
+	}
+}
+
+void _EgspMeasurestring(EgspLoader* pLoader, const char** ppString)
+{
+	size_t length = strlen(*ppString);
+	size_t stored = (pLoader->flags & EGSP_FLAG_ZERO_COPY) ? length + 1 : length;
+	size_t blockSize = _EgspMeasureBlockSize(pLoader);
+	uint32_t length32 = (uint32_t)length;
+	_EgspMeasureuint32_t(pLoader, &length32);
+
+	if (stored && pLoader->offset + 1 >= blockSize)
+	{
+		pLoader->measured += pLoader->offset;
 		pLoader->offset = 0;
-		remain = EGSP_BLOCK_SIZE;
+	}
+	if (!(pLoader->flags & EGSP_FLAG_ZERO_COPY) || stored > blockSize - pLoader->offset)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, length + 1);
+	}
+
+	// The characters fill the rest of this block and every block they need after it
+	size_t remain = blockSize - pLoader->offset;
+	if (stored > remain)
+	{
+		size_t rest = stored - remain;
+		size_t blocks = (rest - 1) / blockSize;
+		pLoader->measured += (blocks + 1) * blockSize;
+		pLoader->offset = rest - blocks * blockSize;
+	}
+	else
+	{
+		pLoader->offset += stored;
+	}
+}
+
+// Envelope
+// Always fixed width, so it can be read before knowing how the rest of the stream was saved
+static EgspResult _EgspReadEnvelope(EgspLoader* pLoader, EgspEnvelope* pEnvelope)
+{
+	uint32_t magic = 0;
+	EGSP_TRY(_EgspLoadBig32(pLoader, &magic));
+	EGSP_TEST(magic == EGSP_ENVELOPE_MAGIC);
+	EGSP_TRY(_EgspLoadBig32(pLoader, &pEnvelope->flags));
+	EGSP_TRY(_EgspLoadBig64(pLoader, &pEnvelope->schema));
+	EGSP_TRY(_EgspLoadBig64(pLoader, &pEnvelope->heapSize));
+	return _EgspLoadBig64(pLoader, &pEnvelope->size);
+}
+
+EgspResult EgspPeekEnvelope(const uint8_t* pData, size_t size, EgspEnvelope* pEnvelope)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return _EgspReadEnvelope(&loader, pEnvelope);
+}
+
+EgspResult _EgspSaveEnvelope(EgspLoader* pLoader, uint64_t schema, size_t size, size_t heapSize)
+{
+	if (!(pLoader->flags & EGSP_FLAG_ENVELOPE))
+	{
+		return EGSP_SUCCESS;
 	}
 
-	memcpy(pLoader->pData + pLoader->offset, *ppString + pos, length - pos);
-	pLoader->offset += length - pos;
+	uint32_t magic = EGSP_ENVELOPE_MAGIC;
+	uint32_t flags = pLoader->flags & EGSP_FORMAT_FLAGS;
+	uint64_t size64 = size;
+	uint64_t heapSize64 = heapSize;
+	EGSP_TRY(_EgspSaveBig32(pLoader, &magic));
+	EGSP_TRY(_EgspSaveBig32(pLoader, &flags));
+	EGSP_TRY(_EgspSaveBig64(pLoader, &schema));
+	EGSP_TRY(_EgspSaveBig64(pLoader, &heapSize64));
+	return _EgspSaveBig64(pLoader, &size64);
+}
+
+// Turns the stream down before decoding any of it if it was saved differently, for another
+// schema, or needs more heap than there is. A single span must also hold the whole stream.
+EgspResult _EgspLoadEnvelope(EgspLoader* pLoader, uint64_t schema)
+{
+	if (!(pLoader->flags & EGSP_FLAG_ENVELOPE))
+	{
+		return EGSP_SUCCESS;
+	}
+
+	EgspEnvelope envelope;
+	EGSP_TRY(_EgspReadEnvelope(pLoader, &envelope));
+	EGSP_TEST(envelope.flags == (pLoader->flags & EGSP_FORMAT_FLAGS) && envelope.schema == schema);
+	EGSP_TEST(envelope.heapSize <= pLoader->heapSize);
+	EGSP_TEST(_EgspStreamed(pLoader) || envelope.size <= pLoader->blockSize);
 	return EGSP_SUCCESS;
 }
 
 #ifdef EGSP_JSON
 static EgspResult _EgspWriteChar(EgspLoader* pLoader, char chr)
 {
-	EGSP_TRY(CheckOverFlow(pLoader));
+	EGSP_TRY(_EgspCheckOverFlow(pLoader));
 	pLoader->pData[pLoader->offset++] = chr;
 	return EGSP_SUCCESS;
 }
 
+// A line break and up to 32 tabs of indent, copied in one go
+static const char s_newLine[] = "\n\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+
 static EgspResult _EgspNewLine(EgspLoader* pLoader)
 {
-	EGSP_TRY(_EgspWriteChar(pLoader, '\n'));
-	for (int i = 0; i < pLoader->indent; ++i)
+	if (pLoader->flags & EGSP_FLAG_COMPACT)
+	{
+		return EGSP_SUCCESS;
+	}
+	size_t tabs = pLoader->indent > 0 ? (size_t)pLoader->indent : 0;
+	size_t run = tabs < sizeof(s_newLine) - 2 ? tabs : sizeof(s_newLine) - 2;
+	EGSP_TRY(_EgspSaveBytes(pLoader, s_newLine, run + 1));
+	for (tabs -= run; tabs; tabs -= run)
 	{
-		EGSP_TRY(_EgspWriteChar(pLoader, '\t'));
+		run = tabs < sizeof(s_newLine) - 2 ? tabs : sizeof(s_newLine) - 2;
+		EGSP_TRY(_EgspSaveBytes(pLoader, s_newLine + 1, run));
 	}
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspWriteString(EgspLoader* pLoader, const char* pString)
+// Whatever goes in front of something starting with first: the comma held back from the last value,
+// which is dropped before a closing bracket, and the line break and indent of pretty printing.
+static EgspResult _EgspBeforeToken(EgspLoader* pLoader, char first)
 {
-	size_t length = strlen(pString);
-	for (size_t i = 0; i < length; ++i)
+	switch (pLoader->last)
 	{
-		char cur = pString[i];
+	case '{':
+	case '[':
+		++pLoader->indent;
+		return _EgspNewLine(pLoader);
+	case ',':
+		if (first != ']' && first != '}')
+		{
+			EGSP_TRY(_EgspWriteChar(pLoader, ','));
+			return _EgspNewLine(pLoader);
+		}
+		return EGSP_SUCCESS;
+	default:
+		return first == '[' || first == '{' ? _EgspNewLine(pLoader) : EGSP_SUCCESS;
+	}
+}
 
-		switch (pLoader->last)
+EgspResult _EgspWriteString(EgspLoader* pLoader, const char* pString)
+{
+	while (*pString)
+	{
+		// Anything between the brackets, colons and commas is copied as it is
+		size_t run = strcspn(pString, "{}[]:,");
+		if (run)
 		{
-		case '{':
-		case '[':
-			++pLoader->indent;
-			EGSP_TRY(_EgspNewLine(pLoader));
-			break;
-		case ',':
-			if (cur != ']' && cur != '}')
-			{
-				EGSP_TRY(_EgspWriteChar(pLoader, pLoader->last));
-				EGSP_TRY(_EgspNewLine(pLoader));
-			}
-			break;
-		default:
-			if (cur == '[' || cur == '{')
-			{
-				EGSP_TRY(_EgspNewLine(pLoader));
-			}
+			EGSP_TRY(_EgspBeforeToken(pLoader, *pString));
+			EGSP_TRY(_EgspSaveBytes(pLoader, pString, run));
+			pLoader->last = pString[run - 1];
+			pString += run;
+			continue;
 		}
 
+		char cur = *pString++;
+		EGSP_TRY(_EgspBeforeToken(pLoader, cur));
 		switch (cur)
 		{
-		case '{':
-		case '[':
-			EGSP_TRY(_EgspWriteChar(pLoader, cur));
-			break;
 		case '}':
 		case ']':
 			--pLoader->indent;
@@ -317,8 +862,7 @@ EgspResult _EgspWriteString(EgspLoader* pLoader, const char* pString)
 			EGSP_TRY(_EgspWriteChar(pLoader, cur));
 			break;
 		case ':':
-			EGSP_TRY(_EgspWriteChar(pLoader, ':'));
-			EGSP_TRY(_EgspWriteChar(pLoader, ' '));
+			EGSP_TRY(_EgspSaveBytes(pLoader, ": ", pLoader->flags & EGSP_FLAG_COMPACT ? 1 : 2));
 			break;
 		case ',':
 			break;
@@ -330,345 +874,1280 @@ EgspResult _EgspWriteString(EgspLoader* pLoader, const char* pString)
 	return EGSP_SUCCESS;
 }
 
-static EgspResult _EgspReadChar(EgspLoader* pLoader, size_t* pPos, char** pChar, char chr)
+// The generated code knows the length of each label, colon included
+EgspResult _EgspWriteLabel(EgspLoader* pLoader, const char* pLabel, size_t length)
 {
-	if (*pPos >= ALIGN_BYTES)
+	EGSP_TRY(_EgspBeforeToken(pLoader, pLabel[0]));
+	EGSP_TRY(_EgspSaveBytes(pLoader, pLabel, length));
+	if (!(pLoader->flags & EGSP_FLAG_COMPACT))
 	{
-		EGSP_TEST(*pChar = EgspAlloc(pLoader, ALIGN_BYTES));
-		*pPos = 0;
+		EGSP_TRY(_EgspWriteChar(pLoader, ' '));
 	}
-	(*pChar)[(*pPos)++] = chr;
+	pLoader->last = ':';
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspGetField(EgspLoader* pLoader, char* buffer)
+static unsigned _EgspFirstBit(uint32_t mask)
 {
-	char chr = '\0';
-	size_t pos = 0;
-	while (chr != ',' && chr != '}' && chr != ']')
-	{
-		EGSP_TRY(CheckOverFlow(pLoader));
-		chr = pLoader->pData[pLoader->offset++];
-		buffer[pos++] = chr;
-	}
-	buffer[pos] = '\0';
-	return EGSP_SUCCESS;
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return (unsigned)index;
+#else
+	return (unsigned)__builtin_ctz(mask);
+#endif
 }
 
-EgspResult _EgspPrintuint64_t(EgspLoader* pLoader, uint64_t* pVal)
+// Index of the first a, b or c in the size bytes at pData, or size when there is none.
+// Compares a whole vector at a time and picks the first hit out of the mask.
+static size_t _EgspFindAny(const uint8_t* pData, size_t size, char a, char b, char c)
 {
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	sprintf(buffer, "%llu,", (unsigned long long)*pVal);
-	return _EgspWriteString(pLoader, buffer);
+	size_t i = 0;
+#if defined(__AVX2__)
+	__m256i a256 = _mm256_set1_epi8(a);
+	__m256i b256 = _mm256_set1_epi8(b);
+	__m256i c256 = _mm256_set1_epi8(c);
+	for (; i + 32 <= size; i += 32)
+	{
+		__m256i val = _mm256_loadu_si256((const __m256i*)(pData + i));
+		__m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(val, a256), _mm256_or_si256(_mm256_cmpeq_epi8(val, b256), _mm256_cmpeq_epi8(val, c256)));
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+		if (mask)
+		{
+			return i + _EgspFirstBit(mask);
+		}
+	}
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+	__m128i a128 = _mm_set1_epi8(a);
+	__m128i b128 = _mm_set1_epi8(b);
+	__m128i c128 = _mm_set1_epi8(c);
+	for (; i + 16 <= size; i += 16)
+	{
+		__m128i val = _mm_loadu_si128((const __m128i*)(pData + i));
+		__m128i hit = _mm_or_si128(_mm_cmpeq_epi8(val, a128), _mm_or_si128(_mm_cmpeq_epi8(val, b128), _mm_cmpeq_epi8(val, c128)));
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(hit);
+		if (mask)
+		{
+			return i + _EgspFirstBit(mask);
+		}
+	}
+#endif
+	for (; i < size; ++i)
+	{
+		if (pData[i] == (uint8_t)a || pData[i] == (uint8_t)b || pData[i] == (uint8_t)c)
+		{
+			return i;
+		}
+	}
+	return size;
 }
 
-EgspResult _EgspReaduint64_t(EgspLoader* pLoader, uint64_t* pVal)
+// Moves past the first a, b or c, looking through as much of each block as there is at once. What is
+// passed over, the stop included, goes to pCopy when there is one, which fails if it does not fit.
+static EgspResult _EgspScanPast(EgspLoader* pLoader, char a, char b, char c, char* pCopy, size_t copySize)
 {
-	long long val = 0;
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	EGSP_TRY(_EgspGetField(pLoader, buffer));
-	sscanf(buffer, "%llu", &val);
-	*pVal = val;
-	return EGSP_SUCCESS;
+	size_t copied = 0;
+	while (1)
+	{
+		size_t run = _EgspAvailable(pLoader);
+		if (run == 0)
+		{
+			EGSP_TRY(_EgspCheckOverFlow(pLoader));
+			run = _EgspAvailable(pLoader) ? _EgspAvailable(pLoader) : 1;
+		}
+		const uint8_t* pSrc = pLoader->pData + pLoader->offset;
+		size_t found = _EgspFindAny(pSrc, run, a, b, c);
+		size_t used = found < run ? found + 1 : run;
+		if (pCopy)
+		{
+			EGSP_TEST(copied + used < copySize);
+			memcpy(pCopy + copied, pSrc, used);
+			copied += used;
+			pCopy[copied] = '\0';
+		}
+		pLoader->offset += used;
+		if (found < run)
+		{
+			return EGSP_SUCCESS;
+		}
+	}
 }
 
-EgspResult _EgspPrintint64_t(EgspLoader* pLoader, int64_t* pVal)
+static EgspResult _EgspSkipPast(EgspLoader* pLoader, char end)
 {
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	sprintf(buffer, "%lld,", (long long)*pVal);
-	return _EgspWriteString(pLoader, buffer);
+	return _EgspScanPast(pLoader, end, end, end, 0, 0);
 }
 
-EgspResult _EgspReadint64_t(EgspLoader* pLoader, int64_t* pVal)
+EgspResult _EgspGetField(EgspLoader* pLoader, char* buffer)
 {
-	long long val = 0;
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	EGSP_TRY(_EgspGetField(pLoader, buffer));
-	sscanf(buffer, "%lld", &val);
-	*pVal = val;
+	return _EgspScanPast(pLoader, ',', '}', ']', buffer, EGSP_NUMERIC_BUFFER_LENGTH);
+}
+
+// Every value is followed by a comma, held back until it is known not to be the last
+EgspResult _EgspWriteNumber(EgspLoader* pLoader, const char* pText, size_t length)
+{
+	EGSP_TRY(_EgspBeforeToken(pLoader, pText[0]));
+	EGSP_TRY(_EgspSaveBytes(pLoader, pText, length));
+	pLoader->last = ',';
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspPrintdouble(EgspLoader* pLoader, double* pVal)
+// A number field, counted as kind
+static EgspResult _EgspGetNumber(EgspLoader* pLoader, char* buffer, EgspKind kind)
 {
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	sprintf(buffer, "%f,", *pVal);
-	return _EgspWriteString(pLoader, buffer);
+	(void)kind;
+	EGSP_COUNTED(kind, 1, _EgspGetField(pLoader, buffer));
 }
 
-EgspResult _EgspReaddouble(EgspLoader* pLoader, double* pVal)
+static EgspResult _EgspReadUnsigned(EgspLoader* pLoader, uint64_t* pVal, uint64_t max)
 {
-	double val = 0;
 	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	EGSP_TRY(_EgspGetField(pLoader, buffer));
-	sscanf(buffer, "%lf", &val);
-	*pVal = val;
+	EGSP_TRY(_EgspGetNumber(pLoader, buffer, EGSP_KIND_UNSIGNED));
+	EGSP_TEST(EgspTextToUint64(buffer, pVal) && *pVal <= max);
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspPrintuint32_t(EgspLoader* pLoader, uint32_t* pVal)
+static EgspResult _EgspReadSigned(EgspLoader* pLoader, int64_t* pVal, int64_t min, int64_t max)
 {
 	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	sprintf(buffer, "%u,", *pVal);
-	return _EgspWriteString(pLoader, buffer);
+	EGSP_TRY(_EgspGetNumber(pLoader, buffer, EGSP_KIND_SIGNED));
+	EGSP_TEST(EgspTextToInt64(buffer, pVal) && *pVal >= min && *pVal <= max);
+	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspReaduint32_t(EgspLoader* pLoader, uint32_t* pVal)
+EgspResult _EgspReaduint64_t(EgspLoader* pLoader, uint64_t* pVal)
 {
-	unsigned int val = 0;
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	EGSP_TRY(_EgspGetField(pLoader, buffer));
-	sscanf(buffer, "%u", &val);
-	*pVal = val;
-	return EGSP_SUCCESS;
+	return _EgspReadUnsigned(pLoader, pVal, UINT64_MAX);
 }
 
-EgspResult _EgspPrintint32_t(EgspLoader* pLoader, int32_t* pVal)
+EgspResult _EgspReadint64_t(EgspLoader* pLoader, int64_t* pVal)
 {
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	sprintf(buffer, "%d,", *pVal);
-	return _EgspWriteString(pLoader, buffer);
+	return _EgspReadSigned(pLoader, pVal, INT64_MIN, INT64_MAX);
 }
 
-EgspResult _EgspReadint32_t(EgspLoader* pLoader, int32_t* pVal)
+EgspResult _EgspReaddouble(EgspLoader* pLoader, double* pVal)
 {
-	int val = 0;
 	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	EGSP_TRY(_EgspGetField(pLoader, buffer));
-	sscanf(buffer, "%d", &val);
-	*pVal = val;
+	EGSP_TRY(_EgspGetNumber(pLoader, buffer, EGSP_KIND_FLOAT));
+	EGSP_TEST(EgspTextToDouble(buffer, pVal));
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspPrintfloat(EgspLoader* pLoader, float* pVal)
+EgspResult _EgspReaduint32_t(EgspLoader* pLoader, uint32_t* pVal)
 {
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	sprintf(buffer, "%f,", *pVal);
-	return _EgspWriteString(pLoader, buffer);
+	uint64_t val = 0;
+	EGSP_TRY(_EgspReadUnsigned(pLoader, &val, UINT32_MAX));
+	*pVal = (uint32_t)val;
+	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspReadfloat(EgspLoader* pLoader, float* pVal)
+EgspResult _EgspReadint32_t(EgspLoader* pLoader, int32_t* pVal)
 {
-	float val = 0;
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	EGSP_TRY(_EgspGetField(pLoader, buffer));
-	sscanf(buffer, "%f", &val);
-	*pVal = val;
+	int64_t val = 0;
+	EGSP_TRY(_EgspReadSigned(pLoader, &val, INT32_MIN, INT32_MAX));
+	*pVal = (int32_t)val;
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspPrintuint16_t(EgspLoader* pLoader, uint16_t* pVal)
+EgspResult _EgspReadfloat(EgspLoader* pLoader, float* pVal)
 {
 	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	sprintf(buffer, "%u,", *pVal);
-	return _EgspWriteString(pLoader, buffer);
+	EGSP_TRY(_EgspGetNumber(pLoader, buffer, EGSP_KIND_FLOAT));
+	EGSP_TEST(EgspTextToFloat(buffer, pVal));
+	return EGSP_SUCCESS;
 }
 
 EgspResult _EgspReaduint16_t(EgspLoader* pLoader, uint16_t* pVal)
 {
-	unsigned int val = 0;
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	EGSP_TRY(_EgspGetField(pLoader, buffer));
-	sscanf(buffer, "%u", &val);
+	uint64_t val = 0;
+	EGSP_TRY(_EgspReadUnsigned(pLoader, &val, UINT16_MAX));
 	*pVal = (uint16_t)val;
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspPrintint16_t(EgspLoader* pLoader, int16_t* pVal)
-{
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	sprintf(buffer, "%d,", *pVal);
-	return _EgspWriteString(pLoader, buffer);
-}
-
 EgspResult _EgspReadint16_t(EgspLoader* pLoader, int16_t* pVal)
 {
-	int val = 0;
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	EGSP_TRY(_EgspGetField(pLoader, buffer));
-	sscanf(buffer, "%d", &val);
+	int64_t val = 0;
+	EGSP_TRY(_EgspReadSigned(pLoader, &val, INT16_MIN, INT16_MAX));
 	*pVal = (int16_t)val;
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspPrintuint8_t(EgspLoader* pLoader, uint8_t* pVal)
-{
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	sprintf(buffer, "%u,", *pVal);
-	return _EgspWriteString(pLoader, buffer);
-}
-
 EgspResult _EgspReaduint8_t(EgspLoader* pLoader, uint8_t* pVal)
 {
-	unsigned int val = 0;
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	EGSP_TRY(_EgspGetField(pLoader, buffer));
-	sscanf(buffer, "%u", &val);
+	uint64_t val = 0;
+	EGSP_TRY(_EgspReadUnsigned(pLoader, &val, UINT8_MAX));
 	*pVal = (uint8_t)val;
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspPrintint8_t(EgspLoader* pLoader, int8_t* pVal)
-{
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	sprintf(buffer, "%d,", *pVal);
-	return _EgspWriteString(pLoader, buffer);
-}
-
 EgspResult _EgspReadint8_t(EgspLoader* pLoader, int8_t* pVal)
 {
-	int val = 0;
-	char buffer[EGSP_NUMERIC_BUFFER_LENGTH];
-	EGSP_TRY(_EgspGetField(pLoader, buffer));
-	sscanf(buffer, "%d", &val);
+	int64_t val = 0;
+	EGSP_TRY(_EgspReadSigned(pLoader, &val, INT8_MIN, INT8_MAX));
 	*pVal = (int8_t)val;
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspPrintstring(EgspLoader* pLoader, const char** ppString)
+// Index of the first character in the size bytes at pData that is escaped when printed, or size when there is none:
+// a quote, a backslash, a slash or a control character. Compares a whole vector at a time like _EgspFindAny.
+static size_t _EgspFindEscape(const uint8_t* pData, size_t size)
 {
-	uint32_t length = (uint32_t)strlen(*ppString);
-	pLoader->heapSize += EgspPad(length + 1);
+	size_t i = 0;
+#if defined(__AVX2__)
+	__m256i quote256 = _mm256_set1_epi8('"');
+	__m256i backslash256 = _mm256_set1_epi8('\\');
+	__m256i slash256 = _mm256_set1_epi8('/');
+	__m256i control256 = _mm256_set1_epi8(0x1F);
+	for (; i + 32 <= size; i += 32)
+	{
+		__m256i val = _mm256_loadu_si256((const __m256i*)(pData + i));
+		__m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(val, quote256), _mm256_cmpeq_epi8(val, backslash256));
+		hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(val, slash256));
+		hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(_mm256_min_epu8(val, control256), val));
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+		if (mask)
+		{
+			return i + _EgspFirstBit(mask);
+		}
+	}
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+	__m128i quote128 = _mm_set1_epi8('"');
+	__m128i backslash128 = _mm_set1_epi8('\\');
+	__m128i slash128 = _mm_set1_epi8('/');
+	__m128i control128 = _mm_set1_epi8(0x1F);
+	for (; i + 16 <= size; i += 16)
+	{
+		__m128i val = _mm_loadu_si128((const __m128i*)(pData + i));
+		__m128i hit = _mm_or_si128(_mm_cmpeq_epi8(val, quote128), _mm_cmpeq_epi8(val, backslash128));
+		hit = _mm_or_si128(hit, _mm_cmpeq_epi8(val, slash128));
+		// Unsigned at most 0x1F, as SSE2 only compares signed bytes
+		hit = _mm_or_si128(hit, _mm_cmpeq_epi8(_mm_min_epu8(val, control128), val));
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(hit);
+		if (mask)
+		{
+			return i + _EgspFirstBit(mask);
+		}
+	}
+#endif
+	for (; i < size; ++i)
+	{
+		if (pData[i] == '"' || pData[i] == '\\' || pData[i] == '/' || pData[i] <= 0x1F)
+		{
+			return i;
+		}
+	}
+	return size;
+}
+
+static EgspResult _EgspPrintText(EgspLoader* pLoader, const char** ppString)
+{
+	size_t length = strlen(*ppString);
+	const uint8_t* pChr = (const uint8_t*)*ppString;
+	const uint8_t* pEnd = pChr + length;
+	pLoader->heapSize += _EgspPad(pLoader, length + 1);
+	EGSP_TRY(_EgspBeforeToken(pLoader, '"'));
 	EGSP_TRY(_EgspWriteChar(pLoader, '"'));
-	for (const char* pChr = *ppString; *pChr != '\0'; ++pChr)
+	while (1)
 	{
-		// List from http://json.org/. Unicode(\u) not supported.
-		switch (*pChr)
+		// Everything up to the next character that needs escaping goes in as it is
+		size_t run = _EgspFindEscape(pChr, (size_t)(pEnd - pChr));
+		EGSP_TRY(_EgspSaveBytes(pLoader, pChr, run));
+		pChr += run;
+		if (pChr == pEnd)
 		{
-		case '"':
-			EGSP_TRY(_EgspWriteChar(pLoader, '\\'));
-			EGSP_TRY(_EgspWriteChar(pLoader, '"'));
 			break;
+		}
+
+		// List from http://json.org/. Unicode(\u) not supported, so other control characters go in as they are.
+		char escape[2] = { '\\', (char)*pChr };
+		switch (*pChr++)
+		{
 		case '\n':
-			EGSP_TRY(_EgspWriteChar(pLoader, '\\'));
-			EGSP_TRY(_EgspWriteChar(pLoader, 'n'));
+			escape[1] = 'n';
 			break;
 		case '\r':
-			EGSP_TRY(_EgspWriteChar(pLoader, '\\'));
-			EGSP_TRY(_EgspWriteChar(pLoader, 'r'));
+			escape[1] = 'r';
 			break;
 		case '\t':
-			EGSP_TRY(_EgspWriteChar(pLoader, '\\'));
-			EGSP_TRY(_EgspWriteChar(pLoader, 't'));
+			escape[1] = 't';
 			break;
 		case '\b':
-			EGSP_TRY(_EgspWriteChar(pLoader, '\\'));
-			EGSP_TRY(_EgspWriteChar(pLoader, 'b'));
+			escape[1] = 'b';
 			break;
-		case '\\':
-			EGSP_TRY(_EgspWriteChar(pLoader, '\\'));
-			EGSP_TRY(_EgspWriteChar(pLoader, '\\'));
+		case '\f':
+			escape[1] = 'f';
 			break;
+		case '"':
+		case '\\':
 		case '/':
-			EGSP_TRY(_EgspWriteChar(pLoader, '\\'));
-			EGSP_TRY(_EgspWriteChar(pLoader, '/'));
-			break;
-		case '\f':
-			EGSP_TRY(_EgspWriteChar(pLoader, '\\'));
-			EGSP_TRY(_EgspWriteChar(pLoader, 'f'));
 			break;
 		default:
-			EGSP_TRY(_EgspWriteChar(pLoader, *pChr));
+			EGSP_TRY(_EgspWriteChar(pLoader, escape[1]));
+			continue;
 		}
+		EGSP_TRY(_EgspSaveBytes(pLoader, escape, 2));
 	}
 	EGSP_TRY(_EgspWriteChar(pLoader, '"'));
 	EGSP_TRY(_EgspWriteString(pLoader, ","));
 	return EGSP_SUCCESS;
 }
 
-// Pretty sure this is some sort of interview question
-static void _EgspReverseBlocks(uint8_t* pFirst, uint8_t* pLast)
+// Whether the string starting at pSrc ends within size bytes, and how long it is once unescaped
+static int _EgspMeasureEscaped(const uint8_t* pSrc, size_t size, size_t* pLength)
 {
-	while (pFirst < pLast)
+	size_t escapes = 0;
+	size_t pos = 0;
+	while (1)
 	{
-		for (size_t i = 0; i < ALIGN_BYTES; ++i)
+		pos += _EgspFindAny(pSrc + pos, size - pos, '"', '\\', '"');
+		if (pos >= size || (pSrc[pos] == '\\' && pos + 1 >= size))
+		{
+			return 0;
+		}
+		if (pSrc[pos] == '"')
 		{
-			char tmp = pFirst[i];
-			pFirst[i] = pLast[i];
-			pLast[i] = tmp;
+			*pLength = pos - escapes;
+			return 1;
 		}
-		pFirst += ALIGN_BYTES;
-		pLast -= ALIGN_BYTES;
+		++escapes;
+		pos += 2;
 	}
 }
 
+// Decodes a string up to its closing quote into pDst, copying the runs between escapes as they are
+static EgspResult _EgspUnescape(EgspLoader* pLoader, char* pDst, size_t capacity, size_t* pLength)
+{
+	size_t length = 0;
+	while (1)
+	{
+		size_t run = _EgspAvailable(pLoader);
+		if (run == 0)
+		{
+			EGSP_TRY(_EgspCheckOverFlow(pLoader));
+			run = _EgspAvailable(pLoader) ? _EgspAvailable(pLoader) : 1;
+		}
+		const uint8_t* pSrc = pLoader->pData + pLoader->offset;
+		size_t found = _EgspFindAny(pSrc, run, '"', '\\', '"');
+		EGSP_TEST(length + found < capacity);
+		memcpy(pDst + length, pSrc, found);
+		length += found;
+		if (found == run)
+		{
+			pLoader->offset += run;
+			continue;
+		}
+		pLoader->offset += found + 1;
+		if (pSrc[found] == '"')
+		{
+			pDst[length] = '\0';
+			*pLength = length;
+			return EGSP_SUCCESS;
+		}
+
+		EGSP_TRY(_EgspCheckOverFlow(pLoader));
+		EGSP_TEST(length + 1 < capacity);
+		// List from http://json.org/. Unicode(\u) not supported.
+		switch (pLoader->pData[pLoader->offset++])
+		{
+		case '"':
+			pDst[length++] = '"';
+			break;
+		case 'n':
+			pDst[length++] = '\n';
+			break;
+		case 'r':
+			pDst[length++] = '\r';
+			break;
+		case 't':
+			pDst[length++] = '\t';
+			break;
+		case 'b':
+			pDst[length++] = '\b';
+			break;
+		case '\\':
+			pDst[length++] = '\\';
+			break;
+		case '/':
+			pDst[length++] = '/';
+			break;
+		case 'f':
+			pDst[length++] = '\f';
+			break;
+		default:
+			return EGSP_FAIL;
+		}
+	}
+}
+
+static EgspResult _EgspReadText(EgspLoader* pLoader, const char** ppString)
+{
+	char* pString = 0;
+	size_t length = 0;
+	EGSP_TRY(_EgspSkipPast(pLoader, '"'));
+
+	// Usually the whole string is in this block, so its size is known before anything is copied
+	if (_EgspMeasureEscaped(pLoader->pData + pLoader->offset, _EgspAvailable(pLoader), &length))
+	{
+		EGSP_TEST(pString = EgspAlloc(pLoader, length + 1));
+		EGSP_TRY(_EgspUnescape(pLoader, pString, length + 1, &length));
+		*ppString = pString;
+		return EGSP_SUCCESS;
+	}
+
+	// Otherwise it is decoded to the bottom of the heap, which is free, and moved up once its size is known
+	char* pStage = (char*)pLoader->pHeap;
+	EGSP_TRY(_EgspUnescape(pLoader, pStage, pLoader->heapSize, &length));
+	EGSP_TEST(pString = EgspAlloc(pLoader, length + 1));
+	memmove(pString, pStage, length + 1);
+	*ppString = pString;
+	return EGSP_SUCCESS;
+}
+
+EgspResult _EgspPrintstring(EgspLoader* pLoader, const char** ppString)
+{
+	EGSP_COUNTED(EGSP_KIND_STRING, 1, _EgspPrintText(pLoader, ppString));
+}
+
 EgspResult _EgspReadstring(EgspLoader* pLoader, const char** ppString)
 {
-	char chr = '\0';
-	char* pBuffer = 0;
-	while (chr != '"')
+	EGSP_COUNTED(EGSP_KIND_STRING, 1, _EgspReadText(pLoader, ppString));
+}
+
+EgspResult _EgspSkipLabel(EgspLoader* pLoader)
+{
+	return _EgspSkipPast(pLoader, ':');
+}
+
+EgspResult _EgspSkipList(EgspLoader* pLoader)
+{
+	return _EgspSkipPast(pLoader, '[');
+}
+
+#endif
+
+// Table driven
+// Picks the primitive of the number field's kind and width, for the number fields that cannot go straight
+// to the block. CALL gets the type the generated code would use and casts pVal to it.
+#define EGSP_NUMBER_SWITCH(CALL) \
+	switch (pField->kind * 16 + pField->size) \
+	{ \
+	case EGSP_KIND_UNSIGNED * 16 + 1: CALL(uint8_t); \
+	case EGSP_KIND_UNSIGNED * 16 + 2: CALL(uint16_t); \
+	case EGSP_KIND_UNSIGNED * 16 + 4: CALL(uint32_t); \
+	case EGSP_KIND_UNSIGNED * 16 + 8: CALL(uint64_t); \
+	case EGSP_KIND_SIGNED * 16 + 1: CALL(int8_t); \
+	case EGSP_KIND_SIGNED * 16 + 2: CALL(int16_t); \
+	case EGSP_KIND_SIGNED * 16 + 4: CALL(int32_t); \
+	case EGSP_KIND_SIGNED * 16 + 8: CALL(int64_t); \
+	case EGSP_KIND_FLOAT * 16 + 4: CALL(float); \
+	case EGSP_KIND_FLOAT * 16 + 8: CALL(double); \
+	}
+
+#define EGSP_LOAD_NUMBER(TYPE) return _EgspLoad##TYPE(pLoader, (TYPE*)pVal)
+#define EGSP_SAVE_NUMBER(TYPE) return _EgspSave##TYPE(pLoader, (TYPE*)pVal)
+#define EGSP_MEASURE_NUMBER(TYPE) _EgspMeasure##TYPE(pLoader, (TYPE*)pVal); break
+
+static int _EgspIsNumber(EgspKind kind)
+{
+	return kind == EGSP_KIND_UNSIGNED || kind == EGSP_KIND_SIGNED || kind == EGSP_KIND_FLOAT;
+}
+
+// Enums are stored as int32_t whatever their size in memory
+static int32_t _EgspGetEnum(const void* pVal, size_t size)
+{
+	switch (size)
+	{
+	case 1: { int8_t v; memcpy(&v, pVal, 1); return v; }
+	case 2: { int16_t v; memcpy(&v, pVal, 2); return v; }
+	case 8: { int64_t v; memcpy(&v, pVal, 8); return (int32_t)v; }
+	default: { int32_t v; memcpy(&v, pVal, 4); return v; }
+	}
+}
+
+static void _EgspSetEnum(void* pVal, size_t size, int32_t val)
+{
+	switch (size)
 	{
-		EGSP_TRY(CheckOverFlow(pLoader));
-		chr = pLoader->pData[pLoader->offset++];
+	case 1: { int8_t v = (int8_t)val; memcpy(pVal, &v, 1); break; }
+	case 2: { int16_t v = (int16_t)val; memcpy(pVal, &v, 2); break; }
+	case 8: { int64_t v = val; memcpy(pVal, &v, 8); break; }
+	default: memcpy(pVal, &val, 4);
 	}
+}
 
-	// Bookmark this spot. Allocations happen in reverse order.
-	uint8_t* pFirst = (uint8_t*)pLoader->pHeap + pLoader->heapSize - ALIGN_BYTES;
-	size_t pos = ALIGN_BYTES;
-	chr = '\0';
-	while (1)
+static size_t _EgspCount(const void* pVal, const EgspField* pField)
+{
+	const uint8_t* pCount = (const uint8_t*)pVal + pField->countOffset;
+	switch (pField->countSize)
+	{
+	case 1: return *pCount;
+	case 2: { uint16_t v; memcpy(&v, pCount, 2); return v; }
+	case 8: { uint64_t v; memcpy(&v, pCount, 8); return (size_t)v; }
+	default: { uint32_t v; memcpy(&v, pCount, 4); return v; }
+	}
+}
+
+// Heap taken by an array, padded as a whole for numbers and element by element for everything else
+static size_t _EgspArrayBytes(EgspLoader* pLoader, const EgspField* pField, size_t count)
+{
+	return _EgspIsNumber(pField->kind) ? _EgspPad(pLoader, pField->size * count) : _EgspPad(pLoader, pField->size) * count;
+}
+
+static void* _EgspGetPointer(const void* pMember)
+{
+	void* pItem;
+	memcpy(&pItem, pMember, sizeof(pItem));
+	return pItem;
+}
+
+static void _EgspSetPointer(void* pMember, void* pItem)
+{
+	memcpy(pMember, &pItem, sizeof(pItem));
+}
+
+static EgspResult _EgspLoadStruct(EgspLoader* pLoader, const EgspStructInfo* pStruct, void* pVal);
+static EgspResult _EgspSaveStruct(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal);
+static void _EgspMeasureStruct(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal);
+
+// Consecutive fixed width fields from pField on, nested structs made only of them included, which go straight to the
+// block in one run when it has room for all of them like the runs of the generated code.
+// Returns how many there are and the bytes they take.
+static size_t _EgspRunFields(const EgspField* pField, const EgspField* pEnd, size_t* pBytes)
+{
+	size_t fields = 0;
+	*pBytes = 0;
+	for (; pField < pEnd && pField->shape == EGSP_SHAPE_VALUE; ++pField, ++fields)
 	{
-		EGSP_TRY(CheckOverFlow(pLoader));
-		chr = pLoader->pData[pLoader->offset++];
-		if (chr == '"')
+		if (_EgspIsNumber(pField->kind))
+		{
+			*pBytes += pField->size;
+		}
+		else if (pField->kind == EGSP_KIND_ENUM)
+		{
+			*pBytes += sizeof(int32_t);
+		}
+		else if (pField->pStruct && pField->pStruct->fixedSize)
+		{
+			*pBytes += pField->pStruct->fixedSize;
+		}
+		else
 		{
 			break;
 		}
-		else if (chr == '\\')
+	}
+	return fields;
+}
+
+static size_t _EgspGetRunField(const uint8_t* pRun, const EgspField* pField, void* pVal);
+static size_t _EgspPutRunField(uint8_t* pRun, const EgspField* pField, const void* pVal);
+
+// A fixed width struct in a run, raw ones copied whole
+static size_t _EgspGetRunStruct(const uint8_t* pRun, const EgspStructInfo* pStruct, void* pVal)
+{
+	if (pStruct->pLayout)
+	{
+		memcpy(pVal, pRun, pStruct->size);
+		_EgspFixRaw(pVal, 1, pStruct->pLayout);
+		return pStruct->size;
+	}
+	const uint8_t* pStart = pRun;
+	for (const EgspField* pField = pStruct->pFields; pField < pStruct->pFields + pStruct->fieldCount; ++pField)
+	{
+		pRun += _EgspGetRunField(pRun, pField, (uint8_t*)pVal + pField->offset);
+	}
+	return pRun - pStart;
+}
+
+static size_t _EgspPutRunStruct(uint8_t* pRun, const EgspStructInfo* pStruct, const void* pVal)
+{
+	if (pStruct->pLayout)
+	{
+		memcpy(pRun, pVal, pStruct->size);
+		_EgspFixRaw(pRun, 1, pStruct->pLayout);
+		return pStruct->size;
+	}
+	uint8_t* pStart = pRun;
+	for (const EgspField* pField = pStruct->pFields; pField < pStruct->pFields + pStruct->fieldCount; ++pField)
+	{
+		pRun += _EgspPutRunField(pRun, pField, (const uint8_t*)pVal + pField->offset);
+	}
+	return pRun - pStart;
+}
+
+// One field of a run, returning the bytes it took
+static size_t _EgspGetRunField(const uint8_t* pRun, const EgspField* pField, void* pVal)
+{
+	if (pField->pStruct)
+	{
+		return _EgspGetRunStruct(pRun, pField->pStruct, pVal);
+	}
+	if (pField->kind == EGSP_KIND_ENUM)
+	{
+		_EgspSetEnum(pVal, pField->size, (int32_t)_EgspBig32(pRun));
+		return sizeof(int32_t);
+	}
+	switch (pField->size)
+	{
+	case 1: *(uint8_t*)pVal = *pRun; break;
+	case 2: { uint16_t v = _EgspBig16(pRun); memcpy(pVal, &v, 2); break; }
+	case 4: { uint32_t v = _EgspBig32(pRun); memcpy(pVal, &v, 4); break; }
+	default: { uint64_t v = _EgspBig64(pRun); memcpy(pVal, &v, 8); }
+	}
+	return pField->size;
+}
+
+static size_t _EgspPutRunField(uint8_t* pRun, const EgspField* pField, const void* pVal)
+{
+	if (pField->pStruct)
+	{
+		return _EgspPutRunStruct(pRun, pField->pStruct, pVal);
+	}
+	if (pField->kind == EGSP_KIND_ENUM)
+	{
+		_EgspPutBig32(pRun, (uint32_t)_EgspGetEnum(pVal, pField->size));
+		return sizeof(int32_t);
+	}
+	switch (pField->size)
+	{
+	case 1: *pRun = *(const uint8_t*)pVal; break;
+	case 2: { uint16_t v; memcpy(&v, pVal, 2); _EgspPutBig16(pRun, v); break; }
+	case 4: { uint32_t v; memcpy(&v, pVal, 4); _EgspPutBig32(pRun, v); break; }
+	default: { uint64_t v; memcpy(&v, pVal, 8); _EgspPutBig64(pRun, v); }
+	}
+	return pField->size;
+}
+
+// Fixed width numbers go straight to the block when they fit, like a run of one
+static EgspResult _EgspLoadNumber(EgspLoader* pLoader, const EgspField* pField, void* pVal)
+{
+	uint8_t* pRun = _EgspRun(pLoader, pField->size);
+	if (!pRun)
+	{
+		EGSP_NUMBER_SWITCH(EGSP_LOAD_NUMBER)
+		return EGSP_FAIL;
+	}
+	_EgspGetRunField(pRun, pField, pVal);
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspSaveNumber(EgspLoader* pLoader, const EgspField* pField, const void* pVal)
+{
+	uint8_t* pRun = _EgspRun(pLoader, pField->size);
+	if (!pRun)
+	{
+		EGSP_NUMBER_SWITCH(EGSP_SAVE_NUMBER)
+		return EGSP_FAIL;
+	}
+	_EgspPutRunField(pRun, pField, pVal);
+	return EGSP_SUCCESS;
+}
+
+// A single value of the field's kind at pVal, be it the field itself, what it points at or an array element
+static EgspResult _EgspLoadValue(EgspLoader* pLoader, const EgspField* pField, void* pVal)
+{
+	switch (pField->kind)
+	{
+	case EGSP_KIND_UNSIGNED:
+	case EGSP_KIND_SIGNED:
+	case EGSP_KIND_FLOAT:
+		return _EgspLoadNumber(pLoader, pField, pVal);
+	case EGSP_KIND_STRING:
+		return _EgspLoadstring(pLoader, (const char**)pVal);
+	case EGSP_KIND_STRUCT:
+	case EGSP_KIND_RAW:
+		return _EgspLoadStruct(pLoader, pField->pStruct, pVal);
+	case EGSP_KIND_ENUM:
+	{
+		int32_t val = 0;
+		EGSP_TRY(_EgspLoadint32_t(pLoader, &val));
+		_EgspSetEnum(pVal, pField->size, val);
+		return EGSP_SUCCESS;
+	}
+	}
+	return EGSP_FAIL;
+}
+
+static EgspResult _EgspSaveValue(EgspLoader* pLoader, const EgspField* pField, const void* pVal)
+{
+	switch (pField->kind)
+	{
+	case EGSP_KIND_UNSIGNED:
+	case EGSP_KIND_SIGNED:
+	case EGSP_KIND_FLOAT:
+		return _EgspSaveNumber(pLoader, pField, pVal);
+	case EGSP_KIND_STRING:
+		return _EgspSavestring(pLoader, (const char**)pVal);
+	case EGSP_KIND_STRUCT:
+	case EGSP_KIND_RAW:
+		return _EgspSaveStruct(pLoader, pField->pStruct, pVal);
+	case EGSP_KIND_ENUM:
+	{
+		int32_t val = _EgspGetEnum(pVal, pField->size);
+		return _EgspSaveint32_t(pLoader, &val);
+	}
+	}
+	return EGSP_FAIL;
+}
+
+static void _EgspMeasureValue(EgspLoader* pLoader, const EgspField* pField, const void* pVal)
+{
+	switch (pField->kind)
+	{
+	case EGSP_KIND_UNSIGNED:
+	case EGSP_KIND_SIGNED:
+	case EGSP_KIND_FLOAT:
+		EGSP_NUMBER_SWITCH(EGSP_MEASURE_NUMBER)
+		break;
+	case EGSP_KIND_STRING:
+		_EgspMeasurestring(pLoader, (const char**)pVal);
+		break;
+	case EGSP_KIND_STRUCT:
+	case EGSP_KIND_RAW:
+		_EgspMeasureStruct(pLoader, pField->pStruct, pVal);
+		break;
+	case EGSP_KIND_ENUM:
+	{
+		int32_t val = _EgspGetEnum(pVal, pField->size);
+		_EgspMeasureint32_t(pLoader, &val);
+	}
+	}
+}
+
+static EgspResult _EgspLoadStruct(EgspLoader* pLoader, const EgspStructInfo* pStruct, void* pVal)
+{
+	EGSP_STATS_BEGIN
+	if (pStruct->pLayout)
+	{
+		EGSP_TRY(_EgspLoadRaw(pLoader, pVal, 1, pStruct->size, pStruct->pLayout));
+	}
+	const EgspField* pEnd = pStruct->pFields + pStruct->fieldCount;
+	for (const EgspField* pField = pStruct->pFields; pField < pEnd; ++pField)
+	{
+		uint8_t* pMember = (uint8_t*)pVal + pField->offset;
+		switch (pField->shape)
 		{
-			EGSP_TRY(CheckOverFlow(pLoader));
-			// List from http://json.org/. Unicode(\u) not supported.
-			switch (pLoader->pData[pLoader->offset++])
+		// Each field on its own when the run is not all in the block, like the slow path of the generated runs
+		case EGSP_SHAPE_VALUE:
+		{
+			size_t bytes;
+			const EgspField* pLast = pField + _EgspRunFields(pField, pEnd, &bytes) - 1;
+			uint8_t* pRun = pLast > pField ? _EgspRun(pLoader, bytes) : 0;
+			for (;; ++pField)
+			{
+				pMember = (uint8_t*)pVal + pField->offset;
+				if (pRun)
+				{
+					pRun += _EgspGetRunField(pRun, pField, pMember);
+				}
+				else
+				{
+					EGSP_TRY(_EgspLoadValue(pLoader, pField, pMember));
+				}
+				if (pField >= pLast)
+				{
+					break;
+				}
+			}
+			break;
+		}
+
+		case EGSP_SHAPE_POINTER:
+		{
+			uint8_t present = 0;
+			void* pItem = 0;
+			EGSP_TRY(_EgspLoaduint8_t(pLoader, &present));
+			if (present)
+			{
+				EGSP_TEST(pItem = EgspAlloc(pLoader, _EgspPad(pLoader, pField->size)));
+				EGSP_TRY(_EgspLoadValue(pLoader, pField, pItem));
+			}
+			_EgspSetPointer(pMember, pItem);
+			break;
+		}
+
+		case EGSP_SHAPE_ARRAY:
+		{
+			size_t count = _EgspCount(pVal, pField);
+			uint8_t* pItems = (uint8_t*)EgspAlloc(pLoader, _EgspArrayBytes(pLoader, pField, count));
+			_EgspSetPointer(pMember, pItems);
+			if (!pItems)
 			{
-			case '"':
-				EGSP_TRY(_EgspReadChar(pLoader, &pos, &pBuffer, '"'));
-				break;
-			case 'n':
-				EGSP_TRY(_EgspReadChar(pLoader, &pos, &pBuffer, '\n'));
-				break;
-			case 'r':
-				EGSP_TRY(_EgspReadChar(pLoader, &pos, &pBuffer, '\r'));
-				break;
-			case 't':
-				EGSP_TRY(_EgspReadChar(pLoader, &pos, &pBuffer, '\t'));
-				break;
-			case 'b':
-				EGSP_TRY(_EgspReadChar(pLoader, &pos, &pBuffer, '\b'));
-				break;
-			case '\\':
-				EGSP_TRY(_EgspReadChar(pLoader, &pos, &pBuffer, '\\'));
-				break;
-			case '/':
-				EGSP_TRY(_EgspReadChar(pLoader, &pos, &pBuffer, '/'));
-				break;
-			case 'f':
-				EGSP_TRY(_EgspReadChar(pLoader, &pos, &pBuffer, '\f'));
 				break;
-			default:
-				return EGSP_FAIL;
+			}
+			if (_EgspIsNumber(pField->kind))
+			{
+				EGSP_TRY(_EgspLoadArray(pLoader, pItems, count, pField->size, pField->kind));
+			}
+			else if (pField->kind == EGSP_KIND_RAW)
+			{
+				EGSP_TRY(_EgspLoadRaw(pLoader, pItems, count, pField->size, pField->pStruct->pLayout));
+			}
+			else
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					EGSP_TRY(_EgspLoadValue(pLoader, pField, pItems + i * pField->size));
+				}
 			}
 		}
-		else
+		}
+	}
+	EGSP_STATS_END(pStruct->index, pStruct->pName);
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspSaveStruct(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal)
+{
+	EGSP_STATS_BEGIN
+	if (pStruct->pLayout)
+	{
+		EGSP_TRY(_EgspSaveRaw(pLoader, pVal, 1, pStruct->size, pStruct->pLayout));
+	}
+	const EgspField* pEnd = pStruct->pFields + pStruct->fieldCount;
+	for (const EgspField* pField = pStruct->pFields; pField < pEnd; ++pField)
+	{
+		const uint8_t* pMember = (const uint8_t*)pVal + pField->offset;
+		switch (pField->shape)
 		{
-			EGSP_TRY(_EgspReadChar(pLoader, &pos, &pBuffer, chr));
+		// Each field on its own when the run is not all in the block, like the slow path of the generated runs
+		case EGSP_SHAPE_VALUE:
+		{
+			size_t bytes;
+			const EgspField* pLast = pField + _EgspRunFields(pField, pEnd, &bytes) - 1;
+			uint8_t* pRun = pLast > pField ? _EgspRun(pLoader, bytes) : 0;
+			for (;; ++pField)
+			{
+				pMember = (const uint8_t*)pVal + pField->offset;
+				if (pRun)
+				{
+					pRun += _EgspPutRunField(pRun, pField, pMember);
+				}
+				else
+				{
+					EGSP_TRY(_EgspSaveValue(pLoader, pField, pMember));
+				}
+				if (pField >= pLast)
+				{
+					break;
+				}
+			}
+			break;
+		}
+
+		case EGSP_SHAPE_POINTER:
+		{
+			void* pItem = _EgspGetPointer(pMember);
+			uint8_t present = pItem != 0;
+			if (pItem)
+			{
+				pLoader->heapSize += _EgspPad(pLoader, pField->size);
+			}
+			EGSP_TRY(_EgspSaveuint8_t(pLoader, &present));
+			if (pItem)
+			{
+				EGSP_TRY(_EgspSaveValue(pLoader, pField, pItem));
+			}
+			break;
+		}
+
+		// Arrays are always saved on this thread, the output being the same as from the pool
+		case EGSP_SHAPE_ARRAY:
+		{
+			size_t count = _EgspCount(pVal, pField);
+			const uint8_t* pItems = (const uint8_t*)_EgspGetPointer(pMember);
+			pLoader->heapSize += _EgspArrayBytes(pLoader, pField, count);
+			if (_EgspIsNumber(pField->kind))
+			{
+				EGSP_TRY(_EgspSaveArray(pLoader, pItems, count, pField->size, pField->kind));
+			}
+			else if (pField->kind == EGSP_KIND_RAW)
+			{
+				EGSP_TRY(_EgspSaveRaw(pLoader, pItems, count, pField->size, pField->pStruct->pLayout));
+			}
+			else
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					EGSP_TRY(_EgspSaveValue(pLoader, pField, pItems + i * pField->size));
+				}
+			}
+		}
 		}
 	}
-	EGSP_TRY(_EgspReadChar(pLoader, &pos, &pBuffer, '\0'));
-	_EgspReverseBlocks(pBuffer, pFirst);
-	*ppString = pBuffer;
+	EGSP_STATS_END(pStruct->index, pStruct->pName);
 	return EGSP_SUCCESS;
 }
 
-EgspResult _EgspSkipLabel(EgspLoader* pLoader)
+static void _EgspMeasureStruct(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal)
 {
-	char chr = '\0';
-	size_t pos = 0;
-	while (chr != ':')
+	if (pStruct->pLayout)
+	{
+		_EgspMeasureBytes(pLoader, pStruct->size);
+	}
+	for (const EgspField* pField = pStruct->pFields; pField < pStruct->pFields + pStruct->fieldCount; ++pField)
+	{
+		const uint8_t* pMember = (const uint8_t*)pVal + pField->offset;
+		switch (pField->shape)
+		{
+		case EGSP_SHAPE_VALUE:
+			_EgspMeasureValue(pLoader, pField, pMember);
+			break;
+
+		case EGSP_SHAPE_POINTER:
+		{
+			void* pItem = _EgspGetPointer(pMember);
+			_EgspMeasureBytes(pLoader, sizeof(uint8_t));
+			if (pItem)
+			{
+				pLoader->heapSize += _EgspPad(pLoader, pField->size);
+				_EgspMeasureValue(pLoader, pField, pItem);
+			}
+			break;
+		}
+
+		case EGSP_SHAPE_ARRAY:
+		{
+			size_t count = _EgspCount(pVal, pField);
+			const uint8_t* pItems = (const uint8_t*)_EgspGetPointer(pMember);
+			pLoader->heapSize += _EgspArrayBytes(pLoader, pField, count);
+			if (_EgspIsNumber(pField->kind))
+			{
+				_EgspMeasureArray(pLoader, pItems, count, pField->size, pField->kind);
+			}
+			else if (pField->kind == EGSP_KIND_RAW)
+			{
+				_EgspMeasureBytes(pLoader, pField->size * count);
+			}
+			else
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					_EgspMeasureValue(pLoader, pField, pItems + i * pField->size);
+				}
+			}
+		}
+		}
+	}
+}
+
+// The same entry points the generated code has for each struct
+EgspResult EgspLoadStructEx(EgspLoader* pLoader, const EgspStructInfo* pStruct, void* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, pStruct->schema));
+	return _EgspLoadStruct(pLoader, pStruct, pVal);
+}
+
+EgspResult EgspLoadStruct(const EgspStructInfo* pStruct, EgspFunc pLoadFunc, void* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadStructEx(&loader, pStruct, pVal, pHeap, heapSize);
+}
+
+EgspResult EgspLoadStructSpan(const EgspStructInfo* pStruct, const uint8_t* pData, size_t size, void* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadStructEx(&loader, pStruct, pVal, pHeap, heapSize);
+}
+
+size_t EgspMeasureStructEx(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureStruct(pLoader, pStruct, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+size_t EgspMeasureStruct(const EgspStructInfo* pStruct, const void* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureStructEx(&loader, pStruct, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+EgspResult EgspSaveStructEx(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureStructEx(pLoader, pStruct, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, pStruct->schema, size, heapSize));
+	EGSP_TRY(_EgspSaveStruct(pLoader, pStruct, pVal));
+	return EgspFlush(pLoader);
+}
+
+EgspResult EgspSaveStruct(const EgspStructInfo* pStruct, EgspFunc pFlushFunc, const void* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveStructEx(&loader, pStruct, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+EgspResult EgspSaveStructSpan(const EgspStructInfo* pStruct, uint8_t* pData, size_t size, const void* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveStructEx(&loader, pStruct, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+#ifdef EGSP_JSON
+#define EGSP_PRINT_NUMBER(TYPE) return _EgspPrint##TYPE(pLoader, (TYPE*)pVal)
+#define EGSP_READ_NUMBER(TYPE) return _EgspRead##TYPE(pLoader, (TYPE*)pVal)
+
+// Raw structs are copied whole, but still list each of their fields for Json
+static size_t _EgspFieldCount(const EgspStructInfo* pStruct)
+{
+	return pStruct->pLayout ? strlen((const char*)pStruct->pLayout) : pStruct->fieldCount;
+}
+
+static EgspResult _EgspPrintStruct(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal);
+static EgspResult _EgspReadStruct(EgspLoader* pLoader, const EgspStructInfo* pStruct, void* pVal);
+
+// The label the generated code writes for the field, put together from its name. Short ones are written in one go.
+static EgspResult _EgspWriteFieldLabel(EgspLoader* pLoader, const EgspField* pField, const char* pSuffix)
+{
+	char label[64];
+	size_t name = strlen(pField->pName);
+	size_t suffix = strlen(pSuffix);
+	if (name + suffix + 3 <= sizeof(label))
+	{
+		label[0] = '"';
+		memcpy(label + 1, pField->pName, name);
+		memcpy(label + 1 + name, pSuffix, suffix);
+		memcpy(label + 1 + name + suffix, "\":", 2);
+		return _EgspWriteLabel(pLoader, label, name + suffix + 3);
+	}
+	EGSP_TRY(_EgspBeforeToken(pLoader, '"'));
+	EGSP_TRY(_EgspSaveBytes(pLoader, "\"", 1));
+	EGSP_TRY(_EgspSaveBytes(pLoader, pField->pName, strlen(pField->pName)));
+	EGSP_TRY(_EgspSaveBytes(pLoader, pSuffix, strlen(pSuffix)));
+	EGSP_TRY(_EgspSaveBytes(pLoader, "\":", 2));
+	if (!(pLoader->flags & EGSP_FLAG_COMPACT))
+	{
+		EGSP_TRY(_EgspWriteChar(pLoader, ' '));
+	}
+	pLoader->last = ':';
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspPrintValue(EgspLoader* pLoader, const EgspField* pField, const void* pVal)
+{
+	switch (pField->kind)
+	{
+	case EGSP_KIND_UNSIGNED:
+	case EGSP_KIND_SIGNED:
+	case EGSP_KIND_FLOAT:
+		EGSP_NUMBER_SWITCH(EGSP_PRINT_NUMBER)
+		return EGSP_FAIL;
+	case EGSP_KIND_STRING:
+		return _EgspPrintstring(pLoader, (const char**)pVal);
+	case EGSP_KIND_STRUCT:
+	case EGSP_KIND_RAW:
+		return _EgspPrintStruct(pLoader, pField->pStruct, pVal);
+	case EGSP_KIND_ENUM:
+	{
+		int32_t val = _EgspGetEnum(pVal, pField->size);
+		return _EgspPrintint32_t(pLoader, &val);
+	}
+	}
+	return EGSP_FAIL;
+}
+
+static EgspResult _EgspReadValue(EgspLoader* pLoader, const EgspField* pField, void* pVal)
+{
+	switch (pField->kind)
+	{
+	case EGSP_KIND_UNSIGNED:
+	case EGSP_KIND_SIGNED:
+	case EGSP_KIND_FLOAT:
+		EGSP_NUMBER_SWITCH(EGSP_READ_NUMBER)
+		return EGSP_FAIL;
+	case EGSP_KIND_STRING:
+		return _EgspReadstring(pLoader, (const char**)pVal);
+	case EGSP_KIND_STRUCT:
+	case EGSP_KIND_RAW:
+		return _EgspReadStruct(pLoader, pField->pStruct, pVal);
+	case EGSP_KIND_ENUM:
+	{
+		int32_t val = 0;
+		EGSP_TRY(_EgspReadint32_t(pLoader, &val));
+		_EgspSetEnum(pVal, pField->size, val);
+		return EGSP_SUCCESS;
+	}
+	}
+	return EGSP_FAIL;
+}
+
+static EgspResult _EgspPrintStruct(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	for (const EgspField* pField = pStruct->pFields; pField < pStruct->pFields + _EgspFieldCount(pStruct); ++pField)
 	{
-		EGSP_TRY(CheckOverFlow(pLoader));
-		chr = pLoader->pData[pLoader->offset++];
+		const uint8_t* pMember = (const uint8_t*)pVal + pField->offset;
+		switch (pField->shape)
+		{
+		case EGSP_SHAPE_VALUE:
+			EGSP_TRY(_EgspWriteFieldLabel(pLoader, pField, ""));
+			EGSP_TRY(_EgspPrintValue(pLoader, pField, pMember));
+			break;
+
+		case EGSP_SHAPE_POINTER:
+		{
+			void* pItem = _EgspGetPointer(pMember);
+			uint8_t present = pItem != 0;
+			if (pItem)
+			{
+				pLoader->heapSize += _EgspPad(pLoader, pField->size);
+				EGSP_TRY(_EgspWriteFieldLabel(pLoader, pField, " is not null. Processing"));
+				EGSP_TRY(_EgspPrintuint8_t(pLoader, &present));
+				EGSP_TRY(_EgspWriteFieldLabel(pLoader, pField, ""));
+				EGSP_TRY(_EgspPrintValue(pLoader, pField, pItem));
+			}
+			else
+			{
+				EGSP_TRY(_EgspWriteFieldLabel(pLoader, pField, " is null. Skipping."));
+				EGSP_TRY(_EgspPrintuint8_t(pLoader, &present));
+			}
+			break;
+		}
+
+		case EGSP_SHAPE_ARRAY:
+		{
+			size_t count = _EgspCount(pVal, pField);
+			const uint8_t* pItems = (const uint8_t*)_EgspGetPointer(pMember);
+			pLoader->heapSize += _EgspArrayBytes(pLoader, pField, count);
+			EGSP_TRY(_EgspWriteFieldLabel(pLoader, pField, ""));
+			EGSP_TRY(_EgspWriteString(pLoader, "["));
+			for (size_t i = 0; i < count; ++i)
+			{
+				EGSP_TRY(_EgspPrintValue(pLoader, pField, pItems + i * pField->size));
+			}
+			EGSP_TRY(_EgspWriteString(pLoader, "],"));
+		}
+		}
 	}
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(pStruct->index, pStruct->pName);
 	return EGSP_SUCCESS;
 }
 
-#endif
\ No newline at end of file
+static EgspResult _EgspReadStruct(EgspLoader* pLoader, const EgspStructInfo* pStruct, void* pVal)
+{
+	EGSP_STATS_BEGIN
+	for (const EgspField* pField = pStruct->pFields; pField < pStruct->pFields + _EgspFieldCount(pStruct); ++pField)
+	{
+		uint8_t* pMember = (uint8_t*)pVal + pField->offset;
+		switch (pField->shape)
+		{
+		case EGSP_SHAPE_VALUE:
+			EGSP_TRY(_EgspSkipLabel(pLoader));
+			EGSP_TRY(_EgspReadValue(pLoader, pField, pMember));
+			break;
+
+		case EGSP_SHAPE_POINTER:
+		{
+			uint8_t present = 0;
+			void* pItem = 0;
+			EGSP_TRY(_EgspSkipLabel(pLoader));
+			EGSP_TRY(_EgspReaduint8_t(pLoader, &present));
+			if (present)
+			{
+				EGSP_TEST(pItem = EgspAlloc(pLoader, _EgspPad(pLoader, pField->size)));
+				EGSP_TRY(_EgspSkipLabel(pLoader));
+				EGSP_TRY(_EgspReadValue(pLoader, pField, pItem));
+			}
+			_EgspSetPointer(pMember, pItem);
+			break;
+		}
+
+		// Number arrays skip their opening bracket here, struct and string ones when reading the first element
+		case EGSP_SHAPE_ARRAY:
+		{
+			size_t count = _EgspCount(pVal, pField);
+			uint8_t* pItems = (uint8_t*)EgspAlloc(pLoader, _EgspArrayBytes(pLoader, pField, count));
+			_EgspSetPointer(pMember, pItems);
+			if (!pItems)
+			{
+				break;
+			}
+			EGSP_TRY(_EgspSkipLabel(pLoader));
+			if (_EgspIsNumber(pField->kind))
+			{
+				EGSP_TRY(_EgspSkipList(pLoader));
+			}
+			for (size_t i = 0; i < count; ++i)
+			{
+				EGSP_TRY(_EgspReadValue(pLoader, pField, pItems + i * pField->size));
+			}
+		}
+		}
+	}
+	EGSP_STATS_END(pStruct->index, pStruct->pName);
+	return EGSP_SUCCESS;
+}
+
+EgspResult EgspPrintStructEx(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintStruct(pLoader, pStruct, pVal));
+	return EgspFlush(pLoader);
+}
+
+EgspResult EgspPrintStruct(const EgspStructInfo* pStruct, EgspFunc pFlushFunc, const void* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintStructEx(&loader, pStruct, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+EgspResult EgspReadStructEx(EgspLoader* pLoader, const EgspStructInfo* pStruct, void* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadStruct(pLoader, pStruct, pVal);
+}
+
+EgspResult EgspReadStruct(const EgspStructInfo* pStruct, EgspFunc pLoadFunc, void* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadStructEx(&loader, pStruct, pVal, pHeap, heapSize);
+}
+#endif // EGSP_JSON
@@ -3,44 +3,212 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 typedef enum
 {
 	EGSP_SUCCESS,
-	EGSP_FAIL
+	EGSP_FAIL,
+	EGSP_NEED_MORE, // Only from EgspPushData, which wants more of the stream
+	EGSP_CORRUPT // Only from EgspCrcClose, when a block failed its checksum
 } EgspResult;
 
 #define EGSP_TRY(X) { if (X == EGSP_FAIL) return EGSP_FAIL; }
 #define EGSP_TEST(X) { if (!(X)) return EGSP_FAIL; }
+#define EGSP_STATIC_ASSERT(X, NAME) typedef char egspStaticAssert_##NAME[(X) ? 1 : -1]
+
+// Stream options, see EgspSetFlags
+#define EGSP_FLAG_ZERO_COPY 0x1 // Strings point into the loaded blocks when they can. Changes the binary format.
+#define EGSP_FLAG_ENVELOPE 0x2 // Streams start with an EgspEnvelope. Changes the binary format.
+#define EGSP_FLAG_VARINT 0x4 // Integers wider than a byte, string lengths and enums are LEB128 varints, zigzagged when signed. Changes the binary format.
+#define EGSP_FLAG_COMPACT 0x8 // Json is printed without line breaks or indentation. The reader takes either.
+
+// The flags that change the binary format, the only ones an envelope stores and checks
+#define EGSP_FORMAT_FLAGS (EGSP_FLAG_ZERO_COPY | EGSP_FLAG_ENVELOPE | EGSP_FLAG_VARINT)
+
+// Longest varint, that of a 64 bit number
+#define EGSP_VARINT_MAX 10
+
+// Header in front of enveloped streams, stored big-endian like everything else
+#define EGSP_ENVELOPE_MAGIC 0x45475350 // "EGSP"
+#define EGSP_ENVELOPE_SIZE 32
 
 typedef uint8_t* (*EgspFunc)(size_t);
+typedef uint8_t* (*EgspFuncEx)(void* pUser, size_t size);
+
+// Parallel saving of struct arrays, see egsppool.h
+struct EgspPool;
+struct EgspChunk;
+
+// Counters for a loader to add to, see EgspStats
+struct EgspStats;
+
+// Everything a single Save/Load/Print/Read works with. Set one up with EgspInitLoader and change the
+// block size, alignment or flags before handing it to the generated EgspSave*Ex/EgspLoad*Ex functions.
+// A loader with neither pFunc nor pFuncEx works on a single span of blockSize bytes at pData.
 typedef struct
 {
 	uint8_t* pData;
 	size_t offset;
+	size_t blockSize;
+	size_t alignBytes;
 	EgspFunc pFunc;
+	EgspFuncEx pFuncEx;
+	void* pUser;
+	uint32_t flags;
 	void* pHeap;
 	size_t heapSize;
 	char last;
 	int indent;
+	struct EgspPool* pPool;
+	struct EgspChunk* pChunk;
+	size_t measured;
+	struct EgspStats* pStats;
 } EgspLoader;
 
+// What an enveloped stream says about itself. size counts every byte of the stream, the envelope included.
+typedef struct
+{
+	uint32_t flags;
+	uint64_t schema;
+	uint64_t heapSize;
+	uint64_t size;
+} EgspEnvelope;
+
+// What egsploader knows about each struct, for code that works from tables instead of generated functions.
+// Generated as s_egspInfo<Struct>. Raw structs are copied by their layout and have a fieldCount of 0,
+// though pFields still lists one entry for each width in pLayout, for Json.
+typedef enum
+{
+	EGSP_KIND_UNSIGNED,
+	EGSP_KIND_SIGNED,
+	EGSP_KIND_FLOAT,
+	EGSP_KIND_STRING,
+	EGSP_KIND_STRUCT,
+	EGSP_KIND_RAW,
+	EGSP_KIND_ENUM
+} EgspKind;
+
+typedef enum
+{
+	EGSP_SHAPE_VALUE,
+	EGSP_SHAPE_POINTER,
+	EGSP_SHAPE_ARRAY
+} EgspShape;
+
+struct EgspStructInfo;
+
+// size is that of the field itself, or of what it points at for pointers and arrays
+typedef struct
+{
+	EgspKind kind;
+	EgspShape shape;
+	size_t offset;
+	size_t size;
+	size_t countOffset;
+	size_t countSize;
+	const struct EgspStructInfo* pStruct;
+	const char* pName;
+} EgspField;
+
+typedef struct EgspStructInfo
+{
+	size_t size;
+	const EgspField* pFields;
+	size_t fieldCount;
+	const uint8_t* pLayout;
+	uint64_t schema;
+	size_t fixedSize; // Stream size when every field is fixed width, nested structs included, otherwise 0
+	const char* pName;
+	int index;
+} EgspStructInfo;
+
+#ifdef EGSP_STATS
+// Struct types counted one by one, by their place in the schema. Later ones are not counted.
+#define EGSP_STATS_STRUCTS 64
+// Block function latency buckets. The first is under 256ns, each after it twice as wide, the last takes the rest.
+#define EGSP_STATS_BUCKETS 16
+
+typedef struct
+{
+	const char* pName;
+	uint64_t calls;
+	uint64_t bytes;
+} EgspStructStats;
+
+// What a loader with pStats set has done, added up over every call it is handed to until cleared with memset.
+// Bytes are those of the stream, so struct bytes include their nested structs and Measure counts nothing.
+// Structs are indexed by schema, so one stats block should only see the structs of one generated header.
+// Parallel save workers have no stats of their own, their chunks count once they are stitched into the stream.
+typedef struct EgspStats
+{
+	EgspStructStats structs[EGSP_STATS_STRUCTS];
+
+	// Numbers, strings and raw structs by EgspKind. Arrays add one call for each element.
+	uint64_t kindCalls[EGSP_KIND_ENUM + 1];
+	uint64_t kindBytes[EGSP_KIND_ENUM + 1];
+
+	// Calls to pFunc or pFuncEx and the time spent in them
+	uint64_t funcCalls;
+	uint64_t funcNanoseconds;
+	uint64_t funcHistogram[EGSP_STATS_BUCKETS];
+
+	// EgspAlloc calls, the bytes asked for and those lost to alignment, and the most heap one Load or Read took
+	uint64_t allocCalls;
+	uint64_t allocBytes;
+	uint64_t allocPadding;
+	size_t heapHighWater;
+	size_t heapStart;
+
+	// Bytes in the blocks handed over so far, so that offsets can be told apart across blocks
+	uint64_t streamed;
+} EgspStats;
+
+uint64_t _EgspStatsPosition(EgspLoader* pLoader);
+void _EgspStatsStruct(EgspLoader* pLoader, int index, const char* pName, uint64_t start);
+void _EgspStatsKind(EgspLoader* pLoader, EgspKind kind, size_t count, uint64_t start);
+
+// Generated struct functions count themselves between these
+#define EGSP_STATS_BEGIN uint64_t egspStatsStart = _EgspStatsPosition(pLoader);
+#define EGSP_STATS_END(INDEX, NAME) _EgspStatsStruct(pLoader, INDEX, NAME, egspStatsStart);
+#else
+#define EGSP_STATS_BEGIN
+#define EGSP_STATS_END(INDEX, NAME)
+#endif // EGSP_STATS
+
 // Utility
+void EgspInitLoader(EgspLoader* pLoader, EgspFuncEx pFunc, void* pUser);
+EgspResult EgspBegin(EgspLoader* pLoader);
+EgspResult EgspFlush(EgspLoader* pLoader);
 size_t EgspPad(size_t bytes);
+size_t _EgspPad(EgspLoader* pLoader, size_t bytes);
 void* EgspAlloc(EgspLoader* pLoader, size_t size);
-EgspResult EgspFlush(EgspLoader* pLoader);
+
+// Hands the used part of the current block over and moves on to the next one
+EgspResult _EgspNextBlock(EgspLoader* pLoader, size_t size);
+
+// Reads the envelope from the first bytes of a saved stream, e.g. to allocate the heap before loading
+EgspResult EgspPeekEnvelope(const uint8_t* pData, size_t size, EgspEnvelope* pEnvelope);
+EgspResult _EgspSaveEnvelope(EgspLoader* pLoader, uint64_t schema, size_t size, size_t heapSize);
+EgspResult _EgspLoadEnvelope(EgspLoader* pLoader, uint64_t schema);
+
+// Defaults for new loaders
 void EgspSetAlignBytes(size_t bytes);
 size_t EgspAlignBytes();
 void EgspSetBlockSize(size_t bytes);
 size_t EgspBlockSize();
+void EgspSetFlags(uint32_t flags);
+uint32_t EgspFlags();
 
+// Build with EGSP_INLINE to have the number primitives as static inline functions from egspinline.h
+#ifndef EGSP_INLINE
 // 64 bit
 EgspResult _EgspLoaduint64_t(EgspLoader* pLoader, uint64_t* pVal);
 EgspResult _EgspSaveuint64_t(EgspLoader* pLoader, uint64_t* pVal);
 EgspResult _EgspLoadint64_t(EgspLoader* pLoader, int64_t* pVal);
 EgspResult _EgspSaveint64_t(EgspLoader* pLoader, int64_t* pVal);
-EgspResult _EgspLoadDouble(EgspLoader* pLoader, double* pVal);
-EgspResult _EgspSaveDouble(EgspLoader* pLoader, double* pVal);
+EgspResult _EgspLoaddouble(EgspLoader* pLoader, double* pVal);
+EgspResult _EgspSavedouble(EgspLoader* pLoader, double* pVal);
 
 // 32 bit
 EgspResult _EgspLoaduint32_t(EgspLoader* pLoader, uint32_t* pVal);
@@ -59,16 +227,122 @@ EgspResult _EgspSaveint16_t(EgspLoader* pLoader, int16_t* pVal);
 // 8 bit
 EgspResult _EgspLoaduint8_t(EgspLoader* pLoader, uint8_t* pVal);
 EgspResult _EgspSaveuint8_t(EgspLoader* pLoader, uint8_t* pVal);
-EgspResult _EgspLoadint8_t(EgspLoader* pLoader, uint8_t* pVal);
-EgspResult _EgspSaveInt8(EgspLoader* pLoader, int8_t* pVal);
+EgspResult _EgspLoadint8_t(EgspLoader* pLoader, int8_t* pVal);
+EgspResult _EgspSaveint8_t(EgspLoader* pLoader, int8_t* pVal);
+#endif // EGSP_INLINE
+
+// Arrays of numbers, size being the width of one element
+EgspResult _EgspLoadArray(EgspLoader* pLoader, void* pVals, size_t count, size_t size, EgspKind kind);
+EgspResult _EgspSaveArray(EgspLoader* pLoader, const void* pVals, size_t count, size_t size, EgspKind kind);
+
+// Turns a decoded varint into the bits of a number of size bytes, failing if it does not fit
+EgspResult _EgspVarintValue(uint64_t* pVal, size_t size, EgspKind kind);
+
+// Raw bytes, and raw structs stored little-endian. pLayout holds the width of each field and ends with 0.
+EgspResult _EgspLoadBytes(EgspLoader* pLoader, void* pBytes, size_t size);
+EgspResult _EgspSaveBytes(EgspLoader* pLoader, const void* pBytes, size_t size);
+EgspResult _EgspLoadRaw(EgspLoader* pLoader, void* pVals, size_t count, size_t size, const uint8_t* pLayout);
+EgspResult _EgspSaveRaw(EgspLoader* pLoader, const void* pVals, size_t count, size_t size, const uint8_t* pLayout);
+void _EgspFixRaw(void* pVals, size_t count, const uint8_t* pLayout);
+
+// Runs of fixed width fields. Returns where the next size bytes go and moves past them, or 0 when they are not all
+// in the current block or the stream has varints, in which case the generated code goes field by field.
+#ifndef EGSP_INLINE
+uint8_t* _EgspRun(EgspLoader* pLoader, size_t size);
+#endif
+
+// Big-endian numbers in a run
+static inline uint64_t _EgspBig64(const uint8_t* pSrc)
+{
+	return ((uint64_t)pSrc[0] << 56) | ((uint64_t)pSrc[1] << 48) | ((uint64_t)pSrc[2] << 40) | ((uint64_t)pSrc[3] << 32)
+		| ((uint64_t)pSrc[4] << 24) | ((uint64_t)pSrc[5] << 16) | ((uint64_t)pSrc[6] << 8) | pSrc[7];
+}
+
+static inline uint32_t _EgspBig32(const uint8_t* pSrc)
+{
+	return ((uint32_t)pSrc[0] << 24) | ((uint32_t)pSrc[1] << 16) | ((uint32_t)pSrc[2] << 8) | pSrc[3];
+}
+
+static inline uint16_t _EgspBig16(const uint8_t* pSrc)
+{
+	return (uint16_t)((pSrc[0] << 8) | pSrc[1]);
+}
+
+static inline void _EgspPutBig64(uint8_t* pDst, uint64_t val)
+{
+	for (int i = 0; i < 8; ++i)
+	{
+		pDst[i] = (uint8_t)(val >> (56 - 8 * i));
+	}
+}
+
+static inline void _EgspPutBig32(uint8_t* pDst, uint32_t val)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		pDst[i] = (uint8_t)(val >> (24 - 8 * i));
+	}
+}
+
+static inline void _EgspPutBig16(uint8_t* pDst, uint16_t val)
+{
+	pDst[0] = (uint8_t)(val >> 8);
+	pDst[1] = (uint8_t)val;
+}
+
+static inline void _EgspGetuint64_t(const uint8_t* pSrc, uint64_t* pVal) { *pVal = _EgspBig64(pSrc); }
+static inline void _EgspPutuint64_t(uint8_t* pDst, const uint64_t* pVal) { _EgspPutBig64(pDst, *pVal); }
+static inline void _EgspGetint64_t(const uint8_t* pSrc, int64_t* pVal) { *pVal = (int64_t)_EgspBig64(pSrc); }
+static inline void _EgspPutint64_t(uint8_t* pDst, const int64_t* pVal) { _EgspPutBig64(pDst, (uint64_t)*pVal); }
+static inline void _EgspGetdouble(const uint8_t* pSrc, double* pVal) { uint64_t bits = _EgspBig64(pSrc); memcpy(pVal, &bits, 8); }
+static inline void _EgspPutdouble(uint8_t* pDst, const double* pVal) { uint64_t bits; memcpy(&bits, pVal, 8); _EgspPutBig64(pDst, bits); }
+static inline void _EgspGetuint32_t(const uint8_t* pSrc, uint32_t* pVal) { *pVal = _EgspBig32(pSrc); }
+static inline void _EgspPutuint32_t(uint8_t* pDst, const uint32_t* pVal) { _EgspPutBig32(pDst, *pVal); }
+static inline void _EgspGetint32_t(const uint8_t* pSrc, int32_t* pVal) { *pVal = (int32_t)_EgspBig32(pSrc); }
+static inline void _EgspPutint32_t(uint8_t* pDst, const int32_t* pVal) { _EgspPutBig32(pDst, (uint32_t)*pVal); }
+static inline void _EgspGetfloat(const uint8_t* pSrc, float* pVal) { uint32_t bits = _EgspBig32(pSrc); memcpy(pVal, &bits, 4); }
+static inline void _EgspPutfloat(uint8_t* pDst, const float* pVal) { uint32_t bits; memcpy(&bits, pVal, 4); _EgspPutBig32(pDst, bits); }
+static inline void _EgspGetuint16_t(const uint8_t* pSrc, uint16_t* pVal) { *pVal = _EgspBig16(pSrc); }
+static inline void _EgspPutuint16_t(uint8_t* pDst, const uint16_t* pVal) { _EgspPutBig16(pDst, *pVal); }
+static inline void _EgspGetint16_t(const uint8_t* pSrc, int16_t* pVal) { *pVal = (int16_t)_EgspBig16(pSrc); }
+static inline void _EgspPutint16_t(uint8_t* pDst, const int16_t* pVal) { _EgspPutBig16(pDst, (uint16_t)*pVal); }
+static inline void _EgspGetuint8_t(const uint8_t* pSrc, uint8_t* pVal) { *pVal = *pSrc; }
+static inline void _EgspPutuint8_t(uint8_t* pDst, const uint8_t* pVal) { *pDst = *pVal; }
+static inline void _EgspGetint8_t(const uint8_t* pSrc, int8_t* pVal) { *pVal = (int8_t)*pSrc; }
+static inline void _EgspPutint8_t(uint8_t* pDst, const int8_t* pVal) { *pDst = (uint8_t)*pVal; }
 
 // String
 EgspResult _EgspLoadstring(EgspLoader* pLoader, const char** ppString);
 EgspResult _EgspSavestring(EgspLoader* pLoader, const char** ppString);
+EgspResult _EgspSaveChars(EgspLoader* pLoader, const char* pChars, size_t length, size_t stored);
+
+// Parallel save of struct arrays. Only used when the loader has a pool and the array is long enough.
+typedef EgspResult (*EgspSaveElement)(EgspLoader* pLoader, const void* pVal);
+int _EgspParallel(EgspLoader* pLoader, size_t count);
+EgspResult _EgspSaveArrayParallel(EgspLoader* pLoader, const void* pVals, size_t count, size_t size, EgspSaveElement pSave);
+EgspResult _EgspRecordString(struct EgspChunk* pChunk, size_t offset, size_t length, size_t stored);
+
+// Measure, walking a struct like Save does without writing anything
+void _EgspMeasureBytes(EgspLoader* pLoader, size_t size);
+void _EgspMeasureuint64_t(EgspLoader* pLoader, uint64_t* pVal);
+void _EgspMeasureint64_t(EgspLoader* pLoader, int64_t* pVal);
+void _EgspMeasuredouble(EgspLoader* pLoader, double* pVal);
+void _EgspMeasureuint32_t(EgspLoader* pLoader, uint32_t* pVal);
+void _EgspMeasureint32_t(EgspLoader* pLoader, int32_t* pVal);
+void _EgspMeasurefloat(EgspLoader* pLoader, float* pVal);
+void _EgspMeasureuint16_t(EgspLoader* pLoader, uint16_t* pVal);
+void _EgspMeasureint16_t(EgspLoader* pLoader, int16_t* pVal);
+void _EgspMeasureuint8_t(EgspLoader* pLoader, uint8_t* pVal);
+void _EgspMeasureint8_t(EgspLoader* pLoader, int8_t* pVal);
+void _EgspMeasureArray(EgspLoader* pLoader, const void* pVals, size_t count, size_t size, EgspKind kind);
+void _EgspMeasurestring(EgspLoader* pLoader, const char** ppString);
 
 #ifdef EGSP_JSON
 // JsonPrint
 EgspResult _EgspWriteString(EgspLoader* pLoader, const char* pString);
+EgspResult _EgspWriteLabel(EgspLoader* pLoader, const char* pLabel, size_t length);
+EgspResult _EgspWriteNumber(EgspLoader* pLoader, const char* pText, size_t length);
+#ifndef EGSP_INLINE
 EgspResult _EgspPrintuint64_t(EgspLoader* pLoader, uint64_t* pVal);
 EgspResult _EgspPrintint64_t(EgspLoader* pLoader, int64_t* pVal);
 EgspResult _EgspPrintdouble(EgspLoader* pLoader, double* pVal);
@@ -79,6 +353,7 @@ EgspResult _EgspPrintuint16_t(EgspLoader* pLoader, uint16_t* pVal);
 EgspResult _EgspPrintint16_t(EgspLoader* pLoader, int16_t* pVal);
 EgspResult _EgspPrintuint8_t(EgspLoader* pLoader, uint8_t* pVal);
 EgspResult _EgspPrintint8_t(EgspLoader* pLoader, int8_t* pVal);
+#endif // EGSP_INLINE
 EgspResult _EgspPrintstring(EgspLoader* pLoader, const char** ppString);
 
 EgspResult _EgspReaduint64_t(EgspLoader* pLoader, uint64_t* pVal);
@@ -93,5 +368,47 @@ EgspResult _EgspReaduint8_t(EgspLoader* pLoader, uint8_t* pVal);
 EgspResult _EgspReadint8_t(EgspLoader* pLoader, int8_t* pVal);
 EgspResult _EgspReadstring(EgspLoader* pLoader, const char** ppString);
 EgspResult _EgspSkipLabel(EgspLoader* pLoader);
+EgspResult _EgspSkipList(EgspLoader* pLoader);
 #endif // EGSP_JSON
+
+// Table driven, one interpreter walking the EgspStructInfo of any struct instead of its generated functions.
+// Streams, Json and heap sizes are the same as the generated code's, but arrays are never saved in parallel.
+EgspResult EgspLoadStructEx(EgspLoader* pLoader, const EgspStructInfo* pStruct, void* pVal, void* pHeap, size_t heapSize);
+EgspResult EgspLoadStruct(const EgspStructInfo* pStruct, EgspFunc pLoadFunc, void* pVal, void* pHeap, size_t heapSize);
+EgspResult EgspLoadStructSpan(const EgspStructInfo* pStruct, const uint8_t* pData, size_t size, void* pVal, void* pHeap, size_t heapSize);
+size_t EgspMeasureStructEx(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal);
+size_t EgspMeasureStruct(const EgspStructInfo* pStruct, const void* pVal, size_t* pHeapRequired);
+EgspResult EgspSaveStructEx(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal);
+EgspResult EgspSaveStruct(const EgspStructInfo* pStruct, EgspFunc pFlushFunc, const void* pVal, size_t* pHeapRequired);
+EgspResult EgspSaveStructSpan(const EgspStructInfo* pStruct, uint8_t* pData, size_t size, const void* pVal, size_t* pWritten, size_t* pHeapRequired);
+#ifdef EGSP_JSON
+EgspResult EgspPrintStructEx(EgspLoader* pLoader, const EgspStructInfo* pStruct, const void* pVal);
+EgspResult EgspPrintStruct(const EgspStructInfo* pStruct, EgspFunc pFlushFunc, const void* pVal, size_t* pHeapRequired);
+EgspResult EgspReadStructEx(EgspLoader* pLoader, const EgspStructInfo* pStruct, void* pVal, void* pHeap, size_t heapSize);
+EgspResult EgspReadStruct(const EgspStructInfo* pStruct, EgspFunc pLoadFunc, void* pVal, void* pHeap, size_t heapSize);
+
+#define EGSP_TABLE_JSON(NAME) \
+static inline EgspResult EgspPrint##NAME##Ex(EgspLoader* pLoader, NAME* pVal) { return EgspPrintStructEx(pLoader, &s_egspInfo##NAME, pVal); } \
+static inline EgspResult EgspPrint##NAME(EgspFunc pFlushFunc, NAME* pVal, size_t* pHeapRequired) { return EgspPrintStruct(&s_egspInfo##NAME, pFlushFunc, pVal, pHeapRequired); } \
+static inline EgspResult EgspRead##NAME##Ex(EgspLoader* pLoader, NAME* pVal, void* pHeap, size_t heapSize) { return EgspReadStructEx(pLoader, &s_egspInfo##NAME, pVal, pHeap, heapSize); } \
+static inline EgspResult EgspRead##NAME(EgspFunc pLoadFunc, NAME* pVal, void* pHeap, size_t heapSize) { return EgspReadStruct(&s_egspInfo##NAME, pLoadFunc, pVal, pHeap, heapSize); }
+#else
+#define EGSP_TABLE_JSON(NAME)
+#endif
+
+// The entry points egsploader --tables generates for each struct in place of its functions
+#define EGSP_TABLE_FUNCTIONS(NAME) \
+static inline EgspResult EgspLoad##NAME##Ex(EgspLoader* pLoader, NAME* pVal, void* pHeap, size_t heapSize) { return EgspLoadStructEx(pLoader, &s_egspInfo##NAME, pVal, pHeap, heapSize); } \
+static inline EgspResult EgspLoad##NAME(EgspFunc pLoadFunc, NAME* pVal, void* pHeap, size_t heapSize) { return EgspLoadStruct(&s_egspInfo##NAME, pLoadFunc, pVal, pHeap, heapSize); } \
+static inline EgspResult EgspLoad##NAME##Span(const uint8_t* pData, size_t size, NAME* pVal, void* pHeap, size_t heapSize) { return EgspLoadStructSpan(&s_egspInfo##NAME, pData, size, pVal, pHeap, heapSize); } \
+static inline size_t EgspMeasure##NAME##Ex(EgspLoader* pLoader, NAME* pVal) { return EgspMeasureStructEx(pLoader, &s_egspInfo##NAME, pVal); } \
+static inline size_t EgspMeasure##NAME(NAME* pVal, size_t* pHeapRequired) { return EgspMeasureStruct(&s_egspInfo##NAME, pVal, pHeapRequired); } \
+static inline EgspResult EgspSave##NAME##Ex(EgspLoader* pLoader, NAME* pVal) { return EgspSaveStructEx(pLoader, &s_egspInfo##NAME, pVal); } \
+static inline EgspResult EgspSave##NAME(EgspFunc pFlushFunc, NAME* pVal, size_t* pHeapRequired) { return EgspSaveStruct(&s_egspInfo##NAME, pFlushFunc, pVal, pHeapRequired); } \
+static inline EgspResult EgspSave##NAME##Span(uint8_t* pData, size_t size, NAME* pVal, size_t* pWritten, size_t* pHeapRequired) { return EgspSaveStructSpan(&s_egspInfo##NAME, pData, size, pVal, pWritten, pHeapRequired); } \
+EGSP_TABLE_JSON(NAME)
+
+#ifdef EGSP_INLINE
+#include "egspinline.h"
+#endif
 #endif
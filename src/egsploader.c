@@ -1,9 +1,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <string.h>
+#include <stdint.h>
 
 #define EGSP_MAX_FIELD_LENGTH 256
 #define EGSP_BUFFER_SIZE (1 << 20)
+#define EGSP_MAX_STRUCTS 4096
+#define EGSP_MAX_FIELDS 1024
+#define EGSP_RUN_BUFFER_SIZE (1 << 18)
 
 typedef int(*Processor)(char);
 typedef enum
@@ -23,21 +28,91 @@ typedef enum
 	DEFAULT
 } DataType;
 
+// Fixed width types, stored as is or as varints depending on their kind
+static const struct
+{
+	const char* pName;
+	int size;
+	const char* pKind;
+} s_primitives[] = {
+	{ "uint64_t", 8, "EGSP_KIND_UNSIGNED" },
+	{ "int64_t", 8, "EGSP_KIND_SIGNED" },
+	{ "double", 8, "EGSP_KIND_FLOAT" },
+	{ "uint32_t", 4, "EGSP_KIND_UNSIGNED" },
+	{ "int32_t", 4, "EGSP_KIND_SIGNED" },
+	{ "float", 4, "EGSP_KIND_FLOAT" },
+	{ "uint16_t", 2, "EGSP_KIND_UNSIGNED" },
+	{ "int16_t", 2, "EGSP_KIND_SIGNED" },
+	{ "uint8_t", 1, "EGSP_KIND_UNSIGNED" },
+	{ "int8_t", 1, "EGSP_KIND_SIGNED" }
+};
+
 static FILE* s_pCode;
 static char s_fields[COUNT][EGSP_MAX_FIELD_LENGTH];
 static DataType s_type;
 static int s_curField = 0;
 static int s_curpos = 0;
 static int s_linenum = 0;
+static int s_raw = 0;
+static int s_rawSize = 0;
+static char s_rawLayout[EGSP_MAX_FIELD_LENGTH * 4];
+static char s_rawStructs[EGSP_MAX_STRUCTS][EGSP_MAX_FIELD_LENGTH];
+static int s_rawCount = 0;
+
+// Fingerprint of the binary format of the current struct, and of every struct so far
+static uint64_t s_schema;
+static char s_structs[EGSP_MAX_STRUCTS][EGSP_MAX_FIELD_LENGTH];
+static uint64_t s_structSchemas[EGSP_MAX_STRUCTS];
+static int s_structCount = 0;
+static int s_fieldCount = 0;
+static char s_fieldNames[EGSP_MAX_FIELDS][EGSP_MAX_FIELD_LENGTH];
+static int s_selfReference = 0;
+static int s_nullCheck = 0;
 
 static struct {
 	char* pBase;
 	char* pLoad;
 	char* pSave;
+	char* pMeasure;
+	char* pTable;
 	char* pPrint;
 	char* pRead;
 } s_buffers;
 
+// Consecutive fixed width fields, loaded and saved straight from the block after a single bounds check.
+// The usual call per field stays behind as the slow path, for runs straddling two blocks and varint streams.
+static struct {
+	char get[EGSP_RUN_BUFFER_SIZE];
+	char put[EGSP_RUN_BUFFER_SIZE];
+	char load[EGSP_RUN_BUFFER_SIZE];
+	char save[EGSP_RUN_BUFFER_SIZE];
+	char* pGet;
+	char* pPut;
+	char* pLoad;
+	char* pSave;
+	int size;
+	int fields;
+} s_run;
+
+// The whole struct as one run while all its fields are fixed width, for the _EgspGet/_EgspPut functions that
+// structs nesting it use in their own runs. s_structFixed keeps the stream size of each such struct, 0 for the rest.
+static struct {
+	char get[EGSP_RUN_BUFFER_SIZE];
+	char put[EGSP_RUN_BUFFER_SIZE];
+	char* pGet;
+	char* pPut;
+	int size;
+	int fixed;
+} s_whole;
+static int s_structFixed[EGSP_MAX_STRUCTS];
+
+// Element types that already have a _EgspSaveElement wrapper for _EgspSaveArrayParallel
+static char s_elementSaves[EGSP_MAX_STRUCTS][EGSP_MAX_FIELD_LENGTH];
+static int s_elementSaveCount = 0;
+
+// --tables emits only the field tables of each struct, its functions forwarding to the interpreter in egsplib.c
+static int s_tables = 0;
+
 static void ErrorCheck(int condition, const char* text)
 {
 	if (condition)
@@ -47,155 +122,775 @@ static void ErrorCheck(int condition, const char* text)
 	}
 }
 
+// Returns the width of a fixed width type, or 0 for strings and structs
+static int PrimitiveSize(const char* pType)
+{
+	for (size_t i = 0; i < sizeof(s_primitives) / sizeof(s_primitives[0]); ++i)
+	{
+		if (strcmp(s_primitives[i].pName, pType) == 0)
+		{
+			return s_primitives[i].size;
+		}
+	}
+	return 0;
+}
+
+static const char* PrimitiveKind(const char* pType)
+{
+	for (size_t i = 0; i < sizeof(s_primitives) / sizeof(s_primitives[0]); ++i)
+	{
+		if (strcmp(s_primitives[i].pName, pType) == 0)
+		{
+			return s_primitives[i].pKind;
+		}
+	}
+	return 0;
+}
+
+static int IsRawStruct(const char* pType)
+{
+	for (int i = 0; i < s_rawCount; ++i)
+	{
+		if (strcmp(s_rawStructs[i], pType) == 0)
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Code closing the EGSP_STATS_BEGIN a struct function starts with, counting it as struct number index
+static int StatsEnd(char* pOut, int index, const char* pName)
+{
+	return sprintf(pOut, "\tEGSP_STATS_END(%d, \"%s\");\n", index, pName);
+}
+
+// Copies code, with every line indented by pIndent
+static int Indent(char* pOut, const char* pCode, const char* pIndent)
+{
+	char* pStart = pOut;
+	while (*pCode)
+	{
+		const char* pEnd = strchr(pCode, '\n');
+		size_t length = pEnd ? (size_t)(pEnd - pCode) + 1 : strlen(pCode);
+		pOut += sprintf(pOut, "%s%.*s", pIndent, (int)length, pCode);
+		pCode += length;
+	}
+	return (int)(pOut - pStart);
+}
+
+#ifdef EGSP_JSON
+// Code writing the Json label of a field, with the length worked out here rather than at run time
+static int PrintLabel(char* pOut, const char* pIndent, const char* pName, const char* pSuffix)
+{
+	return sprintf(pOut, "%sEGSP_TRY(_EgspWriteLabel(pLoader, \"\\\"%s%s\\\":\", %d));\n"
+		, pIndent, pName, pSuffix, (int)(strlen(pName) + strlen(pSuffix) + 3));
+}
+#endif
+
+// FNV-1a over what decides the binary format. Field names do not, so renaming a field keeps the fingerprint.
+static void HashBytes(const void* pData, size_t size)
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		s_schema ^= ((const uint8_t*)pData)[i];
+		s_schema *= 0x100000001b3ull;
+	}
+}
+
+static void HashString(const char* pText)
+{
+	HashBytes(pText, strlen(pText) + 1);
+}
+
+// Nested structs contribute their own fingerprint, so a change to one changes every struct holding it
+static void HashType(const char* pType)
+{
+	for (int i = 0; i < s_structCount; ++i)
+	{
+		if (strcmp(s_structs[i], pType) == 0)
+		{
+			uint8_t bytes[8];
+			for (int b = 0; b < 8; ++b)
+			{
+				bytes[b] = (uint8_t)(s_structSchemas[i] >> (8 * b));
+			}
+			HashBytes(bytes, sizeof(bytes));
+			return;
+		}
+	}
+	HashString(pType);
+}
+
+// Arrays count their elements in an earlier field of the struct. Which one it is matters, what it is called does not.
+static void HashCount()
+{
+	for (int i = 0; i < s_fieldCount; ++i)
+	{
+		if (strcmp(s_fieldNames[i], s_fields[LIST_SIZE]) == 0)
+		{
+			uint8_t bytes[4];
+			for (int b = 0; b < 4; ++b)
+			{
+				bytes[b] = (uint8_t)(i >> (8 * b));
+			}
+			HashBytes(bytes, sizeof(bytes));
+			return;
+		}
+	}
+	ErrorCheck(1, "Array count must be an earlier field of the struct");
+}
+
+// Writes the void* typed wrapper _EgspSaveArrayParallel calls the element's save function through, once per type
+static void WriteSaveElement(const char* pType)
+{
+	for (int i = 0; i < s_elementSaveCount; ++i)
+	{
+		if (strcmp(s_elementSaves[i], pType) == 0)
+		{
+			return;
+		}
+	}
+	ErrorCheck(s_elementSaveCount == EGSP_MAX_STRUCTS, "Too many structs");
+	strcpy(s_elementSaves[s_elementSaveCount++], pType);
+
+	// An array of the struct being defined needs its save function declared ahead of the wrapper
+	if (strcmp(pType, s_fields[STRUCT_NAME]) == 0)
+	{
+		fprintf(s_pCode, "static EgspResult _EgspSave%s(EgspLoader* pLoader, %s* pVal);\n\n", pType, pType);
+	}
+	fprintf(s_pCode,
+		"static EgspResult _EgspSaveElement%s(EgspLoader* pLoader, const void* pVal)\n{\n"
+		"\treturn _EgspSave%s(pLoader, (%s*)pVal);\n"
+		"}\n\n"
+		, pType, pType, pType);
+}
+
+static void ResetRun()
+{
+	s_run.pGet = s_run.get;
+	s_run.pPut = s_run.put;
+	s_run.pLoad = s_run.load;
+	s_run.pSave = s_run.save;
+	*s_run.get = *s_run.put = *s_run.load = *s_run.save = '\0';
+	s_run.size = 0;
+	s_run.fields = 0;
+}
+
+// Stream size of the current field when it is fixed width, nested fixed width structs included, or 0
+static int FixedSize()
+{
+	if (s_type == ENUM)
+	{
+		return 4;
+	}
+	if (s_type != DEFAULT)
+	{
+		return 0;
+	}
+	int size = PrimitiveSize(s_fields[DATA_TYPE]);
+	for (int i = 0; i < s_structCount && !size; ++i)
+	{
+		if (strcmp(s_structs[i], s_fields[DATA_TYPE]) == 0)
+		{
+			size = s_structFixed[i];
+		}
+	}
+	return size;
+}
+
+// Code decoding and encoding the current field at offset into a run
+static int RunGet(char* pOut, int offset)
+{
+	if (s_type == ENUM)
+	{
+		return sprintf(pOut, "\tpVal->%s = (%s)(int32_t)_EgspBig32(pRun + %d);\n", s_fields[VAR_NAME], s_fields[DATA_TYPE], offset);
+	}
+	return sprintf(pOut, "\t_EgspGet%s(pRun + %d, &pVal->%s);\n", s_fields[DATA_TYPE], offset, s_fields[VAR_NAME]);
+}
+
+static int RunPut(char* pOut, int offset)
+{
+	if (s_type == ENUM)
+	{
+		return sprintf(pOut, "\t_EgspPutBig32(pRun + %d, (uint32_t)(int32_t)pVal->%s);\n", offset, s_fields[VAR_NAME]);
+	}
+	return sprintf(pOut, "\t_EgspPut%s(pRun + %d, &pVal->%s);\n", s_fields[DATA_TYPE], offset, s_fields[VAR_NAME]);
+}
+
+// Adds the current field to the run, its slow path already being in s_run.load and s_run.save
+static void AddRunField(int size)
+{
+	s_run.pGet += RunGet(s_run.pGet, s_run.size);
+	s_run.pPut += RunPut(s_run.pPut, s_run.size);
+	s_run.size += size;
+	++s_run.fields;
+	if (s_whole.fixed)
+	{
+		s_whole.pGet += RunGet(s_whole.pGet, s_whole.size);
+		s_whole.pPut += RunPut(s_whole.pPut, s_whole.size);
+		s_whole.size += size;
+	}
+}
+
+// Emits the run so far. A single field gains nothing from a run and keeps its usual call.
+static void FlushRun()
+{
+	if (s_run.fields > 1)
+	{
+		s_buffers.pLoad += sprintf(s_buffers.pLoad,
+			"\t{\n"
+			"\t\tuint8_t* pRun = _EgspRun(pLoader, %d);\n"
+			"\t\tif (pRun)\n"
+			"\t\t{\n"
+			, s_run.size);
+		s_buffers.pLoad += Indent(s_buffers.pLoad, s_run.get, "\t\t");
+		s_buffers.pLoad += sprintf(s_buffers.pLoad, "\t\t}\n\t\telse\n\t\t{\n");
+		s_buffers.pLoad += Indent(s_buffers.pLoad, s_run.load, "\t\t");
+		s_buffers.pLoad += sprintf(s_buffers.pLoad, "\t\t}\n\t}\n");
+
+		s_buffers.pSave += sprintf(s_buffers.pSave,
+			"\t{\n"
+			"\t\tuint8_t* pRun = _EgspRun(pLoader, %d);\n"
+			"\t\tif (pRun)\n"
+			"\t\t{\n"
+			, s_run.size);
+		s_buffers.pSave += Indent(s_buffers.pSave, s_run.put, "\t\t");
+		s_buffers.pSave += sprintf(s_buffers.pSave, "\t\t}\n\t\telse\n\t\t{\n");
+		s_buffers.pSave += Indent(s_buffers.pSave, s_run.save, "\t\t");
+		s_buffers.pSave += sprintf(s_buffers.pSave, "\t\t}\n\t}\n");
+	}
+	else
+	{
+		s_buffers.pLoad += sprintf(s_buffers.pLoad, "%s", s_run.load);
+		s_buffers.pSave += sprintf(s_buffers.pSave, "%s", s_run.save);
+	}
+	ResetRun();
+}
+
 static void BeginStruct()
 {
 	s_buffers.pLoad = s_buffers.pBase;
 	s_buffers.pSave = s_buffers.pBase + EGSP_BUFFER_SIZE;
+	s_buffers.pMeasure = s_buffers.pBase + EGSP_BUFFER_SIZE * 2;
+	s_buffers.pTable = s_buffers.pBase + EGSP_BUFFER_SIZE * 3;
 	s_type = DEFAULT;
+	*s_buffers.pLoad = '\0';
+	*s_buffers.pSave = '\0';
+	*s_buffers.pMeasure = '\0';
+	*s_buffers.pTable = '\0';
+	s_fieldCount = 0;
+	s_selfReference = 0;
+	s_nullCheck = 0;
+	s_schema = 0xcbf29ce484222325ull;
+	ResetRun();
+	s_whole.pGet = s_whole.get;
+	s_whole.pPut = s_whole.put;
+	*s_whole.get = *s_whole.put = '\0';
+	s_whole.size = 0;
+	s_whole.fixed = 1;
+	HashString(s_raw ? "!" : "{");
 
-	//Loader
-	s_buffers.pLoad += sprintf(s_buffers.pLoad, 
-		"static EgspResult _EgspLoad%s(EgspLoader* pLoader, %s* pVal)\n{\n"
-		"\tuint8_t egspNullCheck = 0;\n"
-		, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
+	// Raw structs get their layout checks first and their functions at the end
+	if (s_raw)
+	{
+		s_rawSize = 0;
+		s_rawLayout[0] = '\0';
+	}
+	else
+	{
+		//Loader
+		s_buffers.pLoad += sprintf(s_buffers.pLoad, 
+			"static EgspResult _EgspLoad%s(EgspLoader* pLoader, %s* pVal)\n{\n"
+			"\tEGSP_STATS_BEGIN\n"
+			, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
 
-	//Saver
-	s_buffers.pSave += sprintf(s_buffers.pSave, 
-		"static EgspResult _EgspSave%s(EgspLoader* pLoader, %s* pVal)\n{\n"
-		, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
+		//Saver
+		s_buffers.pSave += sprintf(s_buffers.pSave, 
+			"static EgspResult _EgspSave%s(EgspLoader* pLoader, %s* pVal)\n{\n"
+			"\tEGSP_STATS_BEGIN\n"
+			, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
+
+		//Measurer
+		s_buffers.pMeasure += sprintf(s_buffers.pMeasure,
+			"static void _EgspMeasure%s(EgspLoader* pLoader, %s* pVal)\n{\n"
+			, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
+	}
 
 #ifdef EGSP_JSON
-	s_buffers.pPrint = s_buffers.pBase + EGSP_BUFFER_SIZE * 2;
-	s_buffers.pRead = s_buffers.pBase + EGSP_BUFFER_SIZE * 3;
+	s_buffers.pPrint = s_buffers.pBase + EGSP_BUFFER_SIZE * 4;
+	s_buffers.pRead = s_buffers.pBase + EGSP_BUFFER_SIZE * 5;
 
 	//Printer
 	s_buffers.pPrint += sprintf(s_buffers.pPrint, 
 		"static EgspResult _EgspPrint%s(EgspLoader* pLoader, %s* pVal)\n{\n"
+		"\tEGSP_STATS_BEGIN\n"
 		"\tEGSP_TRY(_EgspWriteString(pLoader, \"{\"));\n"
 		, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
 
 	//Reader
 	s_buffers.pRead += sprintf(s_buffers.pRead, 
 		"static EgspResult _EgspRead%s(EgspLoader* pLoader, %s* pVal)\n{\n"
-		"\tuint8_t egspNullCheck = 0;\n"
+		"\tEGSP_STATS_BEGIN\n"
 		, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
 #endif
 }
 
+// The field table and EgspStructInfo of the struct. Raw structs list their fields for Json but count none.
+static void WriteTables(const char* pName, int index)
+{
+	int raw = IsRawStruct(pName);
+
+	// A struct pointing at its own type needs its info declared before the fields refer to it
+	if (s_selfReference)
+	{
+		fprintf(s_pCode, "static const EgspStructInfo s_egspInfo%s;\n\n", pName);
+	}
+	if (s_fieldCount)
+	{
+		fprintf(s_pCode, "static const EgspField s_egspFields%s[] = {\n%s};\n\n", pName, s_buffers.pBase + EGSP_BUFFER_SIZE * 3);
+	}
+	fprintf(s_pCode, "static const EgspStructInfo s_egspInfo%s = { sizeof(%s), %s%s, %d, %s%s, s_egspSchema%s, %d, \"%s\", %d };\n\n"
+		, pName, pName, s_fieldCount ? "s_egspFields" : "0", s_fieldCount ? pName : ""
+		, raw ? 0 : s_fieldCount, raw ? "s_egspLayout" : "0", raw ? pName : "", pName, s_structFixed[index], pName, index);
+}
+
 static void EndStruct()
 {
+	const char* pName = s_fields[STRUCT_NAME];
+	int fixedSize = 0;
+	if (s_raw)
+	{
+		// Copied into runs as is, like a whole array of them
+		fixedSize = s_rawSize;
+		s_buffers.pLoad += sprintf(s_buffers.pLoad,
+			"EGSP_STATIC_ASSERT(sizeof(%s) == %d, %s_size);\n"
+			"static const uint8_t s_egspLayout%s[] = { %s0 };\n\n"
+			, s_fields[STRUCT_NAME], s_rawSize, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME], s_rawLayout);
+		if (s_tables)
+		{
+			fputs(s_buffers.pBase, s_pCode);
+		}
+		s_buffers.pLoad += sprintf(s_buffers.pLoad,
+			"static inline void _EgspGet%s(const uint8_t* pRun, %s* pVal)\n{\n"
+			"\tmemcpy(pVal, pRun, sizeof(%s));\n"
+			"\t_EgspFixRaw(pVal, 1, s_egspLayout%s);\n"
+			"}\n\n"
+			"static inline void _EgspPut%s(uint8_t* pRun, const %s* pVal)\n{\n"
+			"\tmemcpy(pRun, pVal, sizeof(%s));\n"
+			"\t_EgspFixRaw(pRun, 1, s_egspLayout%s);\n"
+			"}\n\n"
+			, pName, pName, pName, pName, pName, pName, pName, pName);
+		s_buffers.pLoad += sprintf(s_buffers.pLoad,
+			"static EgspResult _EgspLoad%s(EgspLoader* pLoader, %s* pVal)\n{\n"
+			"\tEGSP_STATS_BEGIN\n"
+			"\tEGSP_TRY(_EgspLoadRaw(pLoader, pVal, 1, sizeof(%s), s_egspLayout%s));\n"
+			, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME], s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
+		s_buffers.pSave += sprintf(s_buffers.pSave,
+			"static EgspResult _EgspSave%s(EgspLoader* pLoader, %s* pVal)\n{\n"
+			"\tEGSP_STATS_BEGIN\n"
+			"\tEGSP_TRY(_EgspSaveRaw(pLoader, pVal, 1, sizeof(%s), s_egspLayout%s));\n"
+			, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME], s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
+		s_buffers.pMeasure += sprintf(s_buffers.pMeasure,
+			"static void _EgspMeasure%s(EgspLoader* pLoader, %s* pVal)\n{\n"
+			"\t(void)pVal;\n"
+			"\t_EgspMeasureBytes(pLoader, sizeof(%s));\n"
+			, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
+
+		ErrorCheck(s_rawCount == EGSP_MAX_STRUCTS, "Too many raw structs");
+		strcpy(s_rawStructs[s_rawCount++], s_fields[STRUCT_NAME]);
+		s_raw = 0;
+	}
+	else
+	{
+		FlushRun();
+		fixedSize = s_whole.fixed ? s_whole.size : 0;
+	}
+
+	ErrorCheck(s_structCount == EGSP_MAX_STRUCTS, "Too many structs");
+	strcpy(s_structs[s_structCount], pName);
+	s_structSchemas[s_structCount++] = s_schema;
+	int index = s_structCount - 1;
+	s_structFixed[index] = fixedSize;
+	fprintf(s_pCode, "static const uint64_t s_egspSchema%s = 0x%016llxull;\n\n", pName, (unsigned long long)s_schema);
+	if (s_tables)
+	{
+		WriteTables(pName, index);
+		fprintf(s_pCode, "EGSP_TABLE_FUNCTIONS(%s)\n\n", pName);
+		return;
+	}
+	if (fixedSize && !IsRawStruct(pName))
+	{
+		fprintf(s_pCode, "static inline void _EgspGet%s(const uint8_t* pRun, %s* pVal)\n{\n%s}\n\n", pName, pName, s_whole.get);
+		fprintf(s_pCode, "static inline void _EgspPut%s(uint8_t* pRun, const %s* pVal)\n{\n%s}\n\n", pName, pName, s_whole.put);
+	}
+
 	//Loader
+	s_buffers.pLoad += StatsEnd(s_buffers.pLoad, index, pName);
 	s_buffers.pLoad += sprintf(s_buffers.pLoad, "\treturn EGSP_SUCCESS;\n}\n\n"
-		"static EgspResult EgspLoad%s(EgspFunc pLoadFunc, %s* pVal, void* pHeap, size_t heapSize)\n"
+		"static inline EgspResult EgspLoad%sEx(EgspLoader* pLoader, %s* pVal, void* pHeap, size_t heapSize)\n"
+		"{\n"
+		"\tpLoader->pHeap = pHeap;\n"
+		"\tpLoader->heapSize = heapSize;\n"
+		"\tEGSP_TRY(EgspBegin(pLoader));\n"
+		"\tEGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchema%s));\n"
+		"\treturn _EgspLoad%s(pLoader, pVal);\n"
+		"}\n\n"
+		"static inline EgspResult EgspLoad%s(EgspFunc pLoadFunc, %s* pVal, void* pHeap, size_t heapSize)\n"
 		"{\n"
 		"\tEgspLoader loader;\n"
+		"\tEgspInitLoader(&loader, 0, 0);\n"
 		"\tloader.pFunc = pLoadFunc;\n"
-		"\tloader.offset = 0;\n"
-		"\tloader.pHeap = pHeap;\n"
-		"\tloader.heapSize = heapSize;\n"
-		"\tEGSP_TEST(loader.pData = loader.pFunc(EgspBlockSize()));\n"
-		"\tEGSP_TRY(_EgspLoad%s(&loader, pVal));\n"
-		"\treturn EGSP_SUCCESS;\n"
+		"\treturn EgspLoad%sEx(&loader, pVal, pHeap, heapSize);\n"
 		"}\n\n"
-		, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
+		"static inline EgspResult EgspLoad%sSpan(const uint8_t* pData, size_t size, %s* pVal, void* pHeap, size_t heapSize)\n"
+		"{\n"
+		"\tEgspLoader loader;\n"
+		"\tEgspInitLoader(&loader, 0, 0);\n"
+		"\tloader.pData = (uint8_t*)pData;\n"
+		"\tloader.blockSize = size;\n"
+		"\treturn EgspLoad%sEx(&loader, pVal, pHeap, heapSize);\n"
+		"}\n\n"
+		, pName, pName, pName, pName, pName, pName, pName, pName, pName, pName);
 
 	//Saver
+	s_buffers.pSave += StatsEnd(s_buffers.pSave, index, pName);
 	s_buffers.pSave += sprintf(s_buffers.pSave, "\treturn EGSP_SUCCESS;\n}\n\n"
-		"static EgspResult EgspSave%s(EgspFunc pFlushFunc, %s* pVal, size_t* pHeapRequired)\n"
+		"static inline EgspResult EgspSave%sEx(EgspLoader* pLoader, %s* pVal)\n"
+		"{\n"
+		"\tsize_t size = 0;\n"
+		"\tsize_t heapSize = 0;\n"
+		"\tif (pLoader->flags & EGSP_FLAG_ENVELOPE)\n"
+		"\t{\n"
+		"\t\tsize = EgspMeasure%sEx(pLoader, pVal);\n"
+		"\t\theapSize = pLoader->heapSize;\n"
+		"\t}\n"
+		"\tpLoader->heapSize = 0;\n"
+		"\tEGSP_TRY(EgspBegin(pLoader));\n"
+		"\tEGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchema%s, size, heapSize));\n"
+		"\tEGSP_TRY(_EgspSave%s(pLoader, pVal));\n"
+		"\treturn EgspFlush(pLoader);\n"
+		"}\n\n"
+		"static inline EgspResult EgspSave%s(EgspFunc pFlushFunc, %s* pVal, size_t* pHeapRequired)\n"
 		"{\n"
 		"\tEgspLoader loader;\n"
+		"\tEgspInitLoader(&loader, 0, 0);\n"
 		"\tloader.pFunc = pFlushFunc;\n"
-		"\tloader.offset = 0;\n"
-		"\tloader.heapSize = 0;\n"
-		"\tEGSP_TEST(loader.pData = loader.pFunc(0));\n"
-		"\tEGSP_TRY(_EgspSave%s(&loader, pVal))\n;"
-		"\tEGSP_TRY(EgspFlush(&loader));\n"
+		"\tEGSP_TRY(EgspSave%sEx(&loader, pVal));\n"
+		"\t*pHeapRequired = loader.heapSize;\n"
+		"\treturn EGSP_SUCCESS;\n"
+		"}\n\n"
+		"static inline EgspResult EgspSave%sSpan(uint8_t* pData, size_t size, %s* pVal, size_t* pWritten, size_t* pHeapRequired)\n"
+		"{\n"
+		"\tEgspLoader loader;\n"
+		"\tEgspInitLoader(&loader, 0, 0);\n"
+		"\tloader.pData = pData;\n"
+		"\tloader.blockSize = size;\n"
+		"\tEGSP_TRY(EgspSave%sEx(&loader, pVal));\n"
+		"\t*pWritten = loader.offset;\n"
 		"\t*pHeapRequired = loader.heapSize;\n"
 		"\treturn EGSP_SUCCESS;\n"
 		"}\n\n"
-		, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
+		, pName, pName, pName, pName, pName, pName, pName, pName, pName, pName, pName);
+
+	//Measurer
+	s_buffers.pMeasure += sprintf(s_buffers.pMeasure, "}\n\n"
+		"static inline size_t EgspMeasure%sEx(EgspLoader* pLoader, %s* pVal)\n"
+		"{\n"
+		"\tpLoader->heapSize = 0;\n"
+		"\tpLoader->offset = 0;\n"
+		"\tpLoader->measured = 0;\n"
+		"\tif (pLoader->flags & EGSP_FLAG_ENVELOPE)\n"
+		"\t{\n"
+		"\t\t_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);\n"
+		"\t}\n"
+		"\t_EgspMeasure%s(pLoader, pVal);\n"
+		"\treturn pLoader->measured + pLoader->offset;\n"
+		"}\n\n"
+		"static inline size_t EgspMeasure%s(%s* pVal, size_t* pHeapRequired)\n"
+		"{\n"
+		"\tEgspLoader loader;\n"
+		"\tEgspInitLoader(&loader, 0, 0);\n"
+		"\tsize_t size = EgspMeasure%sEx(&loader, pVal);\n"
+		"\t*pHeapRequired = loader.heapSize;\n"
+		"\treturn size;\n"
+		"}\n\n"
+		, pName, pName, pName, pName, pName, pName);
 
+	// Save measures enveloped streams first
 	fputs(s_buffers.pBase, s_pCode);
+	fputs(s_buffers.pBase + EGSP_BUFFER_SIZE * 2, s_pCode);
 	fputs(s_buffers.pBase + EGSP_BUFFER_SIZE, s_pCode);
 
+	WriteTables(pName, index);
+
 #ifdef EGSP_JSON
 	//Printer
+	s_buffers.pPrint += sprintf(s_buffers.pPrint, "\tEGSP_TRY(_EgspWriteString(pLoader, \"},\"));\n");
+	s_buffers.pPrint += StatsEnd(s_buffers.pPrint, index, pName);
 	s_buffers.pPrint += sprintf(s_buffers.pPrint, 
-		"\treturn _EgspWriteString(pLoader, \"},\");\n"
+		"\treturn EGSP_SUCCESS;\n"
+		"}\n\n"
+		"static inline EgspResult EgspPrint%sEx(EgspLoader* pLoader, %s* pVal)\n"
+		"{\n"
+		"\tpLoader->heapSize = 0;\n"
+		"\tEGSP_TRY(EgspBegin(pLoader));\n"
+		"\tEGSP_TRY(_EgspPrint%s(pLoader, pVal));\n"
+		"\treturn EgspFlush(pLoader);\n"
 		"}\n\n"
-		"static EgspResult EgspPrint%s(EgspFunc pFlushFunc, %s* pVal, size_t* pHeapRequired)\n"
+		"static inline EgspResult EgspPrint%s(EgspFunc pFlushFunc, %s* pVal, size_t* pHeapRequired)\n"
 		"{\n"
 		"\tEgspLoader loader;\n"
+		"\tEgspInitLoader(&loader, 0, 0);\n"
 		"\tloader.pFunc = pFlushFunc;\n"
-		"\tloader.offset = 0;\n"
-		"\tloader.heapSize = 0;\n"
-		"\tloader.last = 0;\n"
-		"\tloader.indent = 0;\n"
-		"\tEGSP_TEST(loader.pData = loader.pFunc(EgspBlockSize()));\n"
-		"\tEGSP_TRY(_EgspPrint%s(&loader, pVal));\n"
-		"\tEGSP_TRY(EgspFlush(&loader));\n"
+		"\tEGSP_TRY(EgspPrint%sEx(&loader, pVal));\n"
 		"\t*pHeapRequired = loader.heapSize;\n"
 		"\treturn EGSP_SUCCESS;\n"
 		"}\n\n"
-		, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
+		, pName, pName, pName, pName, pName, pName);
 
+	s_buffers.pRead += StatsEnd(s_buffers.pRead, index, pName);
 	s_buffers.pRead += sprintf(s_buffers.pRead, "\treturn EGSP_SUCCESS;\n}\n\n"
-		"static EgspResult EgspRead%s(EgspFunc pLoadFunc, %s* pVal, void* pHeap, size_t heapSize)\n"
+		"static inline EgspResult EgspRead%sEx(EgspLoader* pLoader, %s* pVal, void* pHeap, size_t heapSize)\n"
+		"{\n"
+		"\tpLoader->pHeap = pHeap;\n"
+		"\tpLoader->heapSize = heapSize;\n"
+		"\tEGSP_TRY(EgspBegin(pLoader));\n"
+		"\treturn _EgspRead%s(pLoader, pVal);\n"
+		"}\n\n"
+		"static inline EgspResult EgspRead%s(EgspFunc pLoadFunc, %s* pVal, void* pHeap, size_t heapSize)\n"
 		"{\n"
 		"\tEgspLoader loader;\n"
+		"\tEgspInitLoader(&loader, 0, 0);\n"
 		"\tloader.pFunc = pLoadFunc;\n"
-		"\tloader.offset = 0;\n"
-		"\tloader.pHeap = pHeap;\n"
-		"\tloader.heapSize = heapSize;\n"
-		"\tEGSP_TEST(loader.pData = loader.pFunc(0));\n"
-		"\tEGSP_TRY(_EgspRead%s(&loader, pVal));\n"
-		"\treturn EGSP_SUCCESS;\n"
+		"\treturn EgspRead%sEx(&loader, pVal, pHeap, heapSize);\n"
 		"}\n\n"
-		, s_fields[STRUCT_NAME], s_fields[STRUCT_NAME], s_fields[STRUCT_NAME]);
+		, pName, pName, pName, pName, pName, pName);
 
-	fputs(s_buffers.pBase + EGSP_BUFFER_SIZE * 2, s_pCode);
-	fputs(s_buffers.pBase + EGSP_BUFFER_SIZE * 3, s_pCode);
+	fputs(s_buffers.pBase + EGSP_BUFFER_SIZE * 4, s_pCode);
+	fputs(s_buffers.pBase + EGSP_BUFFER_SIZE * 5, s_pCode);
 #endif
 }
 
+// Describes the field for the table driven code, e.g. EgspPushData
+static void AddTableField()
+{
+	const char* pStruct = s_fields[STRUCT_NAME];
+	const char* pVar = s_fields[VAR_NAME];
+	const char* pKind = "EGSP_KIND_STRUCT";
+	if (s_type == ENUM)
+	{
+		pKind = "EGSP_KIND_ENUM";
+	}
+	else if (PrimitiveSize(s_fields[DATA_TYPE]))
+	{
+		pKind = PrimitiveKind(s_fields[DATA_TYPE]);
+	}
+	else if (strcmp(s_fields[DATA_TYPE], "string") == 0)
+	{
+		pKind = "EGSP_KIND_STRING";
+	}
+	else if (IsRawStruct(s_fields[DATA_TYPE]))
+	{
+		pKind = "EGSP_KIND_RAW";
+	}
+	int nested = strcmp(pKind, "EGSP_KIND_STRUCT") == 0 || strcmp(pKind, "EGSP_KIND_RAW") == 0;
+	s_selfReference |= nested && strcmp(s_fields[DATA_TYPE], pStruct) == 0;
+
+	s_buffers.pTable += sprintf(s_buffers.pTable, "\t{ %s, %s, offsetof(%s, %s), sizeof(%s((%s*)0)->%s), "
+		, pKind, s_type == ARRAY ? "EGSP_SHAPE_ARRAY" : s_type == POINTER ? "EGSP_SHAPE_POINTER" : "EGSP_SHAPE_VALUE"
+		, pStruct, pVar, s_type == DEFAULT || s_type == ENUM ? "" : "*", pStruct, pVar);
+	if (s_type == ARRAY)
+	{
+		s_buffers.pTable += sprintf(s_buffers.pTable, "offsetof(%s, %s), sizeof(((%s*)0)->%s), "
+			, pStruct, s_fields[LIST_SIZE], pStruct, s_fields[LIST_SIZE]);
+	}
+	else
+	{
+		s_buffers.pTable += sprintf(s_buffers.pTable, "0, 0, ");
+	}
+	s_buffers.pTable += sprintf(s_buffers.pTable, "%s%s, \"%s\" },\n", nested ? "&s_egspInfo" : "0", nested ? s_fields[DATA_TYPE] : "", pVar);
+	ErrorCheck(s_fieldCount == EGSP_MAX_FIELDS, "Too many fields");
+	strcpy(s_fieldNames[s_fieldCount++], pVar);
+}
+
+static void AddRawField()
+{
+	int size = PrimitiveSize(s_fields[DATA_TYPE]);
+	ErrorCheck(s_type != DEFAULT || size == 0, "Raw structs may only hold fixed width types");
+
+	s_buffers.pLoad += sprintf(s_buffers.pLoad,
+		"EGSP_STATIC_ASSERT(offsetof(%s, %s) == %d, %s_%s);\n"
+		, s_fields[STRUCT_NAME], s_fields[VAR_NAME], s_rawSize, s_fields[STRUCT_NAME], s_fields[VAR_NAME]);
+	sprintf(s_rawLayout + strlen(s_rawLayout), "%d, ", size);
+	s_rawSize += size;
+}
+
 static void AddField()
 {
+	if (s_raw)
+	{
+		AddRawField();
+	}
+
+	// Enums are stored as int32_t whatever their type
+	static const char* s_kinds[] = { "[", "*", "%", "" };
+	HashString(s_kinds[s_type]);
+	HashType(s_type == ENUM ? "int32_t" : s_fields[DATA_TYPE]);
+	if (s_type == ARRAY)
+	{
+		HashCount();
+	}
+
+	// Fixed width fields gather in a run, their usual calls going to its slow path
+	int fixedSize = s_raw ? 0 : FixedSize();
+	char** ppLoad = fixedSize ? &s_run.pLoad : &s_buffers.pLoad;
+	char** ppSave = fixedSize ? &s_run.pSave : &s_buffers.pSave;
+	AddTableField();
+	if (!s_raw)
+	{
+		if (!fixedSize)
+		{
+			FlushRun();
+			s_whole.fixed = 0;
+		}
+	}
+
 	switch (s_type)
 	{
 	case ARRAY:
-		s_buffers.pLoad += sprintf(s_buffers.pLoad, 
-			"\tif (pVal->%s = EgspAlloc(pLoader, EgspPad(sizeof(%s)) * pVal->%s))\n"
-			"\t{\n"
-			"\t\tfor (size_t i = 0; i < pVal->%s; ++i)\n"
-			"\t\t{\n"
-			"\t\t\tEGSP_TRY(_EgspLoad%s(pLoader, pVal->%s + i));\n"
-			"\t\t}\n"
-			"\t}\n"
-			, s_fields[VAR_NAME], s_fields[DATA_TYPE], s_fields[LIST_SIZE], s_fields[LIST_SIZE]
-			, s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+		if (PrimitiveSize(s_fields[DATA_TYPE]))
+		{
+			s_buffers.pLoad += sprintf(s_buffers.pLoad,
+				"\tif ((pVal->%s = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->%s) * pVal->%s))))\n"
+				"\t{\n"
+				"\t\tEGSP_TRY(_EgspLoadArray(pLoader, (void*)pVal->%s, pVal->%s, sizeof(*pVal->%s), %s));\n"
+				"\t}\n"
+				, s_fields[VAR_NAME], s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[VAR_NAME]
+				, s_fields[LIST_SIZE], s_fields[VAR_NAME], PrimitiveKind(s_fields[DATA_TYPE]));
 
-		s_buffers.pSave += sprintf(s_buffers.pSave, 
-			"\tpLoader->heapSize += EgspPad(sizeof(*pVal->%s)) * pVal->%s;\n"
-			"\tfor (size_t i = 0; i < pVal->%s; ++i)\n"
-			"\t{\n"
-			"\t\tEGSP_TRY(_EgspSave%s(pLoader, pVal->%s + i));\n"
-			"\t}\n"
-			, s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[LIST_SIZE], s_fields[DATA_TYPE]
-			, s_fields[VAR_NAME]);
+			s_buffers.pSave += sprintf(s_buffers.pSave,
+				"\tpLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->%s) * pVal->%s);\n"
+				"\tEGSP_TRY(_EgspSaveArray(pLoader, pVal->%s, pVal->%s, sizeof(*pVal->%s), %s));\n"
+				, s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[VAR_NAME], s_fields[LIST_SIZE]
+				, s_fields[VAR_NAME], PrimitiveKind(s_fields[DATA_TYPE]));
+
+			s_buffers.pMeasure += sprintf(s_buffers.pMeasure,
+				"\tpLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->%s) * pVal->%s);\n"
+				"\t_EgspMeasureArray(pLoader, pVal->%s, pVal->%s, sizeof(*pVal->%s), %s);\n"
+				, s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[VAR_NAME], s_fields[LIST_SIZE]
+				, s_fields[VAR_NAME], PrimitiveKind(s_fields[DATA_TYPE]));
 #ifdef EGSP_JSON
+			s_buffers.pPrint += sprintf(s_buffers.pPrint,
+				"\tpLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->%s) * pVal->%s);\n"
+				, s_fields[VAR_NAME], s_fields[LIST_SIZE]);
+			s_buffers.pPrint += PrintLabel(s_buffers.pPrint, "\t", s_fields[VAR_NAME], "");
+			s_buffers.pPrint += sprintf(s_buffers.pPrint,
+				"\tEGSP_TRY(_EgspWriteString(pLoader, \"[\"));\n"
+				"\tfor (size_t i = 0; i < pVal->%s; ++i)\n"
+				"\t{\n"
+				"\t\tEGSP_TRY(_EgspPrint%s(pLoader, (%s*)pVal->%s + i));\n"
+				"\t}\n"
+				"\tEGSP_TRY(_EgspWriteString(pLoader, \"],\"));\n"
+				, s_fields[LIST_SIZE], s_fields[DATA_TYPE], s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+
+			s_buffers.pRead += sprintf(s_buffers.pRead,
+				"\tif ((pVal->%s = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->%s) * pVal->%s))))\n"
+				"\t{\n"
+				"\t\tEGSP_TRY(_EgspSkipLabel(pLoader));\n"
+				"\t\tEGSP_TRY(_EgspSkipList(pLoader));\n"
+				"\t\tfor (size_t i = 0; i < pVal->%s; ++i)\n"
+				"\t\t{\n"
+				"\t\t\tEGSP_TRY(_EgspRead%s(pLoader, (%s*)pVal->%s + i));\n"
+				"\t\t}\n"
+				"\t}\n"
+				, s_fields[VAR_NAME], s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[LIST_SIZE]
+				, s_fields[DATA_TYPE], s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+#endif
+			break;
+		}
+
+		if (IsRawStruct(s_fields[DATA_TYPE]))
+		{
+			// One copy for the whole array
+			s_buffers.pLoad += sprintf(s_buffers.pLoad,
+				"\tif ((pVal->%s = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->%s)) * pVal->%s)))\n"
+				"\t{\n"
+				"\t\tEGSP_TRY(_EgspLoadRaw(pLoader, pVal->%s, pVal->%s, sizeof(*pVal->%s), s_egspLayout%s));\n"
+				"\t}\n"
+				, s_fields[VAR_NAME], s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[VAR_NAME]
+				, s_fields[LIST_SIZE], s_fields[VAR_NAME], s_fields[DATA_TYPE]);
+
+			s_buffers.pSave += sprintf(s_buffers.pSave,
+				"\tpLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->%s)) * pVal->%s;\n"
+				"\tEGSP_TRY(_EgspSaveRaw(pLoader, pVal->%s, pVal->%s, sizeof(*pVal->%s), s_egspLayout%s));\n"
+				, s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[VAR_NAME], s_fields[LIST_SIZE]
+				, s_fields[VAR_NAME], s_fields[DATA_TYPE]);
+
+			s_buffers.pMeasure += sprintf(s_buffers.pMeasure,
+				"\tpLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->%s)) * pVal->%s;\n"
+				"\t_EgspMeasureBytes(pLoader, sizeof(*pVal->%s) * pVal->%s);\n"
+				, s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[VAR_NAME], s_fields[LIST_SIZE]);
+		}
+		else
+		{
+			s_buffers.pLoad += sprintf(s_buffers.pLoad, 
+				"\tif ((pVal->%s = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->%s)) * pVal->%s)))\n"
+				"\t{\n"
+				"\t\tfor (size_t i = 0; i < pVal->%s; ++i)\n"
+				"\t\t{\n"
+				"\t\t\tEGSP_TRY(_EgspLoad%s(pLoader, pVal->%s + i));\n"
+				"\t\t}\n"
+				"\t}\n"
+				, s_fields[VAR_NAME], s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[LIST_SIZE]
+				, s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+
+			// Long arrays are split up between the worker threads of the loader's pool, if it has one
+			if (!s_tables)
+			{
+				WriteSaveElement(s_fields[DATA_TYPE]);
+			}
+			s_buffers.pSave += sprintf(s_buffers.pSave, 
+				"\tpLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->%s)) * pVal->%s;\n"
+				"\tif (_EgspParallel(pLoader, pVal->%s))\n"
+				"\t{\n"
+				"\t\tEGSP_TRY(_EgspSaveArrayParallel(pLoader, pVal->%s, pVal->%s, sizeof(*pVal->%s), _EgspSaveElement%s));\n"
+				"\t}\n"
+				"\telse\n"
+				"\t{\n"
+				"\t\tfor (size_t i = 0; i < pVal->%s; ++i)\n"
+				"\t\t{\n"
+				"\t\t\tEGSP_TRY(_EgspSave%s(pLoader, pVal->%s + i));\n"
+				"\t\t}\n"
+				"\t}\n"
+				, s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[LIST_SIZE], s_fields[VAR_NAME]
+				, s_fields[LIST_SIZE], s_fields[VAR_NAME], s_fields[DATA_TYPE], s_fields[LIST_SIZE]
+				, s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+
+			s_buffers.pMeasure += sprintf(s_buffers.pMeasure,
+				"\tpLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->%s)) * pVal->%s;\n"
+				"\tfor (size_t i = 0; i < pVal->%s; ++i)\n"
+				"\t{\n"
+				"\t\t_EgspMeasure%s(pLoader, pVal->%s + i);\n"
+				"\t}\n"
+				, s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[LIST_SIZE], s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+		}
+#ifdef EGSP_JSON
+		s_buffers.pPrint += sprintf(s_buffers.pPrint, 
+			"\tpLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->%s)) * pVal->%s;\n"
+			, s_fields[VAR_NAME], s_fields[LIST_SIZE]);
+		s_buffers.pPrint += PrintLabel(s_buffers.pPrint, "\t", s_fields[VAR_NAME], "");
 		s_buffers.pPrint += sprintf(s_buffers.pPrint, 
-			"\tpLoader->heapSize += EgspPad(sizeof(*pVal->%s)) * pVal->%s;\n"
-			"\tEGSP_TRY(_EgspWriteString(pLoader, \"\\\"%s\\\":[\"));\n"
+			"\tEGSP_TRY(_EgspWriteString(pLoader, \"[\"));\n"
 			"\tfor (size_t i = 0; i < pVal->%s; ++i)\n"
 			"\t{\n"
 			"\t\tEGSP_TRY(_EgspPrint%s(pLoader, pVal->%s + i));\n"
 			"\t}\n"
 			"\tEGSP_TRY(_EgspWriteString(pLoader, \"],\"))\n"
-			, s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[VAR_NAME], s_fields[LIST_SIZE]
-			, s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+			, s_fields[LIST_SIZE], s_fields[DATA_TYPE], s_fields[VAR_NAME]);
 
 		s_buffers.pRead += sprintf(s_buffers.pRead,
-			"\tif (pVal->%s = EgspAlloc(pLoader, EgspPad(sizeof(%s)) * pVal->%s))\n"
+			"\tif ((pVal->%s = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->%s)) * pVal->%s)))\n"
 			"\t{\n"
 			"\t\tEGSP_TRY(_EgspSkipLabel(pLoader));\n"
 			"\t\tfor (size_t i = 0; i < pVal->%s; ++i)\n"
@@ -203,17 +898,26 @@ static void AddField()
 			"\t\t\tEGSP_TRY(_EgspRead%s(pLoader, pVal->%s + i));\n"
 			"\t\t}\n"
 			"\t}\n"
-			, s_fields[VAR_NAME], s_fields[DATA_TYPE], s_fields[LIST_SIZE], s_fields[LIST_SIZE]
+			, s_fields[VAR_NAME], s_fields[VAR_NAME], s_fields[LIST_SIZE], s_fields[LIST_SIZE]
 			, s_fields[DATA_TYPE], s_fields[VAR_NAME]);
 #endif
 		break;
 
 	case POINTER:
+		// Declared with the first pointer, so structs without any do not get an unused variable
+		if (!s_nullCheck)
+		{
+			s_buffers.pLoad += sprintf(s_buffers.pLoad, "\tuint8_t egspNullCheck = 0;\n");
+#ifdef EGSP_JSON
+			s_buffers.pRead += sprintf(s_buffers.pRead, "\tuint8_t egspNullCheck = 0;\n");
+#endif
+			s_nullCheck = 1;
+		}
 		s_buffers.pLoad += sprintf(s_buffers.pLoad,
 			"\tEGSP_TRY(_EgspLoaduint8_t(pLoader, &egspNullCheck));\n"
 			"\tif (egspNullCheck)\n"
 			"\t{\n"
-			"\t\tEGSP_TEST(pVal->%s = EgspAlloc(pLoader, EgspPad(sizeof(%s))))\n"
+			"\t\tEGSP_TEST(pVal->%s = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(%s))))\n"
 			"\t\tEGSP_TRY(_EgspLoad%s(pLoader, pVal->%s));\n"
 			"\t}\n"
 			"\telse\n"
@@ -225,7 +929,7 @@ static void AddField()
 		s_buffers.pSave += sprintf(s_buffers.pSave,
 			"\tif (pVal->%s)\n"
 			"\t{\n"
-			"\t\tpLoader->heapSize += EgspPad(sizeof(*pVal->%s));\n"
+			"\t\tpLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->%s));\n"
 			"\t\tuint8_t nullInd = 1;\n"
 			"\t\tEGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));\n"
 			"\t\tEGSP_TRY(_EgspSave%s(pLoader, pVal->%s));\n"
@@ -236,32 +940,43 @@ static void AddField()
 			"\t\tEGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));\n"
 			"\t}\n"
 			, s_fields[VAR_NAME], s_fields[VAR_NAME], s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+
+		s_buffers.pMeasure += sprintf(s_buffers.pMeasure,
+			"\t_EgspMeasureBytes(pLoader, sizeof(uint8_t));\n"
+			"\tif (pVal->%s)\n"
+			"\t{\n"
+			"\t\tpLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->%s));\n"
+			"\t\t_EgspMeasure%s(pLoader, pVal->%s);\n"
+			"\t}\n"
+			, s_fields[VAR_NAME], s_fields[VAR_NAME], s_fields[DATA_TYPE], s_fields[VAR_NAME]);
 #ifdef EGSP_JSON
 		s_buffers.pPrint += sprintf(s_buffers.pPrint,
 			"\tif (pVal->%s)\n"
 			"\t{\n"
-			"\t\tpLoader->heapSize += EgspPad(sizeof(*pVal->%s));\n"
+			"\t\tpLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->%s));\n"
 			"\t\tuint8_t nullInd = 1;\n"
-			"\t\tEGSP_TRY(_EgspWriteString(pLoader, \"\\\"%s is not null. Processing\\\":\"));\n"
-			"\t\tEGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));\n"
-			"\t\tEGSP_TRY(_EgspWriteString(pLoader, \"\\\"%s\\\":\"));\n"
+			, s_fields[VAR_NAME], s_fields[VAR_NAME]);
+		s_buffers.pPrint += PrintLabel(s_buffers.pPrint, "\t\t", s_fields[VAR_NAME], " is not null. Processing");
+		s_buffers.pPrint += sprintf(s_buffers.pPrint, "\t\tEGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));\n");
+		s_buffers.pPrint += PrintLabel(s_buffers.pPrint, "\t\t", s_fields[VAR_NAME], "");
+		s_buffers.pPrint += sprintf(s_buffers.pPrint,
 			"\t\tEGSP_TRY(_EgspPrint%s(pLoader, pVal->%s))\n"
 			"\t}\n"
 			"\telse\n"
 			"\t{\n"
 			"\t\tuint8_t nullInd = 0;\n"
-			"\t\tEGSP_TRY(_EgspWriteString(pLoader, \"\\\"%s is null. Skipping.\\\":\"));\n"
+			, s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+		s_buffers.pPrint += PrintLabel(s_buffers.pPrint, "\t\t", s_fields[VAR_NAME], " is null. Skipping.");
+		s_buffers.pPrint += sprintf(s_buffers.pPrint,
 			"\t\tEGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));\n"
-			"\t}\n"
-			, s_fields[VAR_NAME], s_fields[VAR_NAME], s_fields[VAR_NAME], s_fields[VAR_NAME], s_fields[DATA_TYPE]
-			, s_fields[VAR_NAME], s_fields[VAR_NAME]);
+			"\t}\n");
 
 		s_buffers.pRead += sprintf(s_buffers.pRead,
 			"\tEGSP_TRY(_EgspSkipLabel(pLoader));\n"
 			"\tEGSP_TRY(_EgspReaduint8_t(pLoader, &egspNullCheck));\n"
 			"\tif (egspNullCheck)\n"
 			"\t{\n"
-			"\t\tEGSP_TEST(pVal->%s = EgspAlloc(pLoader, EgspPad(sizeof(%s))))\n"
+			"\t\tEGSP_TEST(pVal->%s = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(%s))))\n"
 			"\t\tEGSP_TRY(_EgspSkipLabel(pLoader));\n"
 			"\t\tEGSP_TRY(_EgspRead%s(pLoader, pVal->%s));\n"
 			"\t}\n"
@@ -274,27 +989,34 @@ static void AddField()
 		break;
 
 	case ENUM:
-		s_buffers.pLoad += sprintf(s_buffers.pLoad,
+		*ppLoad += sprintf(*ppLoad,
 			"\t{\n"
 			"\t\tint32_t enumval = 0;\n"
 			"\t\tEGSP_TRY(_EgspLoadint32_t(pLoader, &enumval));\n"
 			"\t\tpVal->%s = (%s) enumval;\n"
 			"\t}\n"
 			, s_fields[VAR_NAME], s_fields[DATA_TYPE]);
-		s_buffers.pSave += sprintf(s_buffers.pSave, 
+		*ppSave += sprintf(*ppSave, 
 			"\t{\n"
 			"\t\tint32_t enumval = pVal->%s;\n"
 			"\tEGSP_TRY(_EgspSaveint32_t(pLoader, &enumval));\n"
 			"\t}\n"
 			, s_fields[VAR_NAME]), s_fields[DATA_TYPE];
+		s_buffers.pMeasure += sprintf(s_buffers.pMeasure,
+			"\t{\n"
+			"\t\tint32_t enumval = pVal->%s;\n"
+			"\t\t_EgspMeasureint32_t(pLoader, &enumval);\n"
+			"\t}\n"
+			, s_fields[VAR_NAME]);
 #ifdef EGSP_JSON
 		s_buffers.pPrint += sprintf(s_buffers.pPrint,
 			"\t{\n"
 			"\t\tint32_t enumval = pVal->%s;\n"
-			"\t\tEGSP_TRY(_EgspWriteString(pLoader, \"\\\"%s\\\":\"));\n"
+			, s_fields[VAR_NAME]);
+		s_buffers.pPrint += PrintLabel(s_buffers.pPrint, "\t\t", s_fields[VAR_NAME], "");
+		s_buffers.pPrint += sprintf(s_buffers.pPrint,
 			"\t\tEGSP_TRY(_EgspPrintint32_t(pLoader, &enumval));\n"
-			"\t}\n"
-			, s_fields[VAR_NAME], s_fields[VAR_NAME]);
+			"\t}\n");
 		s_buffers.pRead += sprintf(s_buffers.pRead,
 			"\t{\n"
 			"\t\tint32_t enumval = 0;\n"
@@ -307,19 +1029,27 @@ static void AddField()
 		break;
 
 	case DEFAULT:
-		s_buffers.pLoad += sprintf(s_buffers.pLoad, "\tEGSP_TRY(_EgspLoad%s(pLoader, &pVal->%s));\n", s_fields[DATA_TYPE], s_fields[VAR_NAME]);
-		s_buffers.pSave += sprintf(s_buffers.pSave, "\tEGSP_TRY(_EgspSave%s(pLoader, &pVal->%s));\n", s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+		if (!s_raw)
+		{
+			*ppLoad += sprintf(*ppLoad, "\tEGSP_TRY(_EgspLoad%s(pLoader, &pVal->%s));\n", s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+			*ppSave += sprintf(*ppSave, "\tEGSP_TRY(_EgspSave%s(pLoader, &pVal->%s));\n", s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+			s_buffers.pMeasure += sprintf(s_buffers.pMeasure, "\t_EgspMeasure%s(pLoader, &pVal->%s);\n", s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+		}
 #ifdef EGSP_JSON
+		s_buffers.pPrint += PrintLabel(s_buffers.pPrint, "\t", s_fields[VAR_NAME], "");
 		s_buffers.pPrint += sprintf(s_buffers.pPrint, 
-			"\tEGSP_TRY(_EgspWriteString(pLoader, \"\\\"%s\\\":\"));\n"
 			"\tEGSP_TRY(_EgspPrint%s(pLoader, &pVal->%s));\n"
-			, s_fields[VAR_NAME], s_fields[DATA_TYPE], s_fields[VAR_NAME]);
+			, s_fields[DATA_TYPE], s_fields[VAR_NAME]);
 		s_buffers.pRead += sprintf(s_buffers.pRead, 
 			"\tEGSP_TRY(_EgspSkipLabel(pLoader));\n"
 			"\tEGSP_TRY(_EgspRead%s(pLoader, &pVal->%s));\n"
 			, s_fields[DATA_TYPE], s_fields[VAR_NAME]);
 #endif
 	}
+	if (fixedSize)
+	{
+		AddRunField(fixedSize);
+	}
 	s_type = DEFAULT;
 }
 
@@ -330,6 +1060,13 @@ static int ProcessStructName(char chr)
 		return STRUCT_NAME;
 	}
 
+	if (chr == '!')
+	{
+		ErrorCheck(s_curpos == 0, "Expecting struct name");
+		s_raw = 1;
+		return STRUCT_NAME;
+	}
+
 	if (chr == '{')
 	{
 		ErrorCheck(s_curpos == 0, "Expecting struct name");
@@ -483,9 +1220,9 @@ static int LoadSchema(const char* filename)
 int main(int argc, char** argv)
 {
 #ifdef EGSP_JSON
-	s_buffers.pBase = (char*)malloc(EGSP_BUFFER_SIZE * 4);
+	s_buffers.pBase = (char*)malloc(EGSP_BUFFER_SIZE * 6);
 #else
-	s_buffers.pBase = (char*)malloc(EGSP_BUFFER_SIZE * 2);
+	s_buffers.pBase = (char*)malloc(EGSP_BUFFER_SIZE * 4);
 #endif
 
 	if (s_pCode = fopen("egspload.h", "w"))
@@ -495,6 +1232,11 @@ int main(int argc, char** argv)
 
 		for (int i = 1; i < argc; ++i)
 		{
+			if (strcmp(argv[i], "--tables") == 0)
+			{
+				s_tables = 1;
+				continue;
+			}
 			if (LoadSchema(argv[i]) != 0)
 			{
 				fprintf(stderr, "Error Loading %s\n", argv[i]);
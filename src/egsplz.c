@@ -0,0 +1,345 @@
+#include "egsplz.h"
+#include <string.h>
+
+#define EGSP_LZ_HASH_BITS 14
+#define EGSP_LZ_MIN_MATCH 4
+#define EGSP_LZ_WINDOW 65535
+#define EGSP_LZ_HEADER_SIZE 8
+
+size_t EgspLzMemory(size_t blockSize)
+{
+	return sizeof(uint32_t) * (((size_t)1 << EGSP_LZ_HASH_BITS) + blockSize) + 2 * blockSize;
+}
+
+static uint32_t Hash(const uint8_t* pData)
+{
+	uint32_t val;
+	memcpy(&val, pData, 4);
+	return (val * 2654435761u) >> (32 - EGSP_LZ_HASH_BITS);
+}
+
+static void PutBig32(uint8_t* pDst, size_t val)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		pDst[i] = (uint8_t)(val >> (24 - 8 * i));
+	}
+}
+
+static size_t GetBig32(const uint8_t* pSrc)
+{
+	return ((size_t)pSrc[0] << 24) | ((size_t)pSrc[1] << 16) | ((size_t)pSrc[2] << 8) | pSrc[3];
+}
+
+// How many bytes at pA and pB agree, up to limit
+static size_t MatchLength(const uint8_t* pA, const uint8_t* pB, size_t limit)
+{
+	size_t length = 0;
+#if defined(__GNUC__) && !(defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	while (length + 8 <= limit)
+	{
+		uint64_t a, b;
+		memcpy(&a, pA + length, 8);
+		memcpy(&b, pB + length, 8);
+		if (a != b)
+		{
+			return length + (__builtin_ctzll(a ^ b) >> 3);
+		}
+		length += 8;
+	}
+#endif
+	while (length < limit && pA[length] == pB[length])
+	{
+		++length;
+	}
+	return length;
+}
+
+// Lengths that do not fit in their 4 bits of the token carry on in bytes of 255 and a last smaller one
+static uint8_t* PutLength(uint8_t* pDst, size_t length)
+{
+	for (; length >= 255; length -= 255)
+	{
+		*pDst++ = 255;
+	}
+	*pDst++ = (uint8_t)length;
+	return pDst;
+}
+
+static EgspResult GetLength(const uint8_t** ppSrc, const uint8_t* pEnd, size_t* pLength)
+{
+	uint8_t byte = 255;
+	while (byte == 255)
+	{
+		EGSP_TEST(*ppSrc < pEnd);
+		byte = *(*ppSrc)++;
+		*pLength += byte;
+	}
+	return EGSP_SUCCESS;
+}
+
+// Sequences of a token, literals copied as is, then a match with what came before: a 2 byte offset back and
+// a length. The last sequence has only literals. Returns 0 when the result would not be smaller than the block.
+static size_t Compress(EgspLz* pLz, const uint8_t* pSrc, size_t size, uint8_t* pDst)
+{
+	// Positions are numbered on from the last block, so the head table never needs clearing
+	if (pLz->base > UINT32_MAX - size)
+	{
+		memset(pLz->pHead, 0, sizeof(uint32_t) << EGSP_LZ_HASH_BITS);
+		pLz->base = 1;
+	}
+	uint32_t base = pLz->base;
+	pLz->base += (uint32_t)size;
+
+	uint8_t* pOut = pDst;
+	uint8_t* pEnd = pDst + size;
+	size_t anchor = 0;
+	size_t pos = 0;
+	while (pos + EGSP_LZ_MIN_MATCH <= size)
+	{
+		size_t length = 0;
+		size_t offset = 0;
+		uint32_t hash = Hash(pSrc + pos);
+		uint32_t candidate = pLz->pHead[hash];
+		pLz->pHead[hash] = base + (uint32_t)pos;
+		pLz->pPrev[pos] = candidate;
+		for (size_t tries = pLz->depth; tries && candidate >= base; --tries)
+		{
+			size_t at = candidate - base;
+			if (pos - at > EGSP_LZ_WINDOW)
+			{
+				break;
+			}
+			size_t run = MatchLength(pSrc + at, pSrc + pos, size - pos);
+			if (run > length)
+			{
+				length = run;
+				offset = pos - at;
+			}
+			candidate = pLz->pPrev[at];
+		}
+
+		if (length < EGSP_LZ_MIN_MATCH)
+		{
+			// The fast setting skips ahead quicker the longer nothing matches
+			pos += pLz->depth == 1 ? 1 + ((pos - anchor) >> 6) : 1;
+			continue;
+		}
+
+		size_t literals = pos - anchor;
+		size_t extra = length - EGSP_LZ_MIN_MATCH;
+		if ((size_t)(pEnd - pOut) <= literals + literals / 255 + extra / 255 + 5)
+		{
+			return 0;
+		}
+		*pOut++ = (uint8_t)(((literals < 15 ? literals : 15) << 4) | (extra < 15 ? extra : 15));
+		if (literals >= 15)
+		{
+			pOut = PutLength(pOut, literals - 15);
+		}
+		memcpy(pOut, pSrc + anchor, literals);
+		pOut += literals;
+		*pOut++ = (uint8_t)offset;
+		*pOut++ = (uint8_t)(offset >> 8);
+		if (extra >= 15)
+		{
+			pOut = PutLength(pOut, extra - 15);
+		}
+
+		// Deeper searches also remember the positions inside the match
+		if (pLz->depth > 1)
+		{
+			for (size_t p = pos + 1; p < pos + length && p + EGSP_LZ_MIN_MATCH <= size; ++p)
+			{
+				hash = Hash(pSrc + p);
+				pLz->pPrev[p] = pLz->pHead[hash];
+				pLz->pHead[hash] = base + (uint32_t)p;
+			}
+		}
+		pos += length;
+		anchor = pos;
+	}
+
+	size_t literals = size - anchor;
+	if ((size_t)(pEnd - pOut) <= literals + literals / 255 + 2)
+	{
+		return 0;
+	}
+	*pOut++ = (uint8_t)((literals < 15 ? literals : 15) << 4);
+	if (literals >= 15)
+	{
+		pOut = PutLength(pOut, literals - 15);
+	}
+	memcpy(pOut, pSrc + anchor, literals);
+	return pOut + literals - pDst;
+}
+
+// Checks every length and offset against both buffers, since the frame may come from anywhere
+static EgspResult Decompress(const uint8_t* pSrc, size_t size, uint8_t* pDst, size_t rawSize)
+{
+	const uint8_t* pEnd = pSrc + size;
+	size_t out = 0;
+	while (1)
+	{
+		EGSP_TEST(pSrc < pEnd);
+		uint8_t token = *pSrc++;
+		size_t literals = token >> 4;
+		if (literals == 15)
+		{
+			EGSP_TRY(GetLength(&pSrc, pEnd, &literals));
+		}
+		EGSP_TEST(literals <= (size_t)(pEnd - pSrc) && literals <= rawSize - out);
+		memcpy(pDst + out, pSrc, literals);
+		pSrc += literals;
+		out += literals;
+		if (pSrc == pEnd)
+		{
+			break;
+		}
+
+		EGSP_TEST(pEnd - pSrc >= 2);
+		size_t offset = pSrc[0] | ((size_t)pSrc[1] << 8);
+		pSrc += 2;
+		size_t length = token & 15;
+		if (length == 15)
+		{
+			EGSP_TRY(GetLength(&pSrc, pEnd, &length));
+		}
+		length += EGSP_LZ_MIN_MATCH;
+		EGSP_TEST(offset && offset <= out && length <= rawSize - out);
+
+		// Matches closer than their length repeat what they are copying as they go
+		if (offset >= length)
+		{
+			memcpy(pDst + out, pDst + out - offset, length);
+		}
+		else
+		{
+			for (size_t i = 0; i < length; ++i)
+			{
+				pDst[out + i] = pDst[out + i - offset];
+			}
+		}
+		out += length;
+	}
+	EGSP_TEST(out == rawSize);
+	return EGSP_SUCCESS;
+}
+
+// Copies to or from the inner stream, moving on to the next inner block whenever one is used up
+static EgspResult Transfer(EgspLz* pLz, uint8_t* pData, size_t size)
+{
+	while (size)
+	{
+		if (pLz->pos == pLz->innerBlockSize)
+		{
+			EGSP_TEST(pLz->pInner = pLz->pFunc(pLz->pUser, pLz->pos));
+			pLz->pos = 0;
+		}
+		size_t run = pLz->innerBlockSize - pLz->pos;
+		run = run < size ? run : size;
+		if (pLz->writing)
+		{
+			memcpy(pLz->pInner + pLz->pos, pData, run);
+		}
+		else
+		{
+			memcpy(pData, pLz->pInner + pLz->pos, run);
+		}
+		pLz->pos += run;
+		pData += run;
+		size -= run;
+	}
+	return EGSP_SUCCESS;
+}
+
+static EgspResult WriteFrame(EgspLz* pLz, size_t size)
+{
+	size_t packed = Compress(pLz, pLz->pBlock, size, pLz->pFrame);
+	uint8_t header[EGSP_LZ_HEADER_SIZE];
+	PutBig32(header, size);
+	PutBig32(header + 4, packed ? packed : size);
+	pLz->raw += size;
+	pLz->packed += EGSP_LZ_HEADER_SIZE + (packed ? packed : size);
+	EGSP_TRY(Transfer(pLz, header, EGSP_LZ_HEADER_SIZE));
+	return Transfer(pLz, packed ? pLz->pFrame : pLz->pBlock, packed ? packed : size);
+}
+
+static EgspResult ReadFrame(EgspLz* pLz)
+{
+	uint8_t header[EGSP_LZ_HEADER_SIZE];
+	EGSP_TRY(Transfer(pLz, header, EGSP_LZ_HEADER_SIZE));
+	size_t size = GetBig32(header);
+	size_t packed = GetBig32(header + 4);
+	EGSP_TEST(size <= pLz->blockSize && packed <= size);
+	pLz->raw += size;
+	pLz->packed += EGSP_LZ_HEADER_SIZE + packed;
+
+	// Blocks that did not compress are stored as they are
+	if (packed == size)
+	{
+		return Transfer(pLz, pLz->pBlock, size);
+	}
+	EGSP_TRY(Transfer(pLz, pLz->pFrame, packed));
+	return Decompress(pLz->pFrame, packed, pLz->pBlock, size);
+}
+
+static EgspResult Open(EgspLz* pLz, EgspFuncEx pFunc, void* pUser, size_t innerBlockSize, void* pMemory, size_t blockSize, int writing)
+{
+	EGSP_TEST(innerBlockSize && blockSize && blockSize <= 0x7FFFFFFF);
+	pLz->pFunc = pFunc;
+	pLz->pUser = pUser;
+	pLz->innerBlockSize = innerBlockSize;
+	pLz->writing = writing;
+	pLz->depth = EGSP_LZ_FAST;
+	pLz->blockSize = blockSize;
+	pLz->pHead = (uint32_t*)pMemory;
+	pLz->pPrev = pLz->pHead + ((size_t)1 << EGSP_LZ_HASH_BITS);
+	pLz->pBlock = (uint8_t*)(pLz->pPrev + blockSize);
+	pLz->pFrame = pLz->pBlock + blockSize;
+	pLz->base = 1;
+	pLz->raw = 0;
+	pLz->packed = 0;
+	memset(pLz->pHead, 0, sizeof(uint32_t) << EGSP_LZ_HASH_BITS);
+
+	pLz->pos = 0;
+	EGSP_TEST(pLz->pInner = pFunc(pUser, 0));
+	return EGSP_SUCCESS;
+}
+
+EgspResult EgspLzOpenWriter(EgspLz* pLz, EgspFuncEx pFunc, void* pUser, size_t innerBlockSize, void* pMemory, size_t blockSize, size_t depth)
+{
+	EGSP_TRY(Open(pLz, pFunc, pUser, innerBlockSize, pMemory, blockSize, 1));
+	pLz->depth = depth ? depth : EGSP_LZ_FAST;
+	return EGSP_SUCCESS;
+}
+
+EgspResult EgspLzOpenReader(EgspLz* pLz, EgspFuncEx pFunc, void* pUser, size_t innerBlockSize, void* pMemory, size_t blockSize)
+{
+	return Open(pLz, pFunc, pUser, innerBlockSize, pMemory, blockSize, 0);
+}
+
+EgspResult EgspLzClose(EgspLz* pLz)
+{
+	if (pLz->writing)
+	{
+		EGSP_TEST(pLz->pFunc(pLz->pUser, pLz->pos));
+		pLz->pos = 0;
+	}
+	return EGSP_SUCCESS;
+}
+
+uint8_t* EgspLzFunc(void* pUser, size_t size)
+{
+	EgspLz* pLz = (EgspLz*)pUser;
+	if (pLz->writing)
+	{
+		// Nothing has been written yet when Save starts, and an empty block needs no frame
+		if (size && WriteFrame(pLz, size) == EGSP_FAIL)
+		{
+			return 0;
+		}
+		return pLz->pBlock;
+	}
+	return ReadFrame(pLz) == EGSP_SUCCESS ? pLz->pBlock : 0;
+}
@@ -0,0 +1,52 @@
+#ifndef EGSPLZ_H
+#define EGSPLZ_H
+
+#include "egsplib.h"
+
+// Matches tried at each position. More finds longer matches and compresses better, but slower.
+#define EGSP_LZ_FAST 1
+#define EGSP_LZ_SMALL 64
+
+// Compresses every block Save hands over and passes it on to another block function, and the other way
+// around for Load. Pass EgspLzFunc with the EgspLz as pUser to EgspInitLoader, with the loader's block size
+// set to blockSize. Each block becomes a frame of its own in the inner stream: its size, the size of what
+// follows, then the LZ compressed bytes or the block as is when it does not compress.
+// Loaded blocks are reused, so EGSP_FLAG_ZERO_COPY strings do not survive the next block.
+typedef struct
+{
+	EgspFuncEx pFunc;
+	void* pUser;
+	size_t innerBlockSize;
+	int writing;
+	size_t depth;
+
+	// The inner block being filled or read, and how far into it
+	uint8_t* pInner;
+	size_t pos;
+
+	// The uncompressed block the loader works on, a frame of compressed bytes, and the match finder
+	size_t blockSize;
+	uint8_t* pBlock;
+	uint8_t* pFrame;
+	uint32_t* pHead;
+	uint32_t* pPrev;
+	uint32_t base;
+
+	// Bytes handed over by the loader, and bytes sent on to pFunc
+	uint64_t raw;
+	uint64_t packed;
+} EgspLz;
+
+// Bytes of memory to hand to EgspLzOpen* for loader blocks of blockSize
+size_t EgspLzMemory(size_t blockSize);
+
+// pFunc and pUser are the inner block function, which hands out blocks of innerBlockSize.
+// depth is EGSP_LZ_FAST, EGSP_LZ_SMALL or anything in between.
+EgspResult EgspLzOpenWriter(EgspLz* pLz, EgspFuncEx pFunc, void* pUser, size_t innerBlockSize, void* pMemory, size_t blockSize, size_t depth);
+EgspResult EgspLzOpenReader(EgspLz* pLz, EgspFuncEx pFunc, void* pUser, size_t innerBlockSize, void* pMemory, size_t blockSize);
+
+// Hands the last inner block over to the inner block function when writing
+EgspResult EgspLzClose(EgspLz* pLz);
+uint8_t* EgspLzFunc(void* pUser, size_t size);
+
+#endif
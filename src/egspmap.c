@@ -0,0 +1,183 @@
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+#include "egspmap.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#define EGSP_MAP_MIN_SIZE (1 << 20)
+
+static EgspMap* s_pMap = 0;
+
+static size_t RoundToPage(size_t bytes)
+{
+	size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	return (bytes + page - 1) / page * page;
+}
+
+EgspResult EgspMapOpenRead(EgspMap* pMap, const char* pPath, size_t blockSize)
+{
+	struct stat info;
+	pMap->blockSize = blockSize;
+	pMap->writing = 0;
+	pMap->pos = 0;
+	EGSP_TEST((pMap->fd = open(pPath, O_RDONLY)) >= 0);
+	if (fstat(pMap->fd, &info) != 0)
+	{
+		close(pMap->fd);
+		return EGSP_FAIL;
+	}
+	pMap->length = (size_t)info.st_size;
+
+	// Keep a block worth of zeros mapped past the end, so that the last block can be handed out whole
+	pMap->mapped = RoundToPage(pMap->length + pMap->blockSize);
+	pMap->pBase = mmap(0, pMap->mapped, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (pMap->pBase == MAP_FAILED)
+	{
+		close(pMap->fd);
+		return EGSP_FAIL;
+	}
+	if (pMap->length && mmap(pMap->pBase, pMap->length, PROT_READ, MAP_PRIVATE | MAP_FIXED, pMap->fd, 0) == MAP_FAILED)
+	{
+		munmap(pMap->pBase, pMap->mapped);
+		close(pMap->fd);
+		return EGSP_FAIL;
+	}
+	madvise(pMap->pBase, pMap->mapped, MADV_SEQUENTIAL);
+	return EGSP_SUCCESS;
+}
+
+EgspResult EgspMapOpenWrite(EgspMap* pMap, const char* pPath, size_t blockSize)
+{
+	pMap->blockSize = blockSize;
+	pMap->writing = 1;
+	pMap->pos = 0;
+	pMap->length = 0;
+	pMap->mapped = 0;
+	pMap->pBase = 0;
+	EGSP_TEST((pMap->fd = open(pPath, O_RDWR | O_CREAT | O_TRUNC, 0644)) >= 0);
+	return EGSP_SUCCESS;
+}
+
+static EgspResult Grow(EgspMap* pMap, size_t required)
+{
+	size_t size = pMap->mapped * 2;
+	size = size > EGSP_MAP_MIN_SIZE ? size : EGSP_MAP_MIN_SIZE;
+	size = size > required ? size : RoundToPage(required);
+	EGSP_TEST(ftruncate(pMap->fd, (off_t)size) == 0);
+
+	uint8_t* pBase = MAP_FAILED;
+#if defined(__linux__)
+	if (pMap->pBase && (pBase = mremap(pMap->pBase, pMap->mapped, size, MREMAP_MAYMOVE)) == MAP_FAILED)
+	{
+		munmap(pMap->pBase, pMap->mapped);
+	}
+#else
+	if (pMap->pBase)
+	{
+		munmap(pMap->pBase, pMap->mapped);
+	}
+#endif
+	if (pBase == MAP_FAILED)
+	{
+		pBase = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, pMap->fd, 0);
+	}
+	EGSP_TEST(pBase != MAP_FAILED);
+	madvise(pBase, size, MADV_SEQUENTIAL);
+
+	pMap->pBase = pBase;
+	pMap->mapped = size;
+	return EGSP_SUCCESS;
+}
+
+EgspResult EgspMapClose(EgspMap* pMap)
+{
+	EgspResult retval = EGSP_SUCCESS;
+	if (pMap->pBase)
+	{
+		munmap(pMap->pBase, pMap->mapped);
+	}
+	// Drop whatever was reserved past the last block
+	if (pMap->writing && ftruncate(pMap->fd, (off_t)pMap->pos) != 0)
+	{
+		retval = EGSP_FAIL;
+	}
+	if (close(pMap->fd) != 0)
+	{
+		retval = EGSP_FAIL;
+	}
+	if (s_pMap == pMap)
+	{
+		s_pMap = 0;
+	}
+	return retval;
+}
+
+void EgspMapBind(EgspMap* pMap)
+{
+	s_pMap = pMap;
+}
+
+uint8_t* EgspMapFuncEx(void* pUser, size_t size)
+{
+	EgspMap* pMap = (EgspMap*)pUser;
+	pMap->pos += size;
+	if (pMap->writing)
+	{
+		size_t required = pMap->pos + pMap->blockSize;
+		if (required > pMap->mapped && Grow(pMap, required) == EGSP_FAIL)
+		{
+			return 0;
+		}
+	}
+	else if (pMap->pos >= pMap->length)
+	{
+		return 0;
+	}
+	return pMap->pBase + pMap->pos;
+}
+
+uint8_t* EgspMapFunc(size_t size)
+{
+	return s_pMap ? EgspMapFuncEx(s_pMap, size) : 0;
+}
+
+#else
+// Memory mapping is not supported on this platform yet
+EgspResult EgspMapOpenRead(EgspMap* pMap, const char* pPath, size_t blockSize)
+{
+	return EGSP_FAIL;
+}
+
+EgspResult EgspMapOpenWrite(EgspMap* pMap, const char* pPath, size_t blockSize)
+{
+	return EGSP_FAIL;
+}
+
+EgspResult EgspMapClose(EgspMap* pMap)
+{
+	return EGSP_FAIL;
+}
+
+void EgspMapBind(EgspMap* pMap)
+{
+}
+
+uint8_t* EgspMapFuncEx(void* pUser, size_t size)
+{
+	return 0;
+}
+
+uint8_t* EgspMapFunc(size_t size)
+{
+	return 0;
+}
+#endif
@@ -0,0 +1,31 @@
+#ifndef EGSPMAP_H
+#define EGSPMAP_H
+
+#include "egsplib.h"
+
+// Block functions backed by a memory mapped file. Loading hands out pointers straight into
+// the mapping and saving writes straight into it, growing the file as it goes.
+typedef struct
+{
+	int fd;
+	size_t blockSize;
+	uint8_t* pBase;
+	size_t mapped;
+	size_t length;
+	size_t pos;
+	int writing;
+} EgspMap;
+
+// blockSize must match the block size of the loaders using the map
+EgspResult EgspMapOpenRead(EgspMap* pMap, const char* pPath, size_t blockSize);
+EgspResult EgspMapOpenWrite(EgspMap* pMap, const char* pPath, size_t blockSize);
+EgspResult EgspMapClose(EgspMap* pMap);
+
+// Pass the map as pUser, e.g. EgspInitLoader(&loader, EgspMapFuncEx, &map)
+uint8_t* EgspMapFuncEx(void* pUser, size_t size);
+
+// EgspMapFunc works on the map that was bound last. It can be passed to any EgspSave*/EgspLoad*.
+void EgspMapBind(EgspMap* pMap);
+uint8_t* EgspMapFunc(size_t size);
+
+#endif
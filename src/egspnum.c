@@ -0,0 +1,844 @@
+#include "egspnum.h"
+#include <string.h>
+
+// Integers
+
+static const char s_digitPairs[] =
+	"0001020304050607080910111213141516171819"
+	"2021222324252627282930313233343536373839"
+	"4041424344454647484950515253545556575859"
+	"6061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+size_t EgspUint64ToText(char* pText, uint64_t val)
+{
+	// Two digits at a time from the end
+	char buffer[20];
+	char* pEnd = buffer + sizeof(buffer);
+	char* pDigit = pEnd;
+	while (val >= 100)
+	{
+		pDigit -= 2;
+		memcpy(pDigit, s_digitPairs + (val % 100) * 2, 2);
+		val /= 100;
+	}
+	if (val >= 10)
+	{
+		pDigit -= 2;
+		memcpy(pDigit, s_digitPairs + val * 2, 2);
+	}
+	else
+	{
+		*--pDigit = (char)('0' + val);
+	}
+
+	size_t length = (size_t)(pEnd - pDigit);
+	memcpy(pText, pDigit, length);
+	pText[length] = '\0';
+	return length;
+}
+
+size_t EgspInt64ToText(char* pText, int64_t val)
+{
+	if (val < 0)
+	{
+		*pText = '-';
+		return 1 + EgspUint64ToText(pText + 1, 0 - (uint64_t)val);
+	}
+	return EgspUint64ToText(pText, (uint64_t)val);
+}
+
+static int IsDigit(char chr)
+{
+	return chr >= '0' && chr <= '9';
+}
+
+static const char* SkipSpace(const char* pText)
+{
+	while (*pText == ' ' || *pText == '\t' || *pText == '\n' || *pText == '\r' || *pText == '\f' || *pText == '\v')
+	{
+		++pText;
+	}
+	return pText;
+}
+
+// Digits up to max, without a sign
+static const char* ReadDigits(const char* pText, uint64_t* pVal, uint64_t max)
+{
+	uint64_t val = 0;
+	if (!IsDigit(*pText))
+	{
+		return 0;
+	}
+	for (; IsDigit(*pText); ++pText)
+	{
+		uint64_t digit = (uint64_t)(*pText - '0');
+		if (val > (max - digit) / 10)
+		{
+			return 0;
+		}
+		val = val * 10 + digit;
+	}
+	*pVal = val;
+	return pText;
+}
+
+const char* EgspTextToUint64(const char* pText, uint64_t* pVal)
+{
+	pText = SkipSpace(pText);
+	pText += *pText == '+';
+	return ReadDigits(pText, pVal, UINT64_MAX);
+}
+
+const char* EgspTextToInt64(const char* pText, int64_t* pVal)
+{
+	uint64_t val = 0;
+	pText = SkipSpace(pText);
+	int negative = *pText == '-';
+	pText += negative || *pText == '+';
+	if ((pText = ReadDigits(pText, &val, (uint64_t)INT64_MAX + negative)))
+	{
+		*pVal = negative ? (int64_t)(0 - val) : (int64_t)val;
+	}
+	return pText;
+}
+
+
+// Floats and doubles are printed with Grisu2 (Florian Loitsch, "Printing Floating-Point Numbers Quickly
+// and Accurately with Integers"). The digits always read back as the same value, and are the fewest
+// possible for all but about one value in a thousand.
+
+// Bits of each format after the sign, and the exponent of the smallest subnormal
+#define EGSP_DOUBLE_FRACTION 52
+#define EGSP_DOUBLE_EXPONENT 11
+#define EGSP_DOUBLE_MIN_EXP -1074
+#define EGSP_FLOAT_FRACTION 23
+#define EGSP_FLOAT_EXPONENT 8
+#define EGSP_FLOAT_MIN_EXP -149
+
+// Numbers with more digits than this before the point, or 4 zeros after it, get an exponent
+#define EGSP_FIXED_DIGITS 17
+
+// f * 2^e
+typedef struct
+{
+	uint64_t f;
+	int e;
+} DiyFp;
+
+// 10^k as a DiyFp with the top bit of f set, for k from -300 to 324 in steps of 8
+typedef struct
+{
+	uint64_t f;
+	int e;
+	int k;
+} CachedPower;
+
+static const CachedPower s_cachedPowers[] =
+{
+	{ 0xAB70FE17C79AC6CAull, -1060, -300 },
+	{ 0xFF77B1FCBEBCDC4Full, -1034, -292 },
+	{ 0xBE5691EF416BD60Cull, -1007, -284 },
+	{ 0x8DD01FAD907FFC3Cull, -980, -276 },
+	{ 0xD3515C2831559A83ull, -954, -268 },
+	{ 0x9D71AC8FADA6C9B5ull, -927, -260 },
+	{ 0xEA9C227723EE8BCBull, -901, -252 },
+	{ 0xAECC49914078536Dull, -874, -244 },
+	{ 0x823C12795DB6CE57ull, -847, -236 },
+	{ 0xC21094364DFB5637ull, -821, -228 },
+	{ 0x9096EA6F3848984Full, -794, -220 },
+	{ 0xD77485CB25823AC7ull, -768, -212 },
+	{ 0xA086CFCD97BF97F4ull, -741, -204 },
+	{ 0xEF340A98172AACE5ull, -715, -196 },
+	{ 0xB23867FB2A35B28Eull, -688, -188 },
+	{ 0x84C8D4DFD2C63F3Bull, -661, -180 },
+	{ 0xC5DD44271AD3CDBAull, -635, -172 },
+	{ 0x936B9FCEBB25C996ull, -608, -164 },
+	{ 0xDBAC6C247D62A584ull, -582, -156 },
+	{ 0xA3AB66580D5FDAF6ull, -555, -148 },
+	{ 0xF3E2F893DEC3F126ull, -529, -140 },
+	{ 0xB5B5ADA8AAFF80B8ull, -502, -132 },
+	{ 0x87625F056C7C4A8Bull, -475, -124 },
+	{ 0xC9BCFF6034C13053ull, -449, -116 },
+	{ 0x964E858C91BA2655ull, -422, -108 },
+	{ 0xDFF9772470297EBDull, -396, -100 },
+	{ 0xA6DFBD9FB8E5B88Full, -369, -92 },
+	{ 0xF8A95FCF88747D94ull, -343, -84 },
+	{ 0xB94470938FA89BCFull, -316, -76 },
+	{ 0x8A08F0F8BF0F156Bull, -289, -68 },
+	{ 0xCDB02555653131B6ull, -263, -60 },
+	{ 0x993FE2C6D07B7FACull, -236, -52 },
+	{ 0xE45C10C42A2B3B06ull, -210, -44 },
+	{ 0xAA242499697392D3ull, -183, -36 },
+	{ 0xFD87B5F28300CA0Eull, -157, -28 },
+	{ 0xBCE5086492111AEBull, -130, -20 },
+	{ 0x8CBCCC096F5088CCull, -103, -12 },
+	{ 0xD1B71758E219652Cull, -77, -4 },
+	{ 0x9C40000000000000ull, -50, 4 },
+	{ 0xE8D4A51000000000ull, -24, 12 },
+	{ 0xAD78EBC5AC620000ull, 3, 20 },
+	{ 0x813F3978F8940984ull, 30, 28 },
+	{ 0xC097CE7BC90715B3ull, 56, 36 },
+	{ 0x8F7E32CE7BEA5C70ull, 83, 44 },
+	{ 0xD5D238A4ABE98068ull, 109, 52 },
+	{ 0x9F4F2726179A2245ull, 136, 60 },
+	{ 0xED63A231D4C4FB27ull, 162, 68 },
+	{ 0xB0DE65388CC8ADA8ull, 189, 76 },
+	{ 0x83C7088E1AAB65DBull, 216, 84 },
+	{ 0xC45D1DF942711D9Aull, 242, 92 },
+	{ 0x924D692CA61BE758ull, 269, 100 },
+	{ 0xDA01EE641A708DEAull, 295, 108 },
+	{ 0xA26DA3999AEF774Aull, 322, 116 },
+	{ 0xF209787BB47D6B85ull, 348, 124 },
+	{ 0xB454E4A179DD1877ull, 375, 132 },
+	{ 0x865B86925B9BC5C2ull, 402, 140 },
+	{ 0xC83553C5C8965D3Dull, 428, 148 },
+	{ 0x952AB45CFA97A0B3ull, 455, 156 },
+	{ 0xDE469FBD99A05FE3ull, 481, 164 },
+	{ 0xA59BC234DB398C25ull, 508, 172 },
+	{ 0xF6C69A72A3989F5Cull, 534, 180 },
+	{ 0xB7DCBF5354E9BECEull, 561, 188 },
+	{ 0x88FCF317F22241E2ull, 588, 196 },
+	{ 0xCC20CE9BD35C78A5ull, 614, 204 },
+	{ 0x98165AF37B2153DFull, 641, 212 },
+	{ 0xE2A0B5DC971F303Aull, 667, 220 },
+	{ 0xA8D9D1535CE3B396ull, 694, 228 },
+	{ 0xFB9B7CD9A4A7443Cull, 720, 236 },
+	{ 0xBB764C4CA7A44410ull, 747, 244 },
+	{ 0x8BAB8EEFB6409C1Aull, 774, 252 },
+	{ 0xD01FEF10A657842Cull, 800, 260 },
+	{ 0x9B10A4E5E9913129ull, 827, 268 },
+	{ 0xE7109BFBA19C0C9Dull, 853, 276 },
+	{ 0xAC2820D9623BF429ull, 880, 284 },
+	{ 0x80444B5E7AA7CF85ull, 907, 292 },
+	{ 0xBF21E44003ACDD2Dull, 933, 300 },
+	{ 0x8E679C2F5E44FF8Full, 960, 308 },
+	{ 0xD433179D9C8CB841ull, 986, 316 },
+	{ 0x9E19DB92B4E31BA9ull, 1013, 324 },
+};
+
+static int LeadingZeros(uint64_t val)
+{
+#if defined(__GNUC__)
+	return __builtin_clzll(val);
+#else
+	int count = 0;
+	for (; !(val >> 63); val <<= 1)
+	{
+		++count;
+	}
+	return count;
+#endif
+}
+
+static DiyFp Normalize(DiyFp x)
+{
+	int shift = LeadingZeros(x.f);
+	x.f <<= shift;
+	x.e -= shift;
+	return x;
+}
+
+// The top 64 bits of the product, rounded
+static DiyFp Multiply(DiyFp x, DiyFp y)
+{
+	uint64_t a = x.f >> 32;
+	uint64_t b = x.f & 0xFFFFFFFF;
+	uint64_t c = y.f >> 32;
+	uint64_t d = y.f & 0xFFFFFFFF;
+	uint64_t ac = a * c;
+	uint64_t bc = b * c;
+	uint64_t ad = a * d;
+	uint64_t bd = b * d;
+	uint64_t mid = (bd >> 32) + (ad & 0xFFFFFFFF) + (bc & 0xFFFFFFFF) + (1u << 31);
+	DiyFp product = { ac + (ad >> 32) + (bc >> 32) + (mid >> 32), x.e + y.e + 64 };
+	return product;
+}
+
+// Moves the last digit down while that brings it closer to the value and stays inside the boundaries
+static void RoundDigits(char* pDigits, size_t length, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t tenK)
+{
+	while (rest < dist && delta - rest >= tenK && (rest + tenK < dist || dist - rest > rest + tenK - dist))
+	{
+		--pDigits[length - 1];
+		rest += tenK;
+	}
+}
+
+// Writes as few digits of w as it takes to land between the boundaries, adding to *pExponent
+static size_t GenerateDigits(char* pDigits, int* pExponent, DiyFp minus, DiyFp w, DiyFp plus)
+{
+	uint64_t delta = plus.f - minus.f;
+	uint64_t dist = plus.f - w.f;
+	int shift = -plus.e;
+	uint64_t one = (uint64_t)1 << shift;
+	uint32_t integral = (uint32_t)(plus.f >> shift);
+	uint64_t fraction = plus.f & (one - 1);
+	size_t length = 0;
+
+	uint32_t pow10 = 1;
+	int digits = 1;
+	for (; digits < 10 && integral >= pow10 * 10; ++digits)
+	{
+		pow10 *= 10;
+	}
+
+	while (digits > 0)
+	{
+		pDigits[length++] = (char)('0' + integral / pow10);
+		integral %= pow10;
+		--digits;
+		uint64_t rest = ((uint64_t)integral << shift) + fraction;
+		if (rest <= delta)
+		{
+			*pExponent += digits;
+			RoundDigits(pDigits, length, dist, delta, rest, (uint64_t)pow10 << shift);
+			return length;
+		}
+		pow10 /= 10;
+	}
+
+	for (;;)
+	{
+		fraction *= 10;
+		pDigits[length++] = (char)('0' + (fraction >> shift));
+		fraction &= one - 1;
+		--*pExponent;
+		delta *= 10;
+		dist *= 10;
+		if (fraction <= delta)
+		{
+			RoundDigits(pDigits, length, dist, delta, fraction, one);
+			return length;
+		}
+	}
+}
+
+// Digits of a positive finite value held in bits without the sign, and their power of ten in *pExponent
+static size_t Grisu2(char* pDigits, int* pExponent, uint64_t bits, int fractionBits, int minExp)
+{
+	uint64_t hidden = (uint64_t)1 << fractionBits;
+	uint64_t fraction = bits & (hidden - 1);
+	int biased = (int)(bits >> fractionBits);
+	DiyFp v = { fraction, minExp };
+	if (biased)
+	{
+		v.f |= hidden;
+		v.e = biased + minExp - 1;
+	}
+
+	// Halfway to the neighbours. The one below is closer when v is a power of two.
+	DiyFp plus = { 2 * v.f + 1, v.e - 1 };
+	DiyFp minus = { 2 * v.f - 1, v.e - 1 };
+	if (fraction == 0 && biased > 1)
+	{
+		minus.f = 4 * v.f - 1;
+		minus.e = v.e - 2;
+	}
+	plus = Normalize(plus);
+	minus.f <<= minus.e - plus.e;
+	minus.e = plus.e;
+	v = Normalize(v);
+
+	// Scale by a cached power of ten so that the integral part of plus fits in 32 bits
+	int f = -61 - plus.e;
+	int k = (f * 78913) / (1 << 18) + (f > 0);
+	const CachedPower* pPower = &s_cachedPowers[(300 + k + 7) / 8];
+	DiyFp c = { pPower->f, pPower->e };
+	DiyFp w = Multiply(v, c);
+	DiyFp wMinus = Multiply(minus, c);
+	DiyFp wPlus = Multiply(plus, c);
+
+	// Stay clear of the boundaries, they are only known to within an ulp
+	++wMinus.f;
+	--wPlus.f;
+	*pExponent = -pPower->k;
+	return GenerateDigits(pDigits, pExponent, wMinus, w, wPlus);
+}
+
+// Lays out digits * 10^exponent the way JSON expects, always with a point or an exponent
+static size_t FormatDigits(char* pText, const char* pDigits, int length, int exponent)
+{
+	char* pOut = pText;
+	int point = length + exponent;
+	if (length <= point && point <= EGSP_FIXED_DIGITS)
+	{
+		memcpy(pOut, pDigits, length);
+		memset(pOut + length, '0', point - length);
+		memcpy(pOut + point, ".0", 2);
+		pOut += point + 2;
+	}
+	else if (0 < point && point <= EGSP_FIXED_DIGITS)
+	{
+		memcpy(pOut, pDigits, point);
+		pOut[point] = '.';
+		memcpy(pOut + point + 1, pDigits + point, length - point);
+		pOut += length + 1;
+	}
+	else if (-4 < point && point <= 0)
+	{
+		memcpy(pOut, "0.", 2);
+		memset(pOut + 2, '0', -point);
+		memcpy(pOut + 2 - point, pDigits, length);
+		pOut += 2 - point + length;
+	}
+	else
+	{
+		*pOut++ = pDigits[0];
+		if (length > 1)
+		{
+			*pOut++ = '.';
+			memcpy(pOut, pDigits + 1, length - 1);
+			pOut += length - 1;
+		}
+		*pOut++ = 'e';
+		pOut += EgspInt64ToText(pOut, point - 1);
+	}
+	*pOut = '\0';
+	return (size_t)(pOut - pText);
+}
+
+static size_t FloatingToText(char* pText, uint64_t bits, int fractionBits, int exponentBits, int minExp)
+{
+	char* pOut = pText;
+	uint64_t magnitude = bits & (((uint64_t)1 << (fractionBits + exponentBits)) - 1);
+	if (bits != magnitude)
+	{
+		*pOut++ = '-';
+	}
+
+	char digits[20];
+	int exponent = 0;
+	if ((magnitude >> fractionBits) == ((uint64_t)1 << exponentBits) - 1)
+	{
+		const char* pSpecial = magnitude << (64 - fractionBits) ? "nan" : "inf";
+		memcpy(pOut, pSpecial, 4);
+		return (size_t)(pOut - pText) + 3;
+	}
+	if (magnitude == 0)
+	{
+		memcpy(pOut, "0.0", 4);
+		return (size_t)(pOut - pText) + 3;
+	}
+	size_t length = Grisu2(digits, &exponent, magnitude, fractionBits, minExp);
+	return (size_t)(pOut - pText) + FormatDigits(pOut, digits, (int)length, exponent);
+}
+
+size_t EgspDoubleToText(char* pText, double val)
+{
+	uint64_t bits;
+	memcpy(&bits, &val, sizeof(bits));
+	return FloatingToText(pText, bits, EGSP_DOUBLE_FRACTION, EGSP_DOUBLE_EXPONENT, EGSP_DOUBLE_MIN_EXP);
+}
+
+size_t EgspFloatToText(char* pText, float val)
+{
+	uint32_t bits;
+	memcpy(&bits, &val, sizeof(bits));
+	return FloatingToText(pText, bits, EGSP_FLOAT_FRACTION, EGSP_FLOAT_EXPONENT, EGSP_FLOAT_MIN_EXP);
+}
+
+
+// Reading floats and doubles. Most numbers are exact as a double and one multiply or divide by an exact
+// power of ten rounds them correctly. Otherwise a guess a few ulps out is moved to the right value by
+// comparing the decimal with the halfway points either side of it, exactly, in big integers.
+
+// Digits kept, enough to tell any two doubles apart. Any further digits only matter for breaking ties.
+#define EGSP_MAX_DIGITS 768
+
+// Limbs for the halfway comparisons, which need a little over 2600 bits
+#define EGSP_BIG_LIMBS 128
+
+// Exponent of the largest finite value, as in m * 2^e with m below 2^53 or 2^24
+#define EGSP_DOUBLE_MAX_EXP 971
+#define EGSP_FLOAT_MAX_EXP 104
+
+// digits * 10^exponent
+typedef struct
+{
+	uint8_t digits[EGSP_MAX_DIGITS];
+	int count;
+	int exponent;
+	int sticky;
+} Decimal;
+
+typedef struct
+{
+	uint32_t limbs[EGSP_BIG_LIMBS];
+	int count;
+} Big;
+
+static const double s_exactPowers[] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static void BigMultiply(Big* pBig, uint32_t mul, uint32_t add)
+{
+	uint64_t carry = add;
+	for (int i = 0; i < pBig->count; ++i)
+	{
+		carry += (uint64_t)pBig->limbs[i] * mul;
+		pBig->limbs[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+	if (carry)
+	{
+		pBig->limbs[pBig->count++] = (uint32_t)carry;
+	}
+}
+
+static void BigMultiplyPow5(Big* pBig, int power)
+{
+	static const uint32_t s_pow5[] = { 1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625, 48828125, 244140625 };
+	for (; power >= 13; power -= 13)
+	{
+		BigMultiply(pBig, 1220703125, 0);
+	}
+	BigMultiply(pBig, s_pow5[power], 0);
+}
+
+static void BigShiftLeft(Big* pBig, int bits)
+{
+	int words = bits / 32;
+	bits %= 32;
+	if (pBig->count == 0)
+	{
+		return;
+	}
+	if (bits)
+	{
+		uint32_t carry = 0;
+		for (int i = 0; i < pBig->count; ++i)
+		{
+			uint32_t limb = pBig->limbs[i];
+			pBig->limbs[i] = (limb << bits) | carry;
+			carry = limb >> (32 - bits);
+		}
+		if (carry)
+		{
+			pBig->limbs[pBig->count++] = carry;
+		}
+	}
+	memmove(pBig->limbs + words, pBig->limbs, pBig->count * sizeof(uint32_t));
+	memset(pBig->limbs, 0, words * sizeof(uint32_t));
+	pBig->count += words;
+}
+
+static int BigCompare(const Big* pLeft, const Big* pRight)
+{
+	if (pLeft->count != pRight->count)
+	{
+		return pLeft->count < pRight->count ? -1 : 1;
+	}
+	for (int i = pLeft->count - 1; i >= 0; --i)
+	{
+		if (pLeft->limbs[i] != pRight->limbs[i])
+		{
+			return pLeft->limbs[i] < pRight->limbs[i] ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+// Compares the decimal, scaled as pScaled, with half * 2^binExp
+static int CompareHalfway(const Decimal* pDec, const Big* pScaled, uint64_t half, int binExp)
+{
+	Big left;
+	Big right;
+	left.count = pScaled->count;
+	memcpy(left.limbs, pScaled->limbs, left.count * sizeof(uint32_t));
+	right.limbs[0] = (uint32_t)half;
+	right.limbs[1] = (uint32_t)(half >> 32);
+	right.count = right.limbs[1] ? 2 : 1;
+
+	// Both sides are integers once the powers of five and two are moved to whichever side keeps them whole
+	if (pDec->exponent < 0)
+	{
+		BigMultiplyPow5(&right, -pDec->exponent);
+	}
+	int shift = binExp - pDec->exponent;
+	if (shift > 0)
+	{
+		BigShiftLeft(&right, shift);
+	}
+	else
+	{
+		BigShiftLeft(&left, -shift);
+	}
+	int order = BigCompare(&left, &right);
+	return order == 0 && pDec->sticky ? 1 : order;
+}
+
+// Reads a decimal with an optional fraction and exponent, or nan or inf as *pSpecial
+static const char* ReadDecimal(const char* pText, Decimal* pDec, int* pNegative, const char** ppSpecial)
+{
+	pText = SkipSpace(pText);
+	*pNegative = *pText == '-';
+	pText += *pNegative || *pText == '+';
+	*ppSpecial = 0;
+	pDec->count = 0;
+	pDec->exponent = 0;
+	pDec->sticky = 0;
+
+	static const char* s_special[] = { "infinity", "inf", "nan" };
+	for (int i = 0; i < 3; ++i)
+	{
+		size_t length = strlen(s_special[i]);
+		size_t c = 0;
+		while (c < length && (pText[c] | 0x20) == s_special[i][c])
+		{
+			++c;
+		}
+		if (c == length)
+		{
+			*ppSpecial = s_special[i];
+			return pText + length;
+		}
+	}
+
+	int seen = 0;
+	int fraction = 0;
+	for (;; ++pText)
+	{
+		if (*pText == '.' && !fraction)
+		{
+			fraction = 1;
+			continue;
+		}
+		if (!IsDigit(*pText))
+		{
+			break;
+		}
+		uint8_t digit = (uint8_t)(*pText - '0');
+		seen = 1;
+		if (pDec->count == 0 && digit == 0)
+		{
+			pDec->exponent -= fraction;
+		}
+		else if (pDec->count < EGSP_MAX_DIGITS)
+		{
+			pDec->digits[pDec->count++] = digit;
+			pDec->exponent -= fraction;
+		}
+		else
+		{
+			pDec->sticky |= digit;
+			pDec->exponent += !fraction;
+		}
+	}
+	if (!seen)
+	{
+		return 0;
+	}
+
+	if ((*pText | 0x20) == 'e')
+	{
+		const char* pExponent = pText + 1;
+		int negative = *pExponent == '-';
+		pExponent += negative || *pExponent == '+';
+		if (IsDigit(*pExponent))
+		{
+			int exponent = 0;
+			for (; IsDigit(*pExponent); ++pExponent)
+			{
+				exponent = exponent < 100000 ? exponent * 10 + (*pExponent - '0') : exponent;
+			}
+			pDec->exponent += negative ? -exponent : exponent;
+			pText = pExponent;
+		}
+	}
+
+	while (pDec->count && pDec->digits[pDec->count - 1] == 0)
+	{
+		--pDec->count;
+		++pDec->exponent;
+	}
+	return pText;
+}
+
+// Rounds the decimal to m * 2^e, with m below 2^precision, and returns the bits after the sign
+static uint64_t DecimalToBits(const Decimal* pDec, int precision, int minExp, int maxExp, int maxPoint, int isFloat)
+{
+	uint64_t half = (uint64_t)1 << (precision - 1);
+	uint64_t infinity = (uint64_t)(maxExp - minExp + 2) << (precision - 1);
+	int point = pDec->count + pDec->exponent;
+	if (pDec->count == 0 || point < minExp * 3 / 10 - 2)
+	{
+		return 0;
+	}
+	if (point > maxPoint)
+	{
+		return infinity;
+	}
+
+	int used = pDec->count < 19 ? pDec->count : 19;
+	uint64_t w = 0;
+	for (int i = 0; i < used; ++i)
+	{
+		w = w * 10 + pDec->digits[i];
+	}
+	int scale = pDec->exponent + pDec->count - used;
+
+	// Exact when w and the power of ten both are
+	double guess = (double)w;
+	uint64_t bits;
+	if (used == pDec->count && !pDec->sticky && w <= ((uint64_t)1 << 53) && scale >= -22 && scale <= 22)
+	{
+		guess = scale < 0 ? guess / s_exactPowers[-scale] : guess * s_exactPowers[scale];
+		memcpy(&bits, &guess, sizeof(bits));
+		if (!isFloat)
+		{
+			return bits;
+		}
+
+		// Rounding the double again is only wrong when it landed exactly halfway between two floats
+		if ((bits & 0x1FFFFFFF) != 0x10000000)
+		{
+			float single = (float)guess;
+			uint32_t singleBits;
+			memcpy(&singleBits, &single, sizeof(singleBits));
+			return singleBits;
+		}
+	}
+	else
+	{
+		for (; scale > 22; scale -= 22)
+		{
+			guess *= 1e22;
+		}
+		for (; scale < -22; scale += 22)
+		{
+			guess /= 1e22;
+		}
+		guess = scale < 0 ? guess / s_exactPowers[-scale] : guess * s_exactPowers[scale];
+	}
+
+	if (isFloat)
+	{
+		float single = (float)guess;
+		uint32_t singleBits;
+		memcpy(&singleBits, &single, sizeof(singleBits));
+		bits = singleBits;
+	}
+	else
+	{
+		memcpy(&bits, &guess, sizeof(bits));
+	}
+
+	uint64_t m = bits & (half - 1);
+	int e = minExp;
+	if (bits >= infinity)
+	{
+		m = 2 * half - 1;
+		e = maxExp;
+	}
+	else if (bits >> (precision - 1))
+	{
+		m |= half;
+		e = (int)(bits >> (precision - 1)) + minExp - 1;
+	}
+
+	// The digits times any positive power of ten, the same for every comparison
+	Big scaled;
+	scaled.count = 0;
+	for (int i = 0; i < pDec->count;)
+	{
+		uint32_t chunk = 0;
+		uint32_t mul = 1;
+		for (int end = i + 9 < pDec->count ? i + 9 : pDec->count; i < end; ++i)
+		{
+			chunk = chunk * 10 + pDec->digits[i];
+			mul *= 10;
+		}
+		BigMultiply(&scaled, mul, chunk);
+	}
+	if (pDec->exponent > 0)
+	{
+		BigMultiplyPow5(&scaled, pDec->exponent);
+	}
+
+	// Up while past the halfway point above, down while short of the one below. Ties go to even.
+	for (;;)
+	{
+		int order = CompareHalfway(pDec, &scaled, 2 * m + 1, e - 1);
+		if (order > 0 || (order == 0 && (m & 1)))
+		{
+			if (++m == 2 * half)
+			{
+				m = half;
+				++e;
+			}
+			if (e > maxExp)
+			{
+				return infinity;
+			}
+			continue;
+		}
+		if (m == 0)
+		{
+			break;
+		}
+		int closer = m == half && e > minExp;
+		order = closer ? CompareHalfway(pDec, &scaled, 4 * m - 1, e - 2) : CompareHalfway(pDec, &scaled, 2 * m - 1, e - 1);
+		if (order < 0 || (order == 0 && (m & 1)))
+		{
+			if (closer)
+			{
+				m = 2 * half - 1;
+				--e;
+			}
+			else
+			{
+				--m;
+			}
+			continue;
+		}
+		break;
+	}
+	return m < half ? m : ((uint64_t)(e - minExp + 1) << (precision - 1)) | (m - half);
+}
+
+static const char* TextToBits(const char* pText, uint64_t* pBits, int fractionBits, int exponentBits, int minExp, int maxExp, int maxPoint)
+{
+	Decimal dec;
+	int negative = 0;
+	const char* pSpecial = 0;
+	uint64_t exponentMask = (((uint64_t)1 << exponentBits) - 1) << fractionBits;
+	if (!(pText = ReadDecimal(pText, &dec, &negative, &pSpecial)))
+	{
+		return 0;
+	}
+	if (pSpecial)
+	{
+		*pBits = pSpecial[0] == 'n' ? exponentMask | ((uint64_t)1 << (fractionBits - 1)) : exponentMask;
+	}
+	else
+	{
+		*pBits = DecimalToBits(&dec, fractionBits + 1, minExp, maxExp, maxPoint, fractionBits == EGSP_FLOAT_FRACTION);
+	}
+	*pBits |= (uint64_t)negative << (fractionBits + exponentBits);
+	return pText;
+}
+
+const char* EgspTextToDouble(const char* pText, double* pVal)
+{
+	uint64_t bits = 0;
+	if ((pText = TextToBits(pText, &bits, EGSP_DOUBLE_FRACTION, EGSP_DOUBLE_EXPONENT, EGSP_DOUBLE_MIN_EXP, EGSP_DOUBLE_MAX_EXP, 310)))
+	{
+		memcpy(pVal, &bits, sizeof(*pVal));
+	}
+	return pText;
+}
+
+const char* EgspTextToFloat(const char* pText, float* pVal)
+{
+	uint64_t bits = 0;
+	if ((pText = TextToBits(pText, &bits, EGSP_FLOAT_FRACTION, EGSP_FLOAT_EXPONENT, EGSP_FLOAT_MIN_EXP, EGSP_FLOAT_MAX_EXP, 40)))
+	{
+		uint32_t singleBits = (uint32_t)bits;
+		memcpy(pVal, &singleBits, sizeof(*pVal));
+	}
+	return pText;
+}
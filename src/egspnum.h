@@ -0,0 +1,27 @@
+#ifndef EGSPNUM_H
+#define EGSPNUM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Number text for the JSON printer and reader. None of this looks at the locale, so a decimal point is
+// always '.', and floats and doubles are printed round-trip exact, usually with the shortest digits possible.
+
+// Longest text any of the Egsp*ToText functions write, including the terminating zero
+#define EGSP_NUMBER_LENGTH 32
+
+// Each writes val to pText, terminates it and returns its length
+size_t EgspUint64ToText(char* pText, uint64_t val);
+size_t EgspInt64ToText(char* pText, int64_t val);
+size_t EgspDoubleToText(char* pText, double val);
+size_t EgspFloatToText(char* pText, float val);
+
+// Each skips leading whitespace and reads a number from pText, returning the first character after it.
+// Returns 0 when there is no number there or it does not fit in the type. Floats and doubles are rounded
+// to the nearest value, ties to even, however many digits there are. nan and inf are read as well.
+const char* EgspTextToUint64(const char* pText, uint64_t* pVal);
+const char* EgspTextToInt64(const char* pText, int64_t* pVal);
+const char* EgspTextToDouble(const char* pText, double* pVal);
+const char* EgspTextToFloat(const char* pText, float* pVal);
+
+#endif
@@ -0,0 +1,288 @@
+#include "egsppool.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define EGSP_CHUNK_MIN_SIZE (1 << 16)
+
+// A single element encoding to more than this fails rather than growing its chunk any further
+#define EGSP_CHUNK_MAX_SIZE ((size_t)1 << 30)
+
+// Every worker gets a few chunks, so that there is something left to steal when one falls behind
+#define EGSP_CHUNKS_PER_WORKER 4
+
+EgspResult _EgspRecordString(EgspChunk* pChunk, size_t offset, size_t length, size_t stored)
+{
+	if (pChunk->stringCount == pChunk->stringCapacity)
+	{
+		size_t capacity = pChunk->stringCapacity ? pChunk->stringCapacity * 2 : 64;
+		EgspChunkString* pStrings = (EgspChunkString*)realloc(pChunk->pStrings, capacity * sizeof(EgspChunkString));
+		EGSP_TEST(pStrings);
+		pChunk->pStrings = pStrings;
+		pChunk->stringCapacity = capacity;
+	}
+	EgspChunkString* pString = pChunk->pStrings + pChunk->stringCount++;
+	pString->offset = offset;
+	pString->length = length;
+	pString->stored = stored;
+	return EGSP_SUCCESS;
+}
+
+#ifndef _WIN32
+// Encodes the chunk's elements into one span, growing it whenever an element does not fit.
+// Only running out of span, which leaves the offset at the end of it, is worth a retry.
+static void EncodeChunk(EgspPool* pPool, EgspChunk* pChunk)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.alignBytes = pPool->pParent->alignBytes;
+	loader.flags = pPool->pParent->flags;
+	loader.pChunk = pChunk;
+	loader.pData = pChunk->pData;
+	loader.blockSize = pChunk->capacity;
+	pChunk->stringCount = 0;
+	pChunk->result = EGSP_FAIL;
+
+	for (size_t i = pChunk->begin; i < pChunk->end; ++i)
+	{
+		size_t offset = loader.offset;
+		size_t heapSize = loader.heapSize;
+		size_t stringCount = pChunk->stringCount;
+		while (pPool->pSave(&loader, pPool->pVals + i * pPool->size) == EGSP_FAIL)
+		{
+			if (loader.offset < loader.blockSize || pChunk->capacity >= EGSP_CHUNK_MAX_SIZE)
+			{
+				return;
+			}
+			loader.offset = offset;
+			loader.heapSize = heapSize;
+			pChunk->stringCount = stringCount;
+
+			size_t capacity = pChunk->capacity ? pChunk->capacity * 2 : EGSP_CHUNK_MIN_SIZE;
+			uint8_t* pData = (uint8_t*)realloc(pChunk->pData, capacity);
+			if (!pData)
+			{
+				return;
+			}
+			pChunk->pData = loader.pData = pData;
+			pChunk->capacity = loader.blockSize = capacity;
+		}
+	}
+	pChunk->used = loader.offset;
+	pChunk->heapSize = loader.heapSize;
+	pChunk->result = EGSP_SUCCESS;
+}
+
+static int Take(EgspChunkQueue* pQueue, int steal, size_t* pChunk)
+{
+	int found = 0;
+	pthread_mutex_lock(&pQueue->lock);
+	if (pQueue->begin < pQueue->end)
+	{
+		*pChunk = steal ? --pQueue->end : pQueue->begin++;
+		found = 1;
+	}
+	pthread_mutex_unlock(&pQueue->lock);
+	return found;
+}
+
+static void RunChunks(EgspPool* pPool, size_t self)
+{
+	size_t participants = pPool->workerCount + 1;
+	size_t chunk = 0;
+	while (1)
+	{
+		if (!Take(pPool->queues + self, 0, &chunk))
+		{
+			// Out of work, so help whoever still has some, starting with the next one along
+			size_t i = 1;
+			for (; i < participants && !Take(pPool->queues + (self + i) % participants, 1, &chunk); ++i);
+			if (i == participants)
+			{
+				return;
+			}
+			__atomic_fetch_add(&pPool->steals, 1, __ATOMIC_RELAXED);
+		}
+		EncodeChunk(pPool, pPool->pChunks + chunk);
+	}
+}
+
+static void* Worker(void* pArg)
+{
+	EgspChunkQueue* pQueue = (EgspChunkQueue*)pArg;
+	EgspPool* pPool = pQueue->pPool;
+	size_t self = (size_t)(pQueue - pPool->queues);
+	size_t generation = 0;
+
+	pthread_mutex_lock(&pPool->lock);
+	while (1)
+	{
+		while (pPool->generation == generation && !pPool->quit)
+		{
+			pthread_cond_wait(&pPool->wake, &pPool->lock);
+		}
+		if (pPool->quit)
+		{
+			break;
+		}
+		generation = pPool->generation;
+		pthread_mutex_unlock(&pPool->lock);
+
+		RunChunks(pPool, self);
+
+		pthread_mutex_lock(&pPool->lock);
+		if (--pPool->busy == 0)
+		{
+			pthread_cond_signal(&pPool->idle);
+		}
+	}
+	pthread_mutex_unlock(&pPool->lock);
+	return 0;
+}
+
+EgspResult EgspPoolOpen(EgspPool* pPool, size_t workerCount)
+{
+	memset(pPool, 0, sizeof(*pPool));
+	pPool->threshold = EGSP_POOL_THRESHOLD;
+	EGSP_TEST(pthread_mutex_init(&pPool->lock, 0) == 0);
+	pthread_cond_init(&pPool->wake, 0);
+	pthread_cond_init(&pPool->idle, 0);
+	for (size_t i = 0; i <= EGSP_POOL_MAX_WORKERS; ++i)
+	{
+		pPool->queues[i].pPool = pPool;
+		pthread_mutex_init(&pPool->queues[i].lock, 0);
+	}
+
+	workerCount = workerCount < EGSP_POOL_MAX_WORKERS ? workerCount : EGSP_POOL_MAX_WORKERS;
+	for (; pPool->workerCount < workerCount; ++pPool->workerCount)
+	{
+		size_t i = pPool->workerCount;
+		if (pthread_create(pPool->threads + i, 0, Worker, pPool->queues + i) != 0)
+		{
+			EgspPoolClose(pPool);
+			return EGSP_FAIL;
+		}
+	}
+	return EGSP_SUCCESS;
+}
+
+EgspResult EgspPoolClose(EgspPool* pPool)
+{
+	pthread_mutex_lock(&pPool->lock);
+	pPool->quit = 1;
+	pthread_cond_broadcast(&pPool->wake);
+	pthread_mutex_unlock(&pPool->lock);
+	for (size_t i = 0; i < pPool->workerCount; ++i)
+	{
+		pthread_join(pPool->threads[i], 0);
+	}
+
+	for (size_t i = 0; i < pPool->chunkCapacity; ++i)
+	{
+		free(pPool->pChunks[i].pData);
+		free(pPool->pChunks[i].pStrings);
+	}
+	free(pPool->pChunks);
+	for (size_t i = 0; i <= EGSP_POOL_MAX_WORKERS; ++i)
+	{
+		pthread_mutex_destroy(&pPool->queues[i].lock);
+	}
+	pthread_cond_destroy(&pPool->idle);
+	pthread_cond_destroy(&pPool->wake);
+	pthread_mutex_destroy(&pPool->lock);
+	return EGSP_SUCCESS;
+}
+
+int _EgspParallel(EgspLoader* pLoader, size_t count)
+{
+	return pLoader->pPool && count > 1 && count >= pLoader->pPool->threshold;
+}
+
+EgspResult _EgspSaveArrayParallel(EgspLoader* pLoader, const void* pVals, size_t count, size_t size, EgspSaveElement pSave)
+{
+	EgspPool* pPool = pLoader->pPool;
+	size_t participants = pPool->workerCount + 1;
+	size_t chunkSize = count / (participants * EGSP_CHUNKS_PER_WORKER);
+	chunkSize = chunkSize ? chunkSize : 1;
+	size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+	if (chunkCount > pPool->chunkCapacity)
+	{
+		EgspChunk* pChunks = (EgspChunk*)realloc(pPool->pChunks, chunkCount * sizeof(EgspChunk));
+		EGSP_TEST(pChunks);
+		memset(pChunks + pPool->chunkCapacity, 0, (chunkCount - pPool->chunkCapacity) * sizeof(EgspChunk));
+		pPool->pChunks = pChunks;
+		pPool->chunkCapacity = chunkCount;
+	}
+	for (size_t i = 0; i < chunkCount; ++i)
+	{
+		pPool->pChunks[i].begin = i * chunkSize;
+		pPool->pChunks[i].end = i + 1 < chunkCount ? (i + 1) * chunkSize : count;
+	}
+
+	// Each participant starts out with a run of neighbouring chunks
+	for (size_t i = 0; i < participants; ++i)
+	{
+		pPool->queues[i].begin = chunkCount * i / participants;
+		pPool->queues[i].end = chunkCount * (i + 1) / participants;
+	}
+
+	pthread_mutex_lock(&pPool->lock);
+	pPool->pParent = pLoader;
+	pPool->pVals = (const uint8_t*)pVals;
+	pPool->size = size;
+	pPool->pSave = pSave;
+	pPool->busy = pPool->workerCount;
+	++pPool->generation;
+	pthread_cond_broadcast(&pPool->wake);
+	pthread_mutex_unlock(&pPool->lock);
+
+	RunChunks(pPool, pPool->workerCount);
+
+	pthread_mutex_lock(&pPool->lock);
+	while (pPool->busy)
+	{
+		pthread_cond_wait(&pPool->idle, &pPool->lock);
+	}
+	pthread_mutex_unlock(&pPool->lock);
+
+	// Stitch the chunks together in order, placing the strings exactly where a sequential save would have
+	for (size_t i = 0; i < chunkCount; ++i)
+	{
+		EgspChunk* pChunk = pPool->pChunks + i;
+		EGSP_TRY(pChunk->result);
+		size_t pos = 0;
+		for (size_t s = 0; s < pChunk->stringCount; ++s)
+		{
+			EgspChunkString* pString = pChunk->pStrings + s;
+			EGSP_TRY(_EgspSaveBytes(pLoader, pChunk->pData + pos, pString->offset - pos));
+			EGSP_TRY(_EgspSaveChars(pLoader, (const char*)pChunk->pData + pString->offset, pString->length, pString->stored));
+			pos = pString->offset + pString->stored;
+		}
+		EGSP_TRY(_EgspSaveBytes(pLoader, pChunk->pData + pos, pChunk->used - pos));
+		pLoader->heapSize += pChunk->heapSize;
+	}
+	return EGSP_SUCCESS;
+}
+
+#else
+// Not supported on this platform yet, arrays are always saved on the calling thread
+EgspResult EgspPoolOpen(EgspPool* pPool, size_t workerCount)
+{
+	return EGSP_FAIL;
+}
+
+EgspResult EgspPoolClose(EgspPool* pPool)
+{
+	return EGSP_FAIL;
+}
+
+int _EgspParallel(EgspLoader* pLoader, size_t count)
+{
+	return 0;
+}
+
+EgspResult _EgspSaveArrayParallel(EgspLoader* pLoader, const void* pVals, size_t count, size_t size, EgspSaveElement pSave)
+{
+	return EGSP_FAIL;
+}
+#endif
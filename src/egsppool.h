@@ -0,0 +1,86 @@
+#ifndef EGSPPOOL_H
+#define EGSPPOOL_H
+
+#include "egsplib.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#define EGSP_POOL_MAX_WORKERS 64
+#define EGSP_POOL_THRESHOLD 4096
+
+// A string a worker wrote into its chunk. The stitched stream places its characters the way a
+// sequential save would have, which depends on where the chunk lands in the blocks.
+typedef struct
+{
+	size_t offset;
+	size_t length;
+	size_t stored;
+} EgspChunkString;
+
+// A run of array elements encoded by one worker into a buffer of its own
+typedef struct EgspChunk
+{
+	size_t begin;
+	size_t end;
+	uint8_t* pData;
+	size_t capacity;
+	size_t used;
+	EgspChunkString* pStrings;
+	size_t stringCount;
+	size_t stringCapacity;
+	size_t heapSize;
+	EgspResult result;
+} EgspChunk;
+
+// Chunks waiting to be encoded. The owner takes them from the front, idle workers steal from the back.
+typedef struct
+{
+	struct EgspPool* pPool;
+	size_t begin;
+	size_t end;
+#ifndef _WIN32
+	pthread_mutex_t lock;
+#endif
+} EgspChunkQueue;
+
+// Worker threads for saving large struct arrays in parallel. Set pPool on an EgspLoader to use it.
+// Arrays of at least threshold elements are split into chunks, which are encoded concurrently and then
+// copied into the loader's blocks in order. The stream is identical to a sequential save.
+// The thread calling Save works on chunks too. A pool serves one Save at a time.
+// Chunk buffers are grown with realloc and kept for the next Save until EgspPoolClose.
+typedef struct EgspPool
+{
+	size_t threshold;
+	size_t workerCount;
+
+	// Chunks taken from another worker's queue
+	size_t steals;
+
+	// The array being saved
+	const EgspLoader* pParent;
+	const uint8_t* pVals;
+	size_t size;
+	EgspSaveElement pSave;
+	EgspChunk* pChunks;
+	size_t chunkCapacity;
+
+	EgspChunkQueue queues[EGSP_POOL_MAX_WORKERS + 1];
+	size_t generation;
+	size_t busy;
+	int quit;
+
+#ifndef _WIN32
+	pthread_t threads[EGSP_POOL_MAX_WORKERS];
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	pthread_cond_t idle;
+#endif
+} EgspPool;
+
+// workerCount threads are started on top of the one calling Save, up to EGSP_POOL_MAX_WORKERS
+EgspResult EgspPoolOpen(EgspPool* pPool, size_t workerCount);
+EgspResult EgspPoolClose(EgspPool* pPool);
+
+#endif
@@ -0,0 +1,397 @@
+#include "egsppush.h"
+#include <string.h>
+
+// How far ReadValue got
+#define EGSP_PUSH_ERROR -1
+#define EGSP_PUSH_MORE 0
+#define EGSP_PUSH_DONE 1
+#define EGSP_PUSH_NESTED 2
+
+typedef struct
+{
+	const uint8_t* pData;
+	size_t size;
+} EgspInput;
+
+// Copies whatever has arrived of a value of want bytes to pDst. Returns whether the value is complete.
+static int Take(EgspPush* pPush, EgspInput* pIn, uint8_t* pDst, size_t want)
+{
+	size_t run = want - pPush->pos;
+	run = run < pIn->size ? run : pIn->size;
+	memcpy(pDst + pPush->pos, pIn->pData, run);
+	pIn->pData += run;
+	pIn->size -= run;
+	pPush->pos += run;
+	if (pPush->pos < want)
+	{
+		return 0;
+	}
+	pPush->pos = 0;
+	return 1;
+}
+
+static uint64_t FromBig(const uint8_t* pBytes, size_t size)
+{
+	uint64_t val = 0;
+	for (size_t i = 0; i < size; ++i)
+	{
+		val = (val << 8) | pBytes[i];
+	}
+	return val;
+}
+
+static void Store(uint8_t* pDst, uint64_t val, size_t size)
+{
+	switch (size)
+	{
+	case 1: { uint8_t v = (uint8_t)val; memcpy(pDst, &v, 1); break; }
+	case 2: { uint16_t v = (uint16_t)val; memcpy(pDst, &v, 2); break; }
+	case 4: { uint32_t v = (uint32_t)val; memcpy(pDst, &v, 4); break; }
+	default: memcpy(pDst, &val, 8);
+	}
+}
+
+static size_t LoadCount(const uint8_t* pSrc, size_t size)
+{
+	switch (size)
+	{
+	case 1: { uint8_t v; memcpy(&v, pSrc, 1); return v; }
+	case 2: { uint16_t v; memcpy(&v, pSrc, 2); return v; }
+	case 4: { uint32_t v; memcpy(&v, pSrc, 4); return v; }
+	default: { uint64_t v; memcpy(&v, pSrc, 8); return (size_t)v; }
+	}
+}
+
+// Unlike EgspAlloc, running out is just a failed push, since the stream may come from anywhere
+static uint8_t* Alloc(EgspPush* pPush, size_t size)
+{
+	return _EgspPad(&pPush->loader, size) <= pPush->loader.heapSize ? (uint8_t*)EgspAlloc(&pPush->loader, size) : 0;
+}
+
+static void NextField(EgspPushFrame* pFrame)
+{
+	++pFrame->field;
+	pFrame->started = 0;
+}
+
+static void NextItem(EgspPushFrame* pFrame, const EgspField* pField)
+{
+	if (pField->shape == EGSP_SHAPE_ARRAY)
+	{
+		++pFrame->index;
+	}
+	else
+	{
+		NextField(pFrame);
+	}
+}
+
+static int IsNumber(EgspKind kind)
+{
+	return kind == EGSP_KIND_UNSIGNED || kind == EGSP_KIND_SIGNED || kind == EGSP_KIND_FLOAT;
+}
+
+// Whether numbers of this kind and size are stored at their full width
+static int IsFixed(EgspPush* pPush, EgspKind kind, size_t size)
+{
+	return !(pPush->loader.flags & EGSP_FLAG_VARINT) || kind == EGSP_KIND_FLOAT || size == 1;
+}
+
+// Reads a number of size bytes as the stream stores it, fixed width or varint
+static int ReadNumber(EgspPush* pPush, EgspInput* pIn, EgspKind kind, size_t size, uint64_t* pVal)
+{
+	if (IsFixed(pPush, kind, size))
+	{
+		if (!Take(pPush, pIn, pPush->scratch, size))
+		{
+			return EGSP_PUSH_MORE;
+		}
+		*pVal = FromBig(pPush->scratch, size);
+		return EGSP_PUSH_DONE;
+	}
+
+	// A byte at a time up to the first one without its top bit set
+	uint8_t byte = 0x80;
+	while (byte & 0x80)
+	{
+		if (!pIn->size)
+		{
+			return EGSP_PUSH_MORE;
+		}
+		if (pPush->pos == EGSP_VARINT_MAX)
+		{
+			return EGSP_PUSH_ERROR;
+		}
+		byte = *pIn->pData++;
+		--pIn->size;
+		pPush->scratch[pPush->pos++] = byte;
+	}
+
+	uint64_t val = 0;
+	for (size_t i = pPush->pos; i--;)
+	{
+		val = (val << 7) | (pPush->scratch[i] & 0x7F);
+	}
+	pPush->pos = 0;
+	*pVal = val;
+	return _EgspVarintValue(pVal, size, kind) == EGSP_SUCCESS ? EGSP_PUSH_DONE : EGSP_PUSH_ERROR;
+}
+
+// Reads one value of the field's kind to pItem, or starts on it when it is a struct
+static int ReadValue(EgspPush* pPush, EgspInput* pIn, const EgspField* pField, uint8_t* pItem)
+{
+	uint64_t val = 0;
+	int result;
+	switch (pField->kind)
+	{
+	case EGSP_KIND_UNSIGNED:
+	case EGSP_KIND_SIGNED:
+	case EGSP_KIND_FLOAT:
+		if ((result = ReadNumber(pPush, pIn, pField->kind, pField->size, &val)) == EGSP_PUSH_DONE)
+		{
+			Store(pItem, val, pField->size);
+		}
+		return result;
+
+	case EGSP_KIND_ENUM:
+		if ((result = ReadNumber(pPush, pIn, EGSP_KIND_SIGNED, sizeof(int32_t), &val)) == EGSP_PUSH_DONE)
+		{
+			Store(pItem, (uint64_t)(int64_t)(int32_t)(uint32_t)val, pField->size);
+		}
+		return result;
+
+	case EGSP_KIND_RAW:
+		if (!Take(pPush, pIn, pItem, pField->pStruct->size))
+		{
+			return EGSP_PUSH_MORE;
+		}
+		_EgspFixRaw(pItem, 1, pField->pStruct->pLayout);
+		return EGSP_PUSH_DONE;
+
+	case EGSP_KIND_STRING:
+	{
+		// The length comes first, then the characters go straight to the heap
+		if (!pPush->pString)
+		{
+			uint64_t length = 0;
+			if ((result = ReadNumber(pPush, pIn, EGSP_KIND_UNSIGNED, sizeof(uint32_t), &length)) != EGSP_PUSH_DONE)
+			{
+				return result;
+			}
+			pPush->length = (size_t)length;
+			if (!(pPush->pString = (char*)Alloc(pPush, pPush->length + 1)))
+			{
+				return EGSP_PUSH_ERROR;
+			}
+		}
+		int terminated = (pPush->loader.flags & EGSP_FLAG_ZERO_COPY) != 0;
+		if (!Take(pPush, pIn, (uint8_t*)pPush->pString, pPush->length + terminated))
+		{
+			return EGSP_PUSH_MORE;
+		}
+		if (terminated && pPush->pString[pPush->length] != '\0')
+		{
+			return EGSP_PUSH_ERROR;
+		}
+		pPush->pString[pPush->length] = '\0';
+		memcpy(pItem, &pPush->pString, sizeof(char*));
+		pPush->pString = 0;
+		return EGSP_PUSH_DONE;
+	}
+
+	default:
+	{
+		if (pPush->depth == EGSP_PUSH_MAX_DEPTH)
+		{
+			return EGSP_PUSH_ERROR;
+		}
+		EgspPushFrame* pFrame = pPush->frames + pPush->depth++;
+		memset(pFrame, 0, sizeof(*pFrame));
+		pFrame->pStruct = pField->pStruct;
+		pFrame->pVal = pItem;
+		return EGSP_PUSH_NESTED;
+	}
+	}
+}
+
+static EgspResult CheckEnvelope(EgspPush* pPush)
+{
+	EgspEnvelope envelope;
+	EGSP_TRY(EgspPeekEnvelope(pPush->scratch, EGSP_ENVELOPE_SIZE, &envelope));
+	EGSP_TEST(envelope.flags == (pPush->loader.flags & EGSP_FORMAT_FLAGS) && envelope.schema == pPush->pStruct->schema);
+	EGSP_TEST(envelope.heapSize <= pPush->loader.heapSize);
+	return EGSP_SUCCESS;
+}
+
+static int Decode(EgspPush* pPush, EgspInput* pIn)
+{
+	if ((pPush->loader.flags & EGSP_FLAG_ENVELOPE) && !pPush->enveloped)
+	{
+		if (!Take(pPush, pIn, pPush->scratch, EGSP_ENVELOPE_SIZE))
+		{
+			return EGSP_PUSH_MORE;
+		}
+		if (CheckEnvelope(pPush) == EGSP_FAIL)
+		{
+			return EGSP_PUSH_ERROR;
+		}
+		pPush->enveloped = 1;
+	}
+
+	while (pPush->depth)
+	{
+		EgspPushFrame* pFrame = pPush->frames + pPush->depth - 1;
+		const EgspStructInfo* pStruct = pFrame->pStruct;
+
+		// Only a raw struct at the top gets here, nested ones are read as a whole by ReadValue
+		if (pStruct->pLayout && !pFrame->started)
+		{
+			if (!Take(pPush, pIn, pFrame->pVal, pStruct->size))
+			{
+				return EGSP_PUSH_MORE;
+			}
+			_EgspFixRaw(pFrame->pVal, 1, pStruct->pLayout);
+			pFrame->started = 1;
+		}
+
+		if (pFrame->field == pStruct->fieldCount)
+		{
+			// Done with this struct, which completes an item of the one holding it
+			if (--pPush->depth)
+			{
+				EgspPushFrame* pParent = pPush->frames + pPush->depth - 1;
+				NextItem(pParent, pParent->pStruct->pFields + pParent->field);
+			}
+			continue;
+		}
+
+		const EgspField* pField = pStruct->pFields + pFrame->field;
+		uint8_t* pMember = pFrame->pVal + pField->offset;
+		int result;
+		switch (pField->shape)
+		{
+		case EGSP_SHAPE_POINTER:
+			if (!pFrame->started)
+			{
+				if (!Take(pPush, pIn, pPush->scratch, 1))
+				{
+					return EGSP_PUSH_MORE;
+				}
+				pFrame->pItems = 0;
+				if (pPush->scratch[0] && !(pFrame->pItems = Alloc(pPush, pField->size)))
+				{
+					return EGSP_PUSH_ERROR;
+				}
+				memcpy(pMember, &pFrame->pItems, sizeof(void*));
+				pFrame->started = 1;
+			}
+			if (!pFrame->pItems)
+			{
+				NextField(pFrame);
+				continue;
+			}
+			result = ReadValue(pPush, pIn, pField, pFrame->pItems);
+			break;
+
+		case EGSP_SHAPE_ARRAY:
+			if (!pFrame->started)
+			{
+				// Sized like Load does, so the heap Save reports is enough
+				pFrame->count = LoadCount(pFrame->pVal + pField->countOffset, pField->countSize);
+				pFrame->index = 0;
+				if (pFrame->count > pPush->loader.heapSize / pField->size)
+				{
+					return EGSP_PUSH_ERROR;
+				}
+				size_t bytes = IsNumber(pField->kind) ? _EgspPad(&pPush->loader, pField->size * pFrame->count)
+					: _EgspPad(&pPush->loader, pField->size) * pFrame->count;
+				if (!(pFrame->pItems = Alloc(pPush, bytes)))
+				{
+					return EGSP_PUSH_ERROR;
+				}
+				memcpy(pMember, &pFrame->pItems, sizeof(void*));
+				pFrame->started = 1;
+			}
+
+			// Fixed width numbers and raw structs arrive in one piece and are put in native order once they are all there
+			if ((IsNumber(pField->kind) && IsFixed(pPush, pField->kind, pField->size)) || pField->kind == EGSP_KIND_RAW)
+			{
+				if (!Take(pPush, pIn, pFrame->pItems, pFrame->count * pField->size))
+				{
+					return EGSP_PUSH_MORE;
+				}
+				if (pField->kind == EGSP_KIND_RAW)
+				{
+					_EgspFixRaw(pFrame->pItems, pFrame->count, pField->pStruct->pLayout);
+				}
+				else
+				{
+					for (uint8_t* pItem = pFrame->pItems; pItem < pFrame->pItems + pFrame->count * pField->size; pItem += pField->size)
+					{
+						Store(pItem, FromBig(pItem, pField->size), pField->size);
+					}
+				}
+				NextField(pFrame);
+				continue;
+			}
+			if (pFrame->index == pFrame->count)
+			{
+				NextField(pFrame);
+				continue;
+			}
+			result = ReadValue(pPush, pIn, pField, pFrame->pItems + pFrame->index * pField->size);
+			break;
+
+		default:
+			result = ReadValue(pPush, pIn, pField, pMember);
+		}
+
+		if (result == EGSP_PUSH_DONE)
+		{
+			NextItem(pFrame, pField);
+		}
+		else if (result != EGSP_PUSH_NESTED)
+		{
+			return result;
+		}
+	}
+	return EGSP_PUSH_DONE;
+}
+
+void EgspPushInit(EgspPush* pPush, const EgspStructInfo* pStruct, void* pVal, void* pHeap, size_t heapSize)
+{
+	EgspInitLoader(&pPush->loader, 0, 0);
+	pPush->loader.pHeap = pHeap;
+	pPush->loader.heapSize = heapSize;
+	pPush->pStruct = pStruct;
+	memset(pPush->frames, 0, sizeof(pPush->frames[0]));
+	pPush->frames[0].pStruct = pStruct;
+	pPush->frames[0].pVal = (uint8_t*)pVal;
+	pPush->depth = 1;
+	pPush->failed = 0;
+	pPush->enveloped = 0;
+	pPush->pos = 0;
+	pPush->pString = 0;
+	pPush->length = 0;
+}
+
+EgspResult EgspPushData(EgspPush* pPush, const uint8_t* pData, size_t size, size_t* pUsed)
+{
+	EgspInput in = { pData, size };
+	int result = pPush->failed ? EGSP_PUSH_ERROR : Decode(pPush, &in);
+	if (pUsed)
+	{
+		*pUsed = size - in.size;
+	}
+
+	switch (result)
+	{
+	case EGSP_PUSH_DONE:
+		return EGSP_SUCCESS;
+	case EGSP_PUSH_MORE:
+		return EGSP_NEED_MORE;
+	default:
+		pPush->failed = 1;
+		return EGSP_FAIL;
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef EGSPPUSH_H
+#define EGSPPUSH_H
+
+#include "egsplib.h"
+
+// Structs nested deeper than this, through pointers or arrays, cannot be pushed
+#ifndef EGSP_PUSH_MAX_DEPTH
+#define EGSP_PUSH_MAX_DEPTH 64
+#endif
+
+// A struct being decoded, and how far into the current field it is
+typedef struct
+{
+	const EgspStructInfo* pStruct;
+	uint8_t* pVal;
+	size_t field;
+	int started;
+	size_t index;
+	size_t count;
+	uint8_t* pItems;
+} EgspPushFrame;
+
+// Decodes a stream as it arrives instead of pulling it through a block function, e.g. from a
+// non-blocking socket. Every push carries on exactly where the last one stopped, even in the middle
+// of a number or a string. Takes the same stream Save writes, with the settings in loader.
+// Strings are always copied to the heap, so a zero copy stream needs the heap a copying save reports.
+typedef struct
+{
+	EgspLoader loader;
+	const EgspStructInfo* pStruct;
+	EgspPushFrame frames[EGSP_PUSH_MAX_DEPTH];
+	size_t depth;
+	int failed;
+	int enveloped;
+
+	// The value being read, which may be split between pushes
+	size_t pos;
+	uint8_t scratch[EGSP_ENVELOPE_SIZE];
+	char* pString;
+	size_t length;
+} EgspPush;
+
+// Starts decoding into pVal, a struct described by pStruct, i.e. &s_egspInfo<Struct>.
+// The flags and alignment start out as the defaults and may be changed in loader before the first push.
+void EgspPushInit(EgspPush* pPush, const EgspStructInfo* pStruct, void* pVal, void* pHeap, size_t heapSize);
+
+// Decodes as much of size bytes as it can. EGSP_NEED_MORE means all of them were used and the struct is not
+// done yet. EGSP_SUCCESS means it is, and pUsed tells how many bytes it took, the rest being whatever
+// follows the stream. EGSP_FAIL is final.
+EgspResult EgspPushData(EgspPush* pPush, const uint8_t* pData, size_t size, size_t* pUsed);
+
+#endif
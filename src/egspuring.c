@@ -0,0 +1,436 @@
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+#include "egspuring.h"
+#include <string.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define EGSP_HAVE_URING
+#endif
+#endif
+
+// Result of a block whose write or read has not completed yet
+#define EGSP_PENDING INT64_MIN
+
+size_t EgspUringMemory(size_t blockSize, size_t depth)
+{
+	// Same layout as EgspAsync: room in front of each block for the leftovers of the previous one,
+	// and a block of room behind the last one
+	return depth * (sizeof(size_t) + sizeof(int64_t) + 2 * blockSize) + blockSize;
+}
+
+#ifndef _WIN32
+#include <errno.h>
+#include <unistd.h>
+
+#ifdef EGSP_HAVE_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#define __NR_io_uring_enter 426
+#define __NR_io_uring_register 427
+#endif
+
+static void TeardownRing(EgspUring* pUring)
+{
+	munmap(pUring->pSqes, pUring->sqeMapSize);
+	if (pUring->pCqMap != pUring->pSqMap)
+	{
+		munmap(pUring->pCqMap, pUring->cqMapSize);
+	}
+	munmap(pUring->pSqMap, pUring->sqMapSize);
+	close(pUring->ringFd);
+	pUring->ringFd = -1;
+}
+
+static void SetupRing(EgspUring* pUring)
+{
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	int ringFd = (int)syscall(__NR_io_uring_setup, (unsigned)pUring->depth, &params);
+	if (ringFd < 0)
+	{
+		return;
+	}
+
+	pUring->ringFd = ringFd;
+	pUring->sqMapSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	pUring->cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	pUring->sqeMapSize = params.sq_entries * sizeof(struct io_uring_sqe);
+	int single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (single)
+	{
+		pUring->sqMapSize = pUring->sqMapSize > pUring->cqMapSize ? pUring->sqMapSize : pUring->cqMapSize;
+	}
+
+	pUring->pSqMap = mmap(0, pUring->sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+	if (pUring->pSqMap == MAP_FAILED)
+	{
+		close(ringFd);
+		pUring->ringFd = -1;
+		return;
+	}
+	pUring->pCqMap = single ? pUring->pSqMap : mmap(0, pUring->cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+	if (pUring->pCqMap == MAP_FAILED)
+	{
+		munmap(pUring->pSqMap, pUring->sqMapSize);
+		close(ringFd);
+		pUring->ringFd = -1;
+		return;
+	}
+	pUring->pSqes = mmap(0, pUring->sqeMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+	if (pUring->pSqes == MAP_FAILED)
+	{
+		if (pUring->pCqMap != pUring->pSqMap)
+		{
+			munmap(pUring->pCqMap, pUring->cqMapSize);
+		}
+		munmap(pUring->pSqMap, pUring->sqMapSize);
+		close(ringFd);
+		pUring->ringFd = -1;
+		return;
+	}
+
+	uint8_t* pSq = (uint8_t*)pUring->pSqMap;
+	uint8_t* pCq = (uint8_t*)pUring->pCqMap;
+	pUring->pSqTail = (uint32_t*)(pSq + params.sq_off.tail);
+	pUring->pSqMask = (uint32_t*)(pSq + params.sq_off.ring_mask);
+	pUring->pSqArray = (uint32_t*)(pSq + params.sq_off.array);
+	pUring->pCqHead = (uint32_t*)(pCq + params.cq_off.head);
+	pUring->pCqTail = (uint32_t*)(pCq + params.cq_off.tail);
+	pUring->pCqMask = (uint32_t*)(pCq + params.cq_off.ring_mask);
+	pUring->pCqes = pCq + params.cq_off.cqes;
+
+	// Registered buffers save pinning the pages on every request, but the memlock limit may not allow them.
+	// Plain reads and writes with a file offset need a newer kernel than the fixed ones.
+	struct iovec iov = { pUring->pBlocks, pUring->depth * pUring->slotSize };
+	pUring->fixed = syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS, &iov, 1) == 0;
+	if (!pUring->fixed && !(params.features & IORING_FEAT_RW_CUR_POS))
+	{
+		TeardownRing(pUring);
+	}
+}
+
+static int Enter(EgspUring* pUring, unsigned wait)
+{
+	while (1)
+	{
+		++pUring->enters;
+		int submitted = (int)syscall(__NR_io_uring_enter, pUring->ringFd, (unsigned)pUring->unsubmitted, wait, wait ? IORING_ENTER_GETEVENTS : 0, 0, 0);
+		if (submitted >= 0)
+		{
+			pUring->unsubmitted -= (size_t)submitted;
+			return 1;
+		}
+		if (errno != EINTR)
+		{
+			pUring->error = 1;
+			return 0;
+		}
+	}
+}
+
+static void Reap(EgspUring* pUring)
+{
+	uint32_t head = *pUring->pCqHead;
+	uint32_t tail = __atomic_load_n(pUring->pCqTail, __ATOMIC_ACQUIRE);
+	for (; head != tail; ++head)
+	{
+		struct io_uring_cqe* pCqe = (struct io_uring_cqe*)pUring->pCqes + (head & *pUring->pCqMask);
+		pUring->pResults[pCqe->user_data] = pCqe->res;
+	}
+	__atomic_store_n(pUring->pCqHead, head, __ATOMIC_RELEASE);
+}
+#endif
+
+// Synchronous transfer used when there is no ring. Reads stop early only at the end of the file.
+static int64_t Transfer(int fd, uint8_t* pData, size_t size, uint64_t pos, int writing)
+{
+	size_t total = 0;
+	while (total < size)
+	{
+		ssize_t done = writing ? pwrite(fd, pData + total, size - total, (off_t)(pos + total)) : pread(fd, pData + total, size - total, (off_t)(pos + total));
+		if (done < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return -errno;
+		}
+		if (done == 0)
+		{
+			break;
+		}
+		total += (size_t)done;
+	}
+	return (int64_t)total;
+}
+
+static void Queue(EgspUring* pUring, size_t slot, uint8_t* pData, size_t size)
+{
+	pUring->pSizes[slot] = size;
+	pUring->pResults[slot] = EGSP_PENDING;
+	uint64_t pos = pUring->filePos;
+	pUring->filePos += size;
+	++pUring->produced;
+
+#ifdef EGSP_HAVE_URING
+	if (pUring->ringFd >= 0)
+	{
+		uint32_t tail = *pUring->pSqTail;
+		uint32_t index = tail & *pUring->pSqMask;
+		struct io_uring_sqe* pSqe = (struct io_uring_sqe*)pUring->pSqes + index;
+		memset(pSqe, 0, sizeof(*pSqe));
+		if (pUring->fixed)
+		{
+			pSqe->opcode = pUring->writing ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+		}
+		else
+		{
+			pSqe->opcode = pUring->writing ? IORING_OP_WRITE : IORING_OP_READ;
+		}
+		pSqe->fd = pUring->fd;
+		pSqe->off = pos;
+		pSqe->addr = (uint64_t)(uintptr_t)pData;
+		pSqe->len = (uint32_t)size;
+		pSqe->user_data = slot;
+		pUring->pSqArray[index] = index;
+		__atomic_store_n(pUring->pSqTail, tail + 1, __ATOMIC_RELEASE);
+
+		// Submit in batches of half the ring, so that the disk always has the other half to work on
+		if (++pUring->unsubmitted >= pUring->depth / 2)
+		{
+			Enter(pUring, 0);
+		}
+		return;
+	}
+#endif
+	pUring->pResults[slot] = Transfer(pUring->fd, pData, size, pos, pUring->writing);
+}
+
+static void WaitFor(EgspUring* pUring, size_t slot)
+{
+#ifdef EGSP_HAVE_URING
+	if (pUring->pResults[slot] == EGSP_PENDING)
+	{
+		++pUring->stalls;
+	}
+	while (pUring->pResults[slot] == EGSP_PENDING && Enter(pUring, 1))
+	{
+		Reap(pUring);
+	}
+#endif
+}
+
+// Hands completed writes back to the ring, in order
+static void Retire(EgspUring* pUring)
+{
+	while (pUring->consumed < pUring->produced)
+	{
+		size_t slot = pUring->consumed % pUring->depth;
+		if (pUring->pResults[slot] == EGSP_PENDING)
+		{
+			break;
+		}
+		// Regular files only write short when the disk is full
+		pUring->error |= pUring->pResults[slot] != (int64_t)pUring->pSizes[slot];
+		++pUring->consumed;
+	}
+}
+
+static EgspResult Open(EgspUring* pUring, int fd, void* pMemory, size_t blockSize, size_t depth, int writing)
+{
+	EGSP_TEST(depth >= 2);
+	pUring->fd = fd;
+	pUring->writing = writing;
+	pUring->pSizes = (size_t*)pMemory;
+	pUring->pResults = (int64_t*)(pUring->pSizes + depth);
+	pUring->pBlocks = (uint8_t*)(pUring->pResults + depth);
+	pUring->blockSize = blockSize;
+	pUring->slotSize = writing ? blockSize : 2 * blockSize;
+	pUring->depth = depth;
+	pUring->filePos = 0;
+	pUring->produced = 0;
+	pUring->consumed = 0;
+	pUring->unsubmitted = 0;
+	pUring->eof = 0;
+	pUring->error = 0;
+	pUring->active = 0;
+	pUring->start = 0;
+	pUring->length = 0;
+	pUring->stalls = 0;
+	pUring->enters = 0;
+	pUring->ringFd = -1;
+	pUring->fixed = 0;
+#ifdef EGSP_HAVE_URING
+	SetupRing(pUring);
+#endif
+
+	// Read ahead into every block of the ring straight away
+	for (size_t slot = 0; !writing && slot < depth; ++slot)
+	{
+		Queue(pUring, slot, pUring->pBlocks + slot * pUring->slotSize + blockSize, blockSize);
+	}
+	return EGSP_SUCCESS;
+}
+
+EgspResult EgspUringOpenWriter(EgspUring* pUring, int fd, void* pMemory, size_t blockSize, size_t depth)
+{
+	return Open(pUring, fd, pMemory, blockSize, depth, 1);
+}
+
+EgspResult EgspUringOpenReader(EgspUring* pUring, int fd, void* pMemory, size_t blockSize, size_t depth)
+{
+	return Open(pUring, fd, pMemory, blockSize, depth, 0);
+}
+
+EgspResult EgspUringClose(EgspUring* pUring)
+{
+	// Reads still in flight would land in memory the caller is about to free, so wait for those too
+	for (size_t i = pUring->consumed; i < pUring->produced; ++i)
+	{
+		WaitFor(pUring, i % pUring->depth);
+	}
+	if (pUring->writing)
+	{
+		Retire(pUring);
+	}
+#ifdef EGSP_HAVE_URING
+	if (pUring->ringFd >= 0)
+	{
+		TeardownRing(pUring);
+	}
+#endif
+	return pUring->error ? EGSP_FAIL : EGSP_SUCCESS;
+}
+
+static uint8_t* WriterFunc(EgspUring* pUring, size_t size)
+{
+	if (pUring->active && size)
+	{
+		size_t slot = pUring->produced % pUring->depth;
+		Queue(pUring, slot, pUring->pBlocks + slot * pUring->slotSize, size);
+	}
+
+	Retire(pUring);
+	while (pUring->produced - pUring->consumed >= pUring->depth && !pUring->error)
+	{
+		WaitFor(pUring, pUring->consumed % pUring->depth);
+		Retire(pUring);
+	}
+	if (pUring->error)
+	{
+		return 0;
+	}
+
+	pUring->active = 1;
+	return pUring->pBlocks + (pUring->produced % pUring->depth) * pUring->slotSize;
+}
+
+static uint8_t* ReaderFunc(EgspUring* pUring, size_t size)
+{
+	// Whatever the decoder did not use moves to the front of the next block
+	size_t leftover = pUring->active && size < pUring->length ? pUring->length - size : 0;
+	uint8_t* pLeftover = pUring->pBlocks + (pUring->consumed % pUring->depth) * pUring->slotSize + pUring->start + size;
+	size_t next = pUring->active ? pUring->consumed + 1 : pUring->consumed;
+
+	// Streamed blocks leave their last byte unused, so the leftovers grow by a byte per block.
+	// Once they make up a whole block, the decoder carries on in the current one instead.
+	int64_t got = 0;
+	if (leftover < pUring->blockSize && next < pUring->produced)
+	{
+		WaitFor(pUring, next % pUring->depth);
+		got = pUring->pResults[next % pUring->depth];
+		pUring->error |= got < 0;
+	}
+	if (pUring->error)
+	{
+		return 0;
+	}
+
+	if (got > 0)
+	{
+		size_t slot = next % pUring->depth;
+		uint8_t* pSlot = pUring->pBlocks + slot * pUring->slotSize;
+		memcpy(pSlot + pUring->blockSize - leftover, pLeftover, leftover);
+		pUring->eof |= (size_t)got < pUring->blockSize;
+
+		// The block the decoder is done with goes back to reading ahead
+		if (pUring->active)
+		{
+			size_t done = pUring->consumed++ % pUring->depth;
+			if (!pUring->eof)
+			{
+				Queue(pUring, done, pUring->pBlocks + done * pUring->slotSize + pUring->blockSize, pUring->blockSize);
+			}
+		}
+		pUring->active = 1;
+		pUring->start = pUring->blockSize - leftover;
+		pUring->length = leftover + (size_t)got;
+		return pSlot + pUring->start;
+	}
+
+	// The file has ended or a whole block is left over, and either way the rest is in the current block
+	if (leftover)
+	{
+		pUring->start += size;
+		pUring->length = leftover;
+		return pLeftover;
+	}
+	return 0;
+}
+
+uint8_t* EgspUringFunc(void* pUser, size_t size)
+{
+	EgspUring* pUring = (EgspUring*)pUser;
+	return pUring->writing ? WriterFunc(pUring, size) : ReaderFunc(pUring, size);
+}
+
+int EgspUringSupported()
+{
+#ifdef EGSP_HAVE_URING
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	int ringFd = (int)syscall(__NR_io_uring_setup, 1, &params);
+	if (ringFd >= 0)
+	{
+		close(ringFd);
+		return 1;
+	}
+#endif
+	return 0;
+}
+
+#else
+// Not supported on this platform yet
+EgspResult EgspUringOpenWriter(EgspUring* pUring, int fd, void* pMemory, size_t blockSize, size_t depth)
+{
+	return EGSP_FAIL;
+}
+
+EgspResult EgspUringOpenReader(EgspUring* pUring, int fd, void* pMemory, size_t blockSize, size_t depth)
+{
+	return EGSP_FAIL;
+}
+
+EgspResult EgspUringClose(EgspUring* pUring)
+{
+	return EGSP_FAIL;
+}
+
+uint8_t* EgspUringFunc(void* pUser, size_t size)
+{
+	return 0;
+}
+
+int EgspUringSupported()
+{
+	return 0;
+}
+#endif
@@ -0,0 +1,71 @@
+#ifndef EGSPURING_H
+#define EGSPURING_H
+
+#include "egsplib.h"
+
+// A ring of blocks written to (or read ahead from) a regular file through Linux io_uring, without
+// a thread of its own. Pass EgspUringFunc with the EgspUring as pUser to EgspInitLoader.
+// Filled blocks are submitted as a batch once half the ring is waiting, straight from registered
+// buffers. The reader keeps a read queued for every block in the ring that is not with the decoder.
+// Where io_uring is unavailable every block is a plain pwrite or pread instead, with the same results.
+typedef struct
+{
+	int fd;
+	int writing;
+	uint8_t* pBlocks;
+	size_t* pSizes;
+	int64_t* pResults;
+	size_t blockSize;
+	size_t slotSize;
+	size_t depth;
+
+	// File offset of the next block to queue
+	uint64_t filePos;
+
+	// Blocks queued, and blocks handed back to the ring in order
+	size_t produced;
+	size_t consumed;
+	size_t unsubmitted;
+	int eof;
+	int error;
+
+	// Whether a block is with the encoder or decoder, and which part of it holds data
+	int active;
+	size_t start;
+	size_t length;
+
+	// Times the encoder/decoder had to wait for the disk, and io_uring_enter calls made
+	size_t stalls;
+	size_t enters;
+
+	// io_uring state. ringFd is -1 when falling back to pwrite/pread.
+	int ringFd;
+	int fixed;
+	uint32_t* pSqTail;
+	uint32_t* pSqMask;
+	uint32_t* pSqArray;
+	uint32_t* pCqHead;
+	uint32_t* pCqTail;
+	uint32_t* pCqMask;
+	void* pSqes;
+	void* pCqes;
+	void* pSqMap;
+	size_t sqMapSize;
+	void* pCqMap;
+	size_t cqMapSize;
+	size_t sqeMapSize;
+} EgspUring;
+
+// Bytes of memory to hand to EgspUringOpen* for a ring of depth blocks. depth must be at least 2.
+size_t EgspUringMemory(size_t blockSize, size_t depth);
+EgspResult EgspUringOpenWriter(EgspUring* pUring, int fd, void* pMemory, size_t blockSize, size_t depth);
+EgspResult EgspUringOpenReader(EgspUring* pUring, int fd, void* pMemory, size_t blockSize, size_t depth);
+
+// Waits for the outstanding writes. Fails if any write failed.
+EgspResult EgspUringClose(EgspUring* pUring);
+uint8_t* EgspUringFunc(void* pUser, size_t size);
+
+// Whether this build and kernel support io_uring, i.e. whether EgspUring will fall back
+int EgspUringSupported();
+
+#endif
@@ -5,105 +5,610 @@
 
 #include "egsplib.h"
 
+static const uint64_t s_egspSchemaInnerStruct = 0x5dc274e54ec12555ull;
+
+static inline void _EgspGetInnerStruct(const uint8_t* pRun, InnerStruct* pVal)
+{
+	_EgspGetuint64_t(pRun + 0, &pVal->dummy);
+}
+
+static inline void _EgspPutInnerStruct(uint8_t* pRun, const InnerStruct* pVal)
+{
+	_EgspPutuint64_t(pRun + 0, &pVal->dummy);
+}
+
 static EgspResult _EgspLoadInnerStruct(EgspLoader* pLoader, InnerStruct* pVal)
 {
-	uint8_t egspNullCheck = 0;
+	EGSP_STATS_BEGIN
 	EGSP_TRY(_EgspLoaduint64_t(pLoader, &pVal->dummy));
+	EGSP_STATS_END(0, "InnerStruct");
 	return EGSP_SUCCESS;
 }
 
-static EgspResult EgspLoadInnerStruct(EgspFunc pLoadFunc, InnerStruct* pVal, void* pHeap, size_t heapSize)
+static inline EgspResult EgspLoadInnerStructEx(EgspLoader* pLoader, InnerStruct* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaInnerStruct));
+	return _EgspLoadInnerStruct(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadInnerStruct(EgspFunc pLoadFunc, InnerStruct* pVal, void* pHeap, size_t heapSize)
 {
 	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
 	loader.pFunc = pLoadFunc;
-	loader.offset = 0;
-	loader.pHeap = pHeap;
-	loader.heapSize = heapSize;
-	EGSP_TEST(loader.pData = loader.pFunc(EgspBlockSize()));
-	EGSP_TRY(_EgspLoadInnerStruct(&loader, pVal));
-	return EGSP_SUCCESS;
+	return EgspLoadInnerStructEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadInnerStructSpan(const uint8_t* pData, size_t size, InnerStruct* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadInnerStructEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureInnerStruct(EgspLoader* pLoader, InnerStruct* pVal)
+{
+	_EgspMeasureuint64_t(pLoader, &pVal->dummy);
+}
+
+static inline size_t EgspMeasureInnerStructEx(EgspLoader* pLoader, InnerStruct* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureInnerStruct(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureInnerStruct(InnerStruct* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureInnerStructEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
 }
 
 static EgspResult _EgspSaveInnerStruct(EgspLoader* pLoader, InnerStruct* pVal)
 {
+	EGSP_STATS_BEGIN
 	EGSP_TRY(_EgspSaveuint64_t(pLoader, &pVal->dummy));
+	EGSP_STATS_END(0, "InnerStruct");
 	return EGSP_SUCCESS;
 }
 
-static EgspResult EgspSaveInnerStruct(EgspFunc pFlushFunc, InnerStruct* pVal, size_t* pHeapRequired)
+static inline EgspResult EgspSaveInnerStructEx(EgspLoader* pLoader, InnerStruct* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureInnerStructEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaInnerStruct, size, heapSize));
+	EGSP_TRY(_EgspSaveInnerStruct(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveInnerStruct(EgspFunc pFlushFunc, InnerStruct* pVal, size_t* pHeapRequired)
 {
 	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
 	loader.pFunc = pFlushFunc;
-	loader.offset = 0;
-	loader.heapSize = 0;
-	EGSP_TEST(loader.pData = loader.pFunc(0));
-	EGSP_TRY(_EgspSaveInnerStruct(&loader, pVal))
-;	EGSP_TRY(EgspFlush(&loader));
+	EGSP_TRY(EgspSaveInnerStructEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveInnerStructSpan(uint8_t* pData, size_t size, InnerStruct* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveInnerStructEx(&loader, pVal));
+	*pWritten = loader.offset;
 	*pHeapRequired = loader.heapSize;
 	return EGSP_SUCCESS;
 }
 
+static const EgspField s_egspFieldsInnerStruct[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(InnerStruct, dummy), sizeof(((InnerStruct*)0)->dummy), 0, 0, 0, "dummy" },
+};
+
+static const EgspStructInfo s_egspInfoInnerStruct = { sizeof(InnerStruct), s_egspFieldsInnerStruct, 1, 0, s_egspSchemaInnerStruct, 8, "InnerStruct", 0 };
+
 static EgspResult _EgspPrintInnerStruct(EgspLoader* pLoader, InnerStruct* pVal)
 {
+	EGSP_STATS_BEGIN
 	EGSP_TRY(_EgspWriteString(pLoader, "{"));
-	EGSP_TRY(_EgspWriteString(pLoader, "\"dummy\":"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"dummy\":", 8));
 	EGSP_TRY(_EgspPrintuint64_t(pLoader, &pVal->dummy));
-	return _EgspWriteString(pLoader, "},");
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(0, "InnerStruct");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintInnerStructEx(EgspLoader* pLoader, InnerStruct* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintInnerStruct(pLoader, pVal));
+	return EgspFlush(pLoader);
 }
 
-static EgspResult EgspPrintInnerStruct(EgspFunc pFlushFunc, InnerStruct* pVal, size_t* pHeapRequired)
+static inline EgspResult EgspPrintInnerStruct(EgspFunc pFlushFunc, InnerStruct* pVal, size_t* pHeapRequired)
 {
 	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
 	loader.pFunc = pFlushFunc;
-	loader.offset = 0;
-	loader.heapSize = 0;
-	loader.last = 0;
-	loader.indent = 0;
-	EGSP_TEST(loader.pData = loader.pFunc(EgspBlockSize()));
-	EGSP_TRY(_EgspPrintInnerStruct(&loader, pVal));
-	EGSP_TRY(EgspFlush(&loader));
+	EGSP_TRY(EgspPrintInnerStructEx(&loader, pVal));
 	*pHeapRequired = loader.heapSize;
 	return EGSP_SUCCESS;
 }
 
 static EgspResult _EgspReadInnerStruct(EgspLoader* pLoader, InnerStruct* pVal)
 {
-	uint8_t egspNullCheck = 0;
+	EGSP_STATS_BEGIN
 	EGSP_TRY(_EgspSkipLabel(pLoader));
 	EGSP_TRY(_EgspReaduint64_t(pLoader, &pVal->dummy));
+	EGSP_STATS_END(0, "InnerStruct");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadInnerStructEx(EgspLoader* pLoader, InnerStruct* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadInnerStruct(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadInnerStruct(EgspFunc pLoadFunc, InnerStruct* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadInnerStructEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaVertex = 0xa03a3231a7b56428ull;
+
+EGSP_STATIC_ASSERT(offsetof(Vertex, x) == 0, Vertex_x);
+EGSP_STATIC_ASSERT(offsetof(Vertex, y) == 4, Vertex_y);
+EGSP_STATIC_ASSERT(offsetof(Vertex, z) == 8, Vertex_z);
+EGSP_STATIC_ASSERT(offsetof(Vertex, color) == 12, Vertex_color);
+EGSP_STATIC_ASSERT(sizeof(Vertex) == 16, Vertex_size);
+static const uint8_t s_egspLayoutVertex[] = { 4, 4, 4, 4, 0 };
+
+static inline void _EgspGetVertex(const uint8_t* pRun, Vertex* pVal)
+{
+	memcpy(pVal, pRun, sizeof(Vertex));
+	_EgspFixRaw(pVal, 1, s_egspLayoutVertex);
+}
+
+static inline void _EgspPutVertex(uint8_t* pRun, const Vertex* pVal)
+{
+	memcpy(pRun, pVal, sizeof(Vertex));
+	_EgspFixRaw(pRun, 1, s_egspLayoutVertex);
+}
+
+static EgspResult _EgspLoadVertex(EgspLoader* pLoader, Vertex* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoadRaw(pLoader, pVal, 1, sizeof(Vertex), s_egspLayoutVertex));
+	EGSP_STATS_END(1, "Vertex");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspLoadVertexEx(EgspLoader* pLoader, Vertex* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaVertex));
+	return _EgspLoadVertex(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadVertex(EgspFunc pLoadFunc, Vertex* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspLoadVertexEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadVertexSpan(const uint8_t* pData, size_t size, Vertex* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadVertexEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureVertex(EgspLoader* pLoader, Vertex* pVal)
+{
+	(void)pVal;
+	_EgspMeasureBytes(pLoader, sizeof(Vertex));
+}
+
+static inline size_t EgspMeasureVertexEx(EgspLoader* pLoader, Vertex* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureVertex(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureVertex(Vertex* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureVertexEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveVertex(EgspLoader* pLoader, Vertex* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveRaw(pLoader, pVal, 1, sizeof(Vertex), s_egspLayoutVertex));
+	EGSP_STATS_END(1, "Vertex");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveVertexEx(EgspLoader* pLoader, Vertex* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureVertexEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaVertex, size, heapSize));
+	EGSP_TRY(_EgspSaveVertex(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveVertex(EgspFunc pFlushFunc, Vertex* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveVertexEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveVertexSpan(uint8_t* pData, size_t size, Vertex* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveVertexEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsVertex[] = {
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Vertex, x), sizeof(((Vertex*)0)->x), 0, 0, 0, "x" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Vertex, y), sizeof(((Vertex*)0)->y), 0, 0, 0, "y" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(Vertex, z), sizeof(((Vertex*)0)->z), 0, 0, 0, "z" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Vertex, color), sizeof(((Vertex*)0)->color), 0, 0, 0, "color" },
+};
+
+static const EgspStructInfo s_egspInfoVertex = { sizeof(Vertex), s_egspFieldsVertex, 0, s_egspLayoutVertex, s_egspSchemaVertex, 16, "Vertex", 1 };
+
+static EgspResult _EgspPrintVertex(EgspLoader* pLoader, Vertex* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"x\":", 4));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->x));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"y\":", 4));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->y));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"z\":", 4));
+	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->z));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"color\":", 8));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->color));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(1, "Vertex");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintVertexEx(EgspLoader* pLoader, Vertex* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintVertex(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintVertex(EgspFunc pFlushFunc, Vertex* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintVertexEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadVertex(EgspLoader* pLoader, Vertex* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->x));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->y));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadfloat(pLoader, &pVal->z));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->color));
+	EGSP_STATS_END(1, "Vertex");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadVertexEx(EgspLoader* pLoader, Vertex* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadVertex(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadVertex(EgspFunc pLoadFunc, Vertex* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadVertexEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaLabel = 0xd87262ddad1db7b7ull;
+
+static EgspResult _EgspLoadLabel(EgspLoader* pLoader, Label* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoadstring(pLoader, &pVal->name));
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->id));
+	EGSP_STATS_END(2, "Label");
 	return EGSP_SUCCESS;
 }
 
-static EgspResult EgspReadInnerStruct(EgspFunc pLoadFunc, InnerStruct* pVal, void* pHeap, size_t heapSize)
+static inline EgspResult EgspLoadLabelEx(EgspLoader* pLoader, Label* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaLabel));
+	return _EgspLoadLabel(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadLabel(EgspFunc pLoadFunc, Label* pVal, void* pHeap, size_t heapSize)
 {
 	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
 	loader.pFunc = pLoadFunc;
-	loader.offset = 0;
-	loader.pHeap = pHeap;
-	loader.heapSize = heapSize;
-	EGSP_TEST(loader.pData = loader.pFunc(0));
-	EGSP_TRY(_EgspReadInnerStruct(&loader, pVal));
+	return EgspLoadLabelEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadLabelSpan(const uint8_t* pData, size_t size, Label* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadLabelEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureLabel(EgspLoader* pLoader, Label* pVal)
+{
+	_EgspMeasurestring(pLoader, &pVal->name);
+	_EgspMeasureuint32_t(pLoader, &pVal->id);
+}
+
+static inline size_t EgspMeasureLabelEx(EgspLoader* pLoader, Label* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureLabel(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureLabel(Label* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureLabelEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveLabel(EgspLoader* pLoader, Label* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSavestring(pLoader, &pVal->name));
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->id));
+	EGSP_STATS_END(2, "Label");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveLabelEx(EgspLoader* pLoader, Label* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureLabelEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaLabel, size, heapSize));
+	EGSP_TRY(_EgspSaveLabel(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveLabel(EgspFunc pFlushFunc, Label* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveLabelEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveLabelSpan(uint8_t* pData, size_t size, Label* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveLabelEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspField s_egspFieldsLabel[] = {
+	{ EGSP_KIND_STRING, EGSP_SHAPE_VALUE, offsetof(Label, name), sizeof(((Label*)0)->name), 0, 0, 0, "name" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(Label, id), sizeof(((Label*)0)->id), 0, 0, 0, "id" },
+};
+
+static const EgspStructInfo s_egspInfoLabel = { sizeof(Label), s_egspFieldsLabel, 2, 0, s_egspSchemaLabel, 0, "Label", 2 };
+
+static EgspResult _EgspPrintLabel(EgspLoader* pLoader, Label* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"name\":", 7));
+	EGSP_TRY(_EgspPrintstring(pLoader, &pVal->name));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"id\":", 5));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->id));
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(2, "Label");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintLabelEx(EgspLoader* pLoader, Label* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintLabel(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintLabel(EgspFunc pFlushFunc, Label* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintLabelEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadLabel(EgspLoader* pLoader, Label* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadstring(pLoader, &pVal->name));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->id));
+	EGSP_STATS_END(2, "Label");
 	return EGSP_SUCCESS;
 }
 
+static inline EgspResult EgspReadLabelEx(EgspLoader* pLoader, Label* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadLabel(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadLabel(EgspFunc pLoadFunc, Label* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadLabelEx(&loader, pVal, pHeap, heapSize);
+}
+
+static EgspResult _EgspSaveElementInnerStruct(EgspLoader* pLoader, const void* pVal)
+{
+	return _EgspSaveInnerStruct(pLoader, (InnerStruct*)pVal);
+}
+
+static EgspResult _EgspSaveElementLabel(EgspLoader* pLoader, const void* pVal)
+{
+	return _EgspSaveLabel(pLoader, (Label*)pVal);
+}
+
+static const uint64_t s_egspSchemaTestStruct = 0x089c3dbf5eba3836ull;
+
 static EgspResult _EgspLoadTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 {
-	uint8_t egspNullCheck = 0;
-	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->testint));
-	EGSP_TRY(_EgspLoadfloat(pLoader, &pVal->testfloat));
-	EGSP_TRY(_EgspLoadint16_t(pLoader, &pVal->testsigned));
-	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->structcount));
-	if (pVal->teststruct = EgspAlloc(pLoader, EgspPad(sizeof(InnerStruct)) * pVal->structcount))
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 14);
+		if (pRun)
+		{
+			_EgspGetuint32_t(pRun + 0, &pVal->testint);
+			_EgspGetfloat(pRun + 4, &pVal->testfloat);
+			_EgspGetint16_t(pRun + 8, &pVal->testsigned);
+			_EgspGetuint32_t(pRun + 10, &pVal->structcount);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->testint));
+			EGSP_TRY(_EgspLoadfloat(pLoader, &pVal->testfloat));
+			EGSP_TRY(_EgspLoadint16_t(pLoader, &pVal->testsigned));
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->structcount));
+		}
+	}
+	if ((pVal->teststruct = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->teststruct)) * pVal->structcount)))
 	{
 		for (size_t i = 0; i < pVal->structcount; ++i)
 		{
 			EGSP_TRY(_EgspLoadInnerStruct(pLoader, pVal->teststruct + i));
 		}
 	}
+	uint8_t egspNullCheck = 0;
 	EGSP_TRY(_EgspLoaduint8_t(pLoader, &egspNullCheck));
 	if (egspNullCheck)
 	{
-		EGSP_TEST(pVal->pointerstruct = EgspAlloc(pLoader, EgspPad(sizeof(InnerStruct))))
+		EGSP_TEST(pVal->pointerstruct = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(InnerStruct))))
 		EGSP_TRY(_EgspLoadInnerStruct(pLoader, pVal->pointerstruct));
 	}
 	else
@@ -113,7 +618,7 @@ static EgspResult _EgspLoadTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 	EGSP_TRY(_EgspLoaduint8_t(pLoader, &egspNullCheck));
 	if (egspNullCheck)
 	{
-		EGSP_TEST(pVal->nullstruct = EgspAlloc(pLoader, EgspPad(sizeof(InnerStruct))))
+		EGSP_TEST(pVal->nullstruct = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(InnerStruct))))
 		EGSP_TRY(_EgspLoadInnerStruct(pLoader, pVal->nullstruct));
 	}
 	else
@@ -123,39 +628,194 @@ static EgspResult _EgspLoadTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 	EGSP_TRY(_EgspLoadInnerStruct(pLoader, &pVal->inlinestruct));
 	EGSP_TRY(_EgspLoadstring(pLoader, &pVal->TestString));
 	{
-		int32_t enumval = 0;
-		EGSP_TRY(_EgspLoadint32_t(pLoader, &enumval));
-		pVal->testenum = (TestEnum) enumval;
+		uint8_t* pRun = _EgspRun(pLoader, 8);
+		if (pRun)
+		{
+			pVal->testenum = (TestEnum)(int32_t)_EgspBig32(pRun + 0);
+			_EgspGetuint32_t(pRun + 4, &pVal->wordcount);
+		}
+		else
+		{
+			{
+				int32_t enumval = 0;
+				EGSP_TRY(_EgspLoadint32_t(pLoader, &enumval));
+				pVal->testenum = (TestEnum) enumval;
+			}
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->wordcount));
+		}
+	}
+	if ((pVal->words = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->words) * pVal->wordcount))))
+	{
+		EGSP_TRY(_EgspLoadArray(pLoader, (void*)pVal->words, pVal->wordcount, sizeof(*pVal->words), EGSP_KIND_UNSIGNED));
+	}
+	if ((pVal->longs = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->longs) * pVal->wordcount))))
+	{
+		EGSP_TRY(_EgspLoadArray(pLoader, (void*)pVal->longs, pVal->wordcount, sizeof(*pVal->longs), EGSP_KIND_UNSIGNED));
+	}
+	if ((pVal->shorts = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->shorts) * pVal->wordcount))))
+	{
+		EGSP_TRY(_EgspLoadArray(pLoader, (void*)pVal->shorts, pVal->wordcount, sizeof(*pVal->shorts), EGSP_KIND_SIGNED));
+	}
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 20);
+		if (pRun)
+		{
+			_EgspGetVertex(pRun + 0, &pVal->origin);
+			_EgspGetuint32_t(pRun + 16, &pVal->vertexcount);
+		}
+		else
+		{
+			EGSP_TRY(_EgspLoadVertex(pLoader, &pVal->origin));
+			EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->vertexcount));
+		}
+	}
+	if ((pVal->vertices = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->vertices)) * pVal->vertexcount)))
+	{
+		EGSP_TRY(_EgspLoadRaw(pLoader, pVal->vertices, pVal->vertexcount, sizeof(*pVal->vertices), s_egspLayoutVertex));
+	}
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->labelcount));
+	if ((pVal->labels = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->labels)) * pVal->labelcount)))
+	{
+		for (size_t i = 0; i < pVal->labelcount; ++i)
+		{
+			EGSP_TRY(_EgspLoadLabel(pLoader, pVal->labels + i));
+		}
 	}
+	EGSP_STATS_END(3, "TestStruct");
 	return EGSP_SUCCESS;
 }
 
-static EgspResult EgspLoadTestStruct(EgspFunc pLoadFunc, TestStruct* pVal, void* pHeap, size_t heapSize)
+static inline EgspResult EgspLoadTestStructEx(EgspLoader* pLoader, TestStruct* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaTestStruct));
+	return _EgspLoadTestStruct(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadTestStruct(EgspFunc pLoadFunc, TestStruct* pVal, void* pHeap, size_t heapSize)
 {
 	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
 	loader.pFunc = pLoadFunc;
-	loader.offset = 0;
-	loader.pHeap = pHeap;
-	loader.heapSize = heapSize;
-	EGSP_TEST(loader.pData = loader.pFunc(EgspBlockSize()));
-	EGSP_TRY(_EgspLoadTestStruct(&loader, pVal));
-	return EGSP_SUCCESS;
+	return EgspLoadTestStructEx(&loader, pVal, pHeap, heapSize);
 }
 
-static EgspResult _EgspSaveTestStruct(EgspLoader* pLoader, TestStruct* pVal)
+static inline EgspResult EgspLoadTestStructSpan(const uint8_t* pData, size_t size, TestStruct* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadTestStructEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 {
-	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->testint));
-	EGSP_TRY(_EgspSavefloat(pLoader, &pVal->testfloat));
-	EGSP_TRY(_EgspSaveint16_t(pLoader, &pVal->testsigned));
-	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->structcount));
-	pLoader->heapSize += EgspPad(sizeof(*pVal->teststruct)) * pVal->structcount;
+	_EgspMeasureuint32_t(pLoader, &pVal->testint);
+	_EgspMeasurefloat(pLoader, &pVal->testfloat);
+	_EgspMeasureint16_t(pLoader, &pVal->testsigned);
+	_EgspMeasureuint32_t(pLoader, &pVal->structcount);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->teststruct)) * pVal->structcount;
 	for (size_t i = 0; i < pVal->structcount; ++i)
 	{
-		EGSP_TRY(_EgspSaveInnerStruct(pLoader, pVal->teststruct + i));
+		_EgspMeasureInnerStruct(pLoader, pVal->teststruct + i);
+	}
+	_EgspMeasureBytes(pLoader, sizeof(uint8_t));
+	if (pVal->pointerstruct)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->pointerstruct));
+		_EgspMeasureInnerStruct(pLoader, pVal->pointerstruct);
+	}
+	_EgspMeasureBytes(pLoader, sizeof(uint8_t));
+	if (pVal->nullstruct)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->nullstruct));
+		_EgspMeasureInnerStruct(pLoader, pVal->nullstruct);
+	}
+	_EgspMeasureInnerStruct(pLoader, &pVal->inlinestruct);
+	_EgspMeasurestring(pLoader, &pVal->TestString);
+	{
+		int32_t enumval = pVal->testenum;
+		_EgspMeasureint32_t(pLoader, &enumval);
+	}
+	_EgspMeasureuint32_t(pLoader, &pVal->wordcount);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->words) * pVal->wordcount);
+	_EgspMeasureArray(pLoader, pVal->words, pVal->wordcount, sizeof(*pVal->words), EGSP_KIND_UNSIGNED);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->longs) * pVal->wordcount);
+	_EgspMeasureArray(pLoader, pVal->longs, pVal->wordcount, sizeof(*pVal->longs), EGSP_KIND_UNSIGNED);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->shorts) * pVal->wordcount);
+	_EgspMeasureArray(pLoader, pVal->shorts, pVal->wordcount, sizeof(*pVal->shorts), EGSP_KIND_SIGNED);
+	_EgspMeasureVertex(pLoader, &pVal->origin);
+	_EgspMeasureuint32_t(pLoader, &pVal->vertexcount);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->vertices)) * pVal->vertexcount;
+	_EgspMeasureBytes(pLoader, sizeof(*pVal->vertices) * pVal->vertexcount);
+	_EgspMeasureuint32_t(pLoader, &pVal->labelcount);
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->labels)) * pVal->labelcount;
+	for (size_t i = 0; i < pVal->labelcount; ++i)
+	{
+		_EgspMeasureLabel(pLoader, pVal->labels + i);
+	}
+}
+
+static inline size_t EgspMeasureTestStructEx(EgspLoader* pLoader, TestStruct* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureTestStruct(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureTestStruct(TestStruct* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureTestStructEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveTestStruct(EgspLoader* pLoader, TestStruct* pVal)
+{
+	EGSP_STATS_BEGIN
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 14);
+		if (pRun)
+		{
+			_EgspPutuint32_t(pRun + 0, &pVal->testint);
+			_EgspPutfloat(pRun + 4, &pVal->testfloat);
+			_EgspPutint16_t(pRun + 8, &pVal->testsigned);
+			_EgspPutuint32_t(pRun + 10, &pVal->structcount);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->testint));
+			EGSP_TRY(_EgspSavefloat(pLoader, &pVal->testfloat));
+			EGSP_TRY(_EgspSaveint16_t(pLoader, &pVal->testsigned));
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->structcount));
+		}
+	}
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->teststruct)) * pVal->structcount;
+	if (_EgspParallel(pLoader, pVal->structcount))
+	{
+		EGSP_TRY(_EgspSaveArrayParallel(pLoader, pVal->teststruct, pVal->structcount, sizeof(*pVal->teststruct), _EgspSaveElementInnerStruct));
+	}
+	else
+	{
+		for (size_t i = 0; i < pVal->structcount; ++i)
+		{
+			EGSP_TRY(_EgspSaveInnerStruct(pLoader, pVal->teststruct + i));
+		}
 	}
 	if (pVal->pointerstruct)
 	{
-		pLoader->heapSize += EgspPad(sizeof(*pVal->pointerstruct));
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->pointerstruct));
 		uint8_t nullInd = 1;
 		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
 		EGSP_TRY(_EgspSaveInnerStruct(pLoader, pVal->pointerstruct));
@@ -167,7 +827,7 @@ static EgspResult _EgspSaveTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 	}
 	if (pVal->nullstruct)
 	{
-		pLoader->heapSize += EgspPad(sizeof(*pVal->nullstruct));
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->nullstruct));
 		uint8_t nullInd = 1;
 		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
 		EGSP_TRY(_EgspSaveInnerStruct(pLoader, pVal->nullstruct));
@@ -180,38 +840,136 @@ static EgspResult _EgspSaveTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 	EGSP_TRY(_EgspSaveInnerStruct(pLoader, &pVal->inlinestruct));
 	EGSP_TRY(_EgspSavestring(pLoader, &pVal->TestString));
 	{
-		int32_t enumval = pVal->testenum;
-	EGSP_TRY(_EgspSaveint32_t(pLoader, &enumval));
+		uint8_t* pRun = _EgspRun(pLoader, 8);
+		if (pRun)
+		{
+			_EgspPutBig32(pRun + 0, (uint32_t)(int32_t)pVal->testenum);
+			_EgspPutuint32_t(pRun + 4, &pVal->wordcount);
+		}
+		else
+		{
+			{
+				int32_t enumval = pVal->testenum;
+			EGSP_TRY(_EgspSaveint32_t(pLoader, &enumval));
+			}
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->wordcount));
+		}
+	}
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->words) * pVal->wordcount);
+	EGSP_TRY(_EgspSaveArray(pLoader, pVal->words, pVal->wordcount, sizeof(*pVal->words), EGSP_KIND_UNSIGNED));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->longs) * pVal->wordcount);
+	EGSP_TRY(_EgspSaveArray(pLoader, pVal->longs, pVal->wordcount, sizeof(*pVal->longs), EGSP_KIND_UNSIGNED));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->shorts) * pVal->wordcount);
+	EGSP_TRY(_EgspSaveArray(pLoader, pVal->shorts, pVal->wordcount, sizeof(*pVal->shorts), EGSP_KIND_SIGNED));
+	{
+		uint8_t* pRun = _EgspRun(pLoader, 20);
+		if (pRun)
+		{
+			_EgspPutVertex(pRun + 0, &pVal->origin);
+			_EgspPutuint32_t(pRun + 16, &pVal->vertexcount);
+		}
+		else
+		{
+			EGSP_TRY(_EgspSaveVertex(pLoader, &pVal->origin));
+			EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->vertexcount));
+		}
+	}
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->vertices)) * pVal->vertexcount;
+	EGSP_TRY(_EgspSaveRaw(pLoader, pVal->vertices, pVal->vertexcount, sizeof(*pVal->vertices), s_egspLayoutVertex));
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->labelcount));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->labels)) * pVal->labelcount;
+	if (_EgspParallel(pLoader, pVal->labelcount))
+	{
+		EGSP_TRY(_EgspSaveArrayParallel(pLoader, pVal->labels, pVal->labelcount, sizeof(*pVal->labels), _EgspSaveElementLabel));
+	}
+	else
+	{
+		for (size_t i = 0; i < pVal->labelcount; ++i)
+		{
+			EGSP_TRY(_EgspSaveLabel(pLoader, pVal->labels + i));
+		}
 	}
+	EGSP_STATS_END(3, "TestStruct");
 	return EGSP_SUCCESS;
 }
 
-static EgspResult EgspSaveTestStruct(EgspFunc pFlushFunc, TestStruct* pVal, size_t* pHeapRequired)
+static inline EgspResult EgspSaveTestStructEx(EgspLoader* pLoader, TestStruct* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureTestStructEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaTestStruct, size, heapSize));
+	EGSP_TRY(_EgspSaveTestStruct(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveTestStruct(EgspFunc pFlushFunc, TestStruct* pVal, size_t* pHeapRequired)
 {
 	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
 	loader.pFunc = pFlushFunc;
-	loader.offset = 0;
-	loader.heapSize = 0;
-	EGSP_TEST(loader.pData = loader.pFunc(0));
-	EGSP_TRY(_EgspSaveTestStruct(&loader, pVal))
-;	EGSP_TRY(EgspFlush(&loader));
+	EGSP_TRY(EgspSaveTestStructEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveTestStructSpan(uint8_t* pData, size_t size, TestStruct* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveTestStructEx(&loader, pVal));
+	*pWritten = loader.offset;
 	*pHeapRequired = loader.heapSize;
 	return EGSP_SUCCESS;
 }
 
+static const EgspField s_egspFieldsTestStruct[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(TestStruct, testint), sizeof(((TestStruct*)0)->testint), 0, 0, 0, "testint" },
+	{ EGSP_KIND_FLOAT, EGSP_SHAPE_VALUE, offsetof(TestStruct, testfloat), sizeof(((TestStruct*)0)->testfloat), 0, 0, 0, "testfloat" },
+	{ EGSP_KIND_SIGNED, EGSP_SHAPE_VALUE, offsetof(TestStruct, testsigned), sizeof(((TestStruct*)0)->testsigned), 0, 0, 0, "testsigned" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(TestStruct, structcount), sizeof(((TestStruct*)0)->structcount), 0, 0, 0, "structcount" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_ARRAY, offsetof(TestStruct, teststruct), sizeof(*((TestStruct*)0)->teststruct), offsetof(TestStruct, structcount), sizeof(((TestStruct*)0)->structcount), &s_egspInfoInnerStruct, "teststruct" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_POINTER, offsetof(TestStruct, pointerstruct), sizeof(*((TestStruct*)0)->pointerstruct), 0, 0, &s_egspInfoInnerStruct, "pointerstruct" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_POINTER, offsetof(TestStruct, nullstruct), sizeof(*((TestStruct*)0)->nullstruct), 0, 0, &s_egspInfoInnerStruct, "nullstruct" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_VALUE, offsetof(TestStruct, inlinestruct), sizeof(((TestStruct*)0)->inlinestruct), 0, 0, &s_egspInfoInnerStruct, "inlinestruct" },
+	{ EGSP_KIND_STRING, EGSP_SHAPE_VALUE, offsetof(TestStruct, TestString), sizeof(((TestStruct*)0)->TestString), 0, 0, 0, "TestString" },
+	{ EGSP_KIND_ENUM, EGSP_SHAPE_VALUE, offsetof(TestStruct, testenum), sizeof(((TestStruct*)0)->testenum), 0, 0, 0, "testenum" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(TestStruct, wordcount), sizeof(((TestStruct*)0)->wordcount), 0, 0, 0, "wordcount" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_ARRAY, offsetof(TestStruct, words), sizeof(*((TestStruct*)0)->words), offsetof(TestStruct, wordcount), sizeof(((TestStruct*)0)->wordcount), 0, "words" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_ARRAY, offsetof(TestStruct, longs), sizeof(*((TestStruct*)0)->longs), offsetof(TestStruct, wordcount), sizeof(((TestStruct*)0)->wordcount), 0, "longs" },
+	{ EGSP_KIND_SIGNED, EGSP_SHAPE_ARRAY, offsetof(TestStruct, shorts), sizeof(*((TestStruct*)0)->shorts), offsetof(TestStruct, wordcount), sizeof(((TestStruct*)0)->wordcount), 0, "shorts" },
+	{ EGSP_KIND_RAW, EGSP_SHAPE_VALUE, offsetof(TestStruct, origin), sizeof(((TestStruct*)0)->origin), 0, 0, &s_egspInfoVertex, "origin" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(TestStruct, vertexcount), sizeof(((TestStruct*)0)->vertexcount), 0, 0, 0, "vertexcount" },
+	{ EGSP_KIND_RAW, EGSP_SHAPE_ARRAY, offsetof(TestStruct, vertices), sizeof(*((TestStruct*)0)->vertices), offsetof(TestStruct, vertexcount), sizeof(((TestStruct*)0)->vertexcount), &s_egspInfoVertex, "vertices" },
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(TestStruct, labelcount), sizeof(((TestStruct*)0)->labelcount), 0, 0, 0, "labelcount" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_ARRAY, offsetof(TestStruct, labels), sizeof(*((TestStruct*)0)->labels), offsetof(TestStruct, labelcount), sizeof(((TestStruct*)0)->labelcount), &s_egspInfoLabel, "labels" },
+};
+
+static const EgspStructInfo s_egspInfoTestStruct = { sizeof(TestStruct), s_egspFieldsTestStruct, 19, 0, s_egspSchemaTestStruct, 0, "TestStruct", 3 };
+
 static EgspResult _EgspPrintTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 {
+	EGSP_STATS_BEGIN
 	EGSP_TRY(_EgspWriteString(pLoader, "{"));
-	EGSP_TRY(_EgspWriteString(pLoader, "\"testint\":"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"testint\":", 10));
 	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->testint));
-	EGSP_TRY(_EgspWriteString(pLoader, "\"testfloat\":"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"testfloat\":", 12));
 	EGSP_TRY(_EgspPrintfloat(pLoader, &pVal->testfloat));
-	EGSP_TRY(_EgspWriteString(pLoader, "\"testsigned\":"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"testsigned\":", 13));
 	EGSP_TRY(_EgspPrintint16_t(pLoader, &pVal->testsigned));
-	EGSP_TRY(_EgspWriteString(pLoader, "\"structcount\":"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"structcount\":", 14));
 	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->structcount));
-	pLoader->heapSize += EgspPad(sizeof(*pVal->teststruct)) * pVal->structcount;
-	EGSP_TRY(_EgspWriteString(pLoader, "\"teststruct\":["));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->teststruct)) * pVal->structcount;
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"teststruct\":", 13));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
 	for (size_t i = 0; i < pVal->structcount; ++i)
 	{
 		EGSP_TRY(_EgspPrintInnerStruct(pLoader, pVal->teststruct + i));
@@ -219,64 +977,117 @@ static EgspResult _EgspPrintTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 	EGSP_TRY(_EgspWriteString(pLoader, "],"))
 	if (pVal->pointerstruct)
 	{
-		pLoader->heapSize += EgspPad(sizeof(*pVal->pointerstruct));
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->pointerstruct));
 		uint8_t nullInd = 1;
-		EGSP_TRY(_EgspWriteString(pLoader, "\"pointerstruct is not null. Processing\":"));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"pointerstruct is not null. Processing\":", 40));
 		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
-		EGSP_TRY(_EgspWriteString(pLoader, "\"pointerstruct\":"));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"pointerstruct\":", 16));
 		EGSP_TRY(_EgspPrintInnerStruct(pLoader, pVal->pointerstruct))
 	}
 	else
 	{
 		uint8_t nullInd = 0;
-		EGSP_TRY(_EgspWriteString(pLoader, "\"pointerstruct is null. Skipping.\":"));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"pointerstruct is null. Skipping.\":", 35));
 		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
 	}
 	if (pVal->nullstruct)
 	{
-		pLoader->heapSize += EgspPad(sizeof(*pVal->nullstruct));
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->nullstruct));
 		uint8_t nullInd = 1;
-		EGSP_TRY(_EgspWriteString(pLoader, "\"nullstruct is not null. Processing\":"));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"nullstruct is not null. Processing\":", 37));
 		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
-		EGSP_TRY(_EgspWriteString(pLoader, "\"nullstruct\":"));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"nullstruct\":", 13));
 		EGSP_TRY(_EgspPrintInnerStruct(pLoader, pVal->nullstruct))
 	}
 	else
 	{
 		uint8_t nullInd = 0;
-		EGSP_TRY(_EgspWriteString(pLoader, "\"nullstruct is null. Skipping.\":"));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"nullstruct is null. Skipping.\":", 32));
 		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
 	}
-	EGSP_TRY(_EgspWriteString(pLoader, "\"inlinestruct\":"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"inlinestruct\":", 15));
 	EGSP_TRY(_EgspPrintInnerStruct(pLoader, &pVal->inlinestruct));
-	EGSP_TRY(_EgspWriteString(pLoader, "\"TestString\":"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"TestString\":", 13));
 	EGSP_TRY(_EgspPrintstring(pLoader, &pVal->TestString));
 	{
 		int32_t enumval = pVal->testenum;
-		EGSP_TRY(_EgspWriteString(pLoader, "\"testenum\":"));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"testenum\":", 11));
 		EGSP_TRY(_EgspPrintint32_t(pLoader, &enumval));
 	}
-	return _EgspWriteString(pLoader, "},");
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"wordcount\":", 12));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->wordcount));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->words) * pVal->wordcount);
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"words\":", 8));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->wordcount; ++i)
+	{
+		EGSP_TRY(_EgspPrintuint32_t(pLoader, (uint32_t*)pVal->words + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->longs) * pVal->wordcount);
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"longs\":", 8));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->wordcount; ++i)
+	{
+		EGSP_TRY(_EgspPrintuint64_t(pLoader, (uint64_t*)pVal->longs + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->shorts) * pVal->wordcount);
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"shorts\":", 9));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->wordcount; ++i)
+	{
+		EGSP_TRY(_EgspPrintint16_t(pLoader, (int16_t*)pVal->shorts + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"origin\":", 9));
+	EGSP_TRY(_EgspPrintVertex(pLoader, &pVal->origin));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"vertexcount\":", 14));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->vertexcount));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->vertices)) * pVal->vertexcount;
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"vertices\":", 11));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->vertexcount; ++i)
+	{
+		EGSP_TRY(_EgspPrintVertex(pLoader, pVal->vertices + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"))
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"labelcount\":", 13));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->labelcount));
+	pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->labels)) * pVal->labelcount;
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"labels\":", 9));
+	EGSP_TRY(_EgspWriteString(pLoader, "["));
+	for (size_t i = 0; i < pVal->labelcount; ++i)
+	{
+		EGSP_TRY(_EgspPrintLabel(pLoader, pVal->labels + i));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "],"))
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(3, "TestStruct");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintTestStructEx(EgspLoader* pLoader, TestStruct* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintTestStruct(pLoader, pVal));
+	return EgspFlush(pLoader);
 }
 
-static EgspResult EgspPrintTestStruct(EgspFunc pFlushFunc, TestStruct* pVal, size_t* pHeapRequired)
+static inline EgspResult EgspPrintTestStruct(EgspFunc pFlushFunc, TestStruct* pVal, size_t* pHeapRequired)
 {
 	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
 	loader.pFunc = pFlushFunc;
-	loader.offset = 0;
-	loader.heapSize = 0;
-	loader.last = 0;
-	loader.indent = 0;
-	EGSP_TEST(loader.pData = loader.pFunc(EgspBlockSize()));
-	EGSP_TRY(_EgspPrintTestStruct(&loader, pVal));
-	EGSP_TRY(EgspFlush(&loader));
+	EGSP_TRY(EgspPrintTestStructEx(&loader, pVal));
 	*pHeapRequired = loader.heapSize;
 	return EGSP_SUCCESS;
 }
 
 static EgspResult _EgspReadTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 {
-	uint8_t egspNullCheck = 0;
+	EGSP_STATS_BEGIN
 	EGSP_TRY(_EgspSkipLabel(pLoader));
 	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->testint));
 	EGSP_TRY(_EgspSkipLabel(pLoader));
@@ -285,7 +1096,7 @@ static EgspResult _EgspReadTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 	EGSP_TRY(_EgspReadint16_t(pLoader, &pVal->testsigned));
 	EGSP_TRY(_EgspSkipLabel(pLoader));
 	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->structcount));
-	if (pVal->teststruct = EgspAlloc(pLoader, EgspPad(sizeof(InnerStruct)) * pVal->structcount))
+	if ((pVal->teststruct = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->teststruct)) * pVal->structcount)))
 	{
 		EGSP_TRY(_EgspSkipLabel(pLoader));
 		for (size_t i = 0; i < pVal->structcount; ++i)
@@ -293,11 +1104,12 @@ static EgspResult _EgspReadTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 			EGSP_TRY(_EgspReadInnerStruct(pLoader, pVal->teststruct + i));
 		}
 	}
+	uint8_t egspNullCheck = 0;
 	EGSP_TRY(_EgspSkipLabel(pLoader));
 	EGSP_TRY(_EgspReaduint8_t(pLoader, &egspNullCheck));
 	if (egspNullCheck)
 	{
-		EGSP_TEST(pVal->pointerstruct = EgspAlloc(pLoader, EgspPad(sizeof(InnerStruct))))
+		EGSP_TEST(pVal->pointerstruct = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(InnerStruct))))
 		EGSP_TRY(_EgspSkipLabel(pLoader));
 		EGSP_TRY(_EgspReadInnerStruct(pLoader, pVal->pointerstruct));
 	}
@@ -309,7 +1121,7 @@ static EgspResult _EgspReadTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 	EGSP_TRY(_EgspReaduint8_t(pLoader, &egspNullCheck));
 	if (egspNullCheck)
 	{
-		EGSP_TEST(pVal->nullstruct = EgspAlloc(pLoader, EgspPad(sizeof(InnerStruct))))
+		EGSP_TEST(pVal->nullstruct = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(InnerStruct))))
 		EGSP_TRY(_EgspSkipLabel(pLoader));
 		EGSP_TRY(_EgspReadInnerStruct(pLoader, pVal->nullstruct));
 	}
@@ -327,19 +1139,304 @@ static EgspResult _EgspReadTestStruct(EgspLoader* pLoader, TestStruct* pVal)
 		EGSP_TRY(_EgspReadint32_t(pLoader, &enumval));
 		pVal->testenum = (TestEnum) enumval;
 	}
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->wordcount));
+	if ((pVal->words = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->words) * pVal->wordcount))))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspSkipList(pLoader));
+		for (size_t i = 0; i < pVal->wordcount; ++i)
+		{
+			EGSP_TRY(_EgspReaduint32_t(pLoader, (uint32_t*)pVal->words + i));
+		}
+	}
+	if ((pVal->longs = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->longs) * pVal->wordcount))))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspSkipList(pLoader));
+		for (size_t i = 0; i < pVal->wordcount; ++i)
+		{
+			EGSP_TRY(_EgspReaduint64_t(pLoader, (uint64_t*)pVal->longs + i));
+		}
+	}
+	if ((pVal->shorts = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->shorts) * pVal->wordcount))))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspSkipList(pLoader));
+		for (size_t i = 0; i < pVal->wordcount; ++i)
+		{
+			EGSP_TRY(_EgspReadint16_t(pLoader, (int16_t*)pVal->shorts + i));
+		}
+	}
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReadVertex(pLoader, &pVal->origin));
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->vertexcount));
+	if ((pVal->vertices = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->vertices)) * pVal->vertexcount)))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		for (size_t i = 0; i < pVal->vertexcount; ++i)
+		{
+			EGSP_TRY(_EgspReadVertex(pLoader, pVal->vertices + i));
+		}
+	}
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->labelcount));
+	if ((pVal->labels = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(*pVal->labels)) * pVal->labelcount)))
+	{
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		for (size_t i = 0; i < pVal->labelcount; ++i)
+		{
+			EGSP_TRY(_EgspReadLabel(pLoader, pVal->labels + i));
+		}
+	}
+	EGSP_STATS_END(3, "TestStruct");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspReadTestStructEx(EgspLoader* pLoader, TestStruct* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadTestStruct(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadTestStruct(EgspFunc pLoadFunc, TestStruct* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadTestStructEx(&loader, pVal, pHeap, heapSize);
+}
+
+static const uint64_t s_egspSchemaListNode = 0x4d1db4ac8656ffdaull;
+
+static EgspResult _EgspLoadListNode(EgspLoader* pLoader, ListNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspLoaduint32_t(pLoader, &pVal->id));
+	uint8_t egspNullCheck = 0;
+	EGSP_TRY(_EgspLoaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->next = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(ListNode))))
+		EGSP_TRY(_EgspLoadListNode(pLoader, pVal->next));
+	}
+	else
+	{
+		pVal->next = 0;
+	}
+	EGSP_STATS_END(4, "ListNode");
 	return EGSP_SUCCESS;
 }
 
-static EgspResult EgspReadTestStruct(EgspFunc pLoadFunc, TestStruct* pVal, void* pHeap, size_t heapSize)
+static inline EgspResult EgspLoadListNodeEx(EgspLoader* pLoader, ListNode* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspLoadEnvelope(pLoader, s_egspSchemaListNode));
+	return _EgspLoadListNode(pLoader, pVal);
+}
+
+static inline EgspResult EgspLoadListNode(EgspFunc pLoadFunc, ListNode* pVal, void* pHeap, size_t heapSize)
 {
 	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
 	loader.pFunc = pLoadFunc;
-	loader.offset = 0;
-	loader.pHeap = pHeap;
-	loader.heapSize = heapSize;
-	EGSP_TEST(loader.pData = loader.pFunc(0));
-	EGSP_TRY(_EgspReadTestStruct(&loader, pVal));
+	return EgspLoadListNodeEx(&loader, pVal, pHeap, heapSize);
+}
+
+static inline EgspResult EgspLoadListNodeSpan(const uint8_t* pData, size_t size, ListNode* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = (uint8_t*)pData;
+	loader.blockSize = size;
+	return EgspLoadListNodeEx(&loader, pVal, pHeap, heapSize);
+}
+
+static void _EgspMeasureListNode(EgspLoader* pLoader, ListNode* pVal)
+{
+	_EgspMeasureuint32_t(pLoader, &pVal->id);
+	_EgspMeasureBytes(pLoader, sizeof(uint8_t));
+	if (pVal->next)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->next));
+		_EgspMeasureListNode(pLoader, pVal->next);
+	}
+}
+
+static inline size_t EgspMeasureListNodeEx(EgspLoader* pLoader, ListNode* pVal)
+{
+	pLoader->heapSize = 0;
+	pLoader->offset = 0;
+	pLoader->measured = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		_EgspMeasureBytes(pLoader, EGSP_ENVELOPE_SIZE);
+	}
+	_EgspMeasureListNode(pLoader, pVal);
+	return pLoader->measured + pLoader->offset;
+}
+
+static inline size_t EgspMeasureListNode(ListNode* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	size_t size = EgspMeasureListNodeEx(&loader, pVal);
+	*pHeapRequired = loader.heapSize;
+	return size;
+}
+
+static EgspResult _EgspSaveListNode(EgspLoader* pLoader, ListNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSaveuint32_t(pLoader, &pVal->id));
+	if (pVal->next)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->next));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspSaveListNode(pLoader, pVal->next));
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspSaveuint8_t(pLoader, &nullInd));
+	}
+	EGSP_STATS_END(4, "ListNode");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveListNodeEx(EgspLoader* pLoader, ListNode* pVal)
+{
+	size_t size = 0;
+	size_t heapSize = 0;
+	if (pLoader->flags & EGSP_FLAG_ENVELOPE)
+	{
+		size = EgspMeasureListNodeEx(pLoader, pVal);
+		heapSize = pLoader->heapSize;
+	}
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspSaveEnvelope(pLoader, s_egspSchemaListNode, size, heapSize));
+	EGSP_TRY(_EgspSaveListNode(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspSaveListNode(EgspFunc pFlushFunc, ListNode* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspSaveListNodeEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspSaveListNodeSpan(uint8_t* pData, size_t size, ListNode* pVal, size_t* pWritten, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pData = pData;
+	loader.blockSize = size;
+	EGSP_TRY(EgspSaveListNodeEx(&loader, pVal));
+	*pWritten = loader.offset;
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static const EgspStructInfo s_egspInfoListNode;
+
+static const EgspField s_egspFieldsListNode[] = {
+	{ EGSP_KIND_UNSIGNED, EGSP_SHAPE_VALUE, offsetof(ListNode, id), sizeof(((ListNode*)0)->id), 0, 0, 0, "id" },
+	{ EGSP_KIND_STRUCT, EGSP_SHAPE_POINTER, offsetof(ListNode, next), sizeof(*((ListNode*)0)->next), 0, 0, &s_egspInfoListNode, "next" },
+};
+
+static const EgspStructInfo s_egspInfoListNode = { sizeof(ListNode), s_egspFieldsListNode, 2, 0, s_egspSchemaListNode, 0, "ListNode", 4 };
+
+static EgspResult _EgspPrintListNode(EgspLoader* pLoader, ListNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspWriteString(pLoader, "{"));
+	EGSP_TRY(_EgspWriteLabel(pLoader, "\"id\":", 5));
+	EGSP_TRY(_EgspPrintuint32_t(pLoader, &pVal->id));
+	if (pVal->next)
+	{
+		pLoader->heapSize += _EgspPad(pLoader, sizeof(*pVal->next));
+		uint8_t nullInd = 1;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"next is not null. Processing\":", 31));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"next\":", 7));
+		EGSP_TRY(_EgspPrintListNode(pLoader, pVal->next))
+	}
+	else
+	{
+		uint8_t nullInd = 0;
+		EGSP_TRY(_EgspWriteLabel(pLoader, "\"next is null. Skipping.\":", 26));
+		EGSP_TRY(_EgspPrintuint8_t(pLoader, &nullInd));
+	}
+	EGSP_TRY(_EgspWriteString(pLoader, "},"));
+	EGSP_STATS_END(4, "ListNode");
+	return EGSP_SUCCESS;
+}
+
+static inline EgspResult EgspPrintListNodeEx(EgspLoader* pLoader, ListNode* pVal)
+{
+	pLoader->heapSize = 0;
+	EGSP_TRY(EgspBegin(pLoader));
+	EGSP_TRY(_EgspPrintListNode(pLoader, pVal));
+	return EgspFlush(pLoader);
+}
+
+static inline EgspResult EgspPrintListNode(EgspFunc pFlushFunc, ListNode* pVal, size_t* pHeapRequired)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pFlushFunc;
+	EGSP_TRY(EgspPrintListNodeEx(&loader, pVal));
+	*pHeapRequired = loader.heapSize;
+	return EGSP_SUCCESS;
+}
+
+static EgspResult _EgspReadListNode(EgspLoader* pLoader, ListNode* pVal)
+{
+	EGSP_STATS_BEGIN
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint32_t(pLoader, &pVal->id));
+	uint8_t egspNullCheck = 0;
+	EGSP_TRY(_EgspSkipLabel(pLoader));
+	EGSP_TRY(_EgspReaduint8_t(pLoader, &egspNullCheck));
+	if (egspNullCheck)
+	{
+		EGSP_TEST(pVal->next = EgspAlloc(pLoader, _EgspPad(pLoader, sizeof(ListNode))))
+		EGSP_TRY(_EgspSkipLabel(pLoader));
+		EGSP_TRY(_EgspReadListNode(pLoader, pVal->next));
+	}
+	else
+	{
+		pVal->next = 0;
+	}
+	EGSP_STATS_END(4, "ListNode");
 	return EGSP_SUCCESS;
 }
 
+static inline EgspResult EgspReadListNodeEx(EgspLoader* pLoader, ListNode* pVal, void* pHeap, size_t heapSize)
+{
+	pLoader->pHeap = pHeap;
+	pLoader->heapSize = heapSize;
+	EGSP_TRY(EgspBegin(pLoader));
+	return _EgspReadListNode(pLoader, pVal);
+}
+
+static inline EgspResult EgspReadListNode(EgspFunc pLoadFunc, ListNode* pVal, void* pHeap, size_t heapSize)
+{
+	EgspLoader loader;
+	EgspInitLoader(&loader, 0, 0);
+	loader.pFunc = pLoadFunc;
+	return EgspReadListNodeEx(&loader, pVal, pHeap, heapSize);
+}
+
 #endif
\ No newline at end of file
@@ -19,6 +19,21 @@ typedef struct
 	uint32_t dummy2;
 } InnerStruct;
 
+// Only fixed width fields and no padding, so it can be copied as is
+typedef struct
+{
+	float x;
+	float y;
+	float z;
+	uint32_t color;
+} Vertex;
+
+typedef struct
+{
+	const char* name;
+	uint32_t id;
+} Label;
+
 typedef struct
 {
 	uint32_t testint;
@@ -31,9 +46,37 @@ typedef struct
 	InnerStruct inlinestruct;
 	TestEnum testenum;
 	const char* TestString;
+	uint32_t wordcount;
+	uint32_t* words;
+	uint64_t* longs;
+	int16_t* shorts;
+	Vertex origin;
+	uint32_t vertexcount;
+	Vertex* vertices;
+	uint32_t labelcount;
+	Label* labels;
 } TestStruct;
 
+// Points at its own type, so its struct info has to be declared before its fields
+typedef struct ListNode
+{
+	uint32_t id;
+	struct ListNode* next;
+} ListNode;
+
 #include "egspload.h"
+#include "egspmap.h"
+#include "egspasync.h"
+#include "egspuring.h"
+#include "egsppool.h"
+#include "egsppush.h"
+#include "egsplz.h"
+#include "egspcrc.h"
+#include "egspnum.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 // Control Variables
 uint8_t buffer[1<<20];
@@ -45,6 +88,12 @@ TestStruct testdata;
 TestStruct output;
 InnerStruct testarray[4];
 char teststring[1024];
+uint32_t testwords[37];
+uint64_t testlongs[37];
+int16_t testshorts[37];
+Vertex testvertices[5];
+Label testlabels[40];
+char labelnames[40][160];
 
 // LoadFunc for testing multiple blocks
 uint8_t* LoadFunc(size_t size)
@@ -60,6 +109,22 @@ uint8_t* FlushFunc(size_t size)
 	return buffer;
 }
 
+// Block function that keeps its state in pUser instead of globals
+typedef struct
+{
+	uint8_t* pBase;
+	size_t count;
+	size_t blockSize;
+	size_t written;
+} BlockCursor;
+
+uint8_t* CursorFunc(void* pUser, size_t size)
+{
+	BlockCursor* pCursor = (BlockCursor*)pUser;
+	pCursor->written += size;
+	return pCursor->pBase + (pCursor->count++ * pCursor->blockSize);
+}
+
 void SetupTestData()
 {
 	sprintf(teststring,
@@ -82,6 +147,46 @@ void SetupTestData()
 	testdata.inlinestruct.dummy = 5678;
 	testdata.TestString = teststring;
 	testdata.testenum = SECOND_VAL;
+
+	testdata.wordcount = 37;
+	testdata.words = testwords;
+	testdata.longs = testlongs;
+	testdata.shorts = testshorts;
+	for (uint32_t i = 0; i < testdata.wordcount; ++i)
+	{
+		testwords[i] = 0x01020304u * (i + 1);
+		testlongs[i] = 0x0102030405060708ull * (i + 1);
+		testshorts[i] = (int16_t)(-300 * (int)i);
+	}
+
+	testdata.origin.x = 1.5f;
+	testdata.origin.y = -2.25f;
+	testdata.origin.z = 1024.0f;
+	testdata.origin.color = 0xFF00FF80;
+	testdata.vertexcount = 5;
+	testdata.vertices = testvertices;
+	for (uint32_t i = 0; i < testdata.vertexcount; ++i)
+	{
+		testvertices[i].x = 0.5f * i;
+		testvertices[i].y = -0.25f * i;
+		testvertices[i].z = 8.0f * i;
+		testvertices[i].color = 0x10203040u * i;
+	}
+
+	// Names of all sorts of lengths, so that some of them straddle blocks
+	testdata.labelcount = 40;
+	testdata.labels = testlabels;
+	for (uint32_t i = 0; i < testdata.labelcount; ++i)
+	{
+		size_t length = (i * 37) % 150;
+		for (size_t c = 0; c < length; ++c)
+		{
+			labelnames[i][c] = (char)('a' + (c + i) % 26);
+		}
+		labelnames[i][length] = '\0';
+		testlabels[i].name = labelnames[i];
+		testlabels[i].id = i * 7;
+	}
 }
 
 void Reset()
@@ -105,6 +210,19 @@ void VerifyOutput()
 	assert(strcmp(output.TestString, testdata.TestString) == 0);
 	assert(output.testenum == testdata.testenum);
 	assert(output.nullstruct == testdata.nullstruct);
+	assert(output.wordcount == testdata.wordcount);
+	assert(memcmp(output.words, testdata.words, sizeof(*output.words) * output.wordcount) == 0);
+	assert(memcmp(output.longs, testdata.longs, sizeof(*output.longs) * output.wordcount) == 0);
+	assert(memcmp(output.shorts, testdata.shorts, sizeof(*output.shorts) * output.wordcount) == 0);
+	assert(memcmp(&output.origin, &testdata.origin, sizeof(output.origin)) == 0);
+	assert(output.vertexcount == testdata.vertexcount);
+	assert(memcmp(output.vertices, testdata.vertices, sizeof(*output.vertices) * output.vertexcount) == 0);
+	assert(output.labelcount == testdata.labelcount);
+	for (uint32_t i = 0; i < output.labelcount; ++i)
+	{
+		assert(strcmp(output.labels[i].name, testdata.labels[i].name) == 0);
+		assert(output.labels[i].id == testdata.labels[i].id);
+	}
 }
 
 int main(int argc, char** argv)
@@ -113,19 +231,661 @@ int main(int argc, char** argv)
 	SetupTestData();
 	// 3 is a great number for tests because it is odd, prime
 	// and causes the most amount of work to be done. Horrible
-	// from an optimization standpoint though.
-	EgspSetBlockSize(3);
+	// from an optimization standpoint though. A bigger block
+	// lets whole runs of array elements and strings through at once.
+	void* pHeap;
+	size_t blockSizes[] = { 4096, 64, 3 };
+	uint32_t flags[] = { 0, EGSP_FLAG_ZERO_COPY, EGSP_FLAG_ZERO_COPY | EGSP_FLAG_VARINT };
+	for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); ++f)
+	{
+		EgspSetFlags(flags[f]);
+		for (size_t i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]); ++i)
+		{
+			EgspSetBlockSize(blockSizes[i]);
+
+			Reset();
+			EgspSaveTestStruct(LoadFunc, &testdata, &heapSize);
+
+			Reset();
+			pHeap = malloc(heapSize);
+			EgspLoadTestStruct(LoadFunc, &output, pHeap, heapSize);
+			VerifyOutput();
+			free(pHeap);
+
+			// The string fits in a 4KB block, so it should not have been copied
+			int inPlace = output.TestString >= (const char*)buffer && output.TestString < (const char*)buffer + sizeof(buffer);
+			assert(inPlace == ((flags[f] & EGSP_FLAG_ZERO_COPY) && blockSizes[i] == 4096));
+		}
+	}
+	EgspSetFlags(0);
+
+	// Single span, both directions must agree with the exact size written
+	size_t written = 0;
+	Reset();
+	EgspResult result = EgspSaveTestStructSpan(buffer, sizeof(buffer), &testdata, &written, &heapSize);
+	assert(result == EGSP_SUCCESS);
+	result = EgspSaveTestStructSpan(buffer + written, written - 1, &testdata, &written, &heapSize);
+	assert(result == EGSP_FAIL);
+
+	pHeap = malloc(heapSize);
+	result = EgspLoadTestStructSpan(buffer, written, &output, pHeap, heapSize);
+	assert(result == EGSP_SUCCESS);
+	VerifyOutput();
+	Reset();
+	result = EgspLoadTestStructSpan(buffer, written - 1, &output, pHeap, heapSize);
+	assert(result == EGSP_FAIL);
+	free(pHeap);
+
+	// Per loader block size and alignment, independent of the defaults
+	BlockCursor cursor = { buffer, 0, 7, 0 };
+	EgspLoader loader;
+	EgspInitLoader(&loader, CursorFunc, &cursor);
+	loader.blockSize = cursor.blockSize;
+	loader.alignBytes = 8;
+	result = EgspSaveTestStructEx(&loader, &testdata);
+	assert(result == EGSP_SUCCESS);
+	heapSize = loader.heapSize;
 
 	Reset();
-	EgspSaveTestStruct(LoadFunc, &testdata, &heapSize);
+	cursor.count = 0;
+	EgspInitLoader(&loader, CursorFunc, &cursor);
+	loader.blockSize = cursor.blockSize;
+	loader.alignBytes = 8;
+	pHeap = malloc(heapSize);
+	result = EgspLoadTestStructEx(&loader, &output, pHeap, heapSize);
+	assert(result == EGSP_SUCCESS);
+	VerifyOutput();
+	assert((uintptr_t)output.teststruct % 8 == 0 && (uintptr_t)output.pointerstruct % 8 == 0);
+	free(pHeap);
+
+	// A string starting part way into a block and running on through several more
+	Label label;
+	cursor.count = 0;
+	cursor.blockSize = 16;
+	EgspInitLoader(&loader, CursorFunc, &cursor);
+	loader.blockSize = cursor.blockSize;
+	result = EgspSaveLabelEx(&loader, testlabels + 4);
+	assert(result == EGSP_SUCCESS && cursor.count > 9);
+	heapSize = loader.heapSize;
 
 	Reset();
-	void* pHeap = malloc(heapSize);
-	EgspLoadTestStruct(LoadFunc, &output, pHeap, heapSize);
+	cursor.count = 0;
+	EgspInitLoader(&loader, CursorFunc, &cursor);
+	loader.blockSize = cursor.blockSize;
+	pHeap = malloc(heapSize);
+	result = EgspLoadLabelEx(&loader, &label, pHeap, heapSize);
+	assert(result == EGSP_SUCCESS);
+	assert(strcmp(label.name, labelnames[4]) == 0 && label.id == testlabels[4].id);
+	free(pHeap);
+
+	// Measuring must come to exactly what Save hands over, in blocks and in a single span
+	for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); ++f)
+	{
+		for (size_t i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]); ++i)
+		{
+			cursor.count = 0;
+			cursor.written = 0;
+			cursor.blockSize = blockSizes[i];
+			EgspInitLoader(&loader, CursorFunc, &cursor);
+			loader.blockSize = blockSizes[i];
+			loader.flags = flags[f];
+			size_t measured = EgspMeasureTestStructEx(&loader, &testdata);
+			heapSize = loader.heapSize;
+			result = EgspSaveTestStructEx(&loader, &testdata);
+			assert(result == EGSP_SUCCESS);
+			assert(cursor.written == measured && loader.heapSize == heapSize);
+		}
+
+		EgspSetFlags(flags[f]);
+		size_t measured = EgspMeasureTestStruct(&testdata, &heapSize);
+		size_t spanHeapSize = 0;
+		result = EgspSaveTestStructSpan(buffer, measured, &testdata, &written, &spanHeapSize);
+		assert(result == EGSP_SUCCESS);
+		assert(written == measured && spanHeapSize == heapSize);
+	}
+	EgspSetFlags(0);
+
+	// Enveloped streams say how much heap they need, and are turned down when they do not match
+	for (size_t i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]); ++i)
+	{
+		cursor.count = 0;
+		cursor.blockSize = blockSizes[i];
+		EgspInitLoader(&loader, CursorFunc, &cursor);
+		loader.blockSize = blockSizes[i];
+		loader.flags = EGSP_FLAG_ENVELOPE | EGSP_FLAG_ZERO_COPY;
+		result = EgspSaveTestStructEx(&loader, &testdata);
+		assert(result == EGSP_SUCCESS);
+		heapSize = loader.heapSize;
+
+		Reset();
+		cursor.count = 0;
+		EgspInitLoader(&loader, CursorFunc, &cursor);
+		loader.blockSize = blockSizes[i];
+		loader.flags = EGSP_FLAG_ENVELOPE | EGSP_FLAG_ZERO_COPY;
+		pHeap = malloc(heapSize);
+		result = EgspLoadTestStructEx(&loader, &output, pHeap, heapSize);
+		assert(result == EGSP_SUCCESS);
+		VerifyOutput();
+		free(pHeap);
+
+		cursor.count = 0;
+		EgspInitLoader(&loader, CursorFunc, &cursor);
+		loader.blockSize = blockSizes[i];
+		loader.flags = EGSP_FLAG_ENVELOPE;
+		result = EgspLoadTestStructEx(&loader, &output, 0, 0);
+		assert(result == EGSP_FAIL);
+	}
+
+	EgspSetFlags(EGSP_FLAG_ENVELOPE);
+	result = EgspSaveTestStructSpan(buffer, sizeof(buffer), &testdata, &written, &heapSize);
+	assert(result == EGSP_SUCCESS);
+	EgspEnvelope envelope;
+	result = EgspPeekEnvelope(buffer, written, &envelope);
+	assert(result == EGSP_SUCCESS);
+	assert(envelope.flags == EGSP_FLAG_ENVELOPE && envelope.schema == s_egspSchemaTestStruct);
+	assert(envelope.heapSize == heapSize && envelope.size == written);
+
+	Reset();
+	pHeap = malloc(envelope.heapSize);
+	result = EgspLoadTestStructSpan(buffer, written, &output, pHeap, envelope.heapSize);
+	assert(result == EGSP_SUCCESS);
 	VerifyOutput();
+	result = EgspLoadTestStructSpan(buffer, written, &output, pHeap, envelope.heapSize - 1);
+	assert(result == EGSP_FAIL);
+	result = EgspLoadTestStructSpan(buffer, written - 1, &output, pHeap, envelope.heapSize);
+	assert(result == EGSP_FAIL);
+	result = EgspSaveLabelSpan(buffer, sizeof(buffer), testlabels + 1, &written, &heapSize);
+	assert(result == EGSP_SUCCESS);
+	result = EgspLoadTestStructSpan(buffer, written, &output, pHeap, envelope.heapSize);
+	assert(result == EGSP_FAIL);
 	free(pHeap);
+	EgspSetFlags(0);
+
+	// Pushed a few bytes at a time, as they would come off a socket. Strings are always copied,
+	// so the heap is what a save without zero copy needs.
+	size_t pushSizes[] = { 1, 3, 7, 64, sizeof(buffer) };
+	uint32_t pushFlags[] = { 0, EGSP_FLAG_ZERO_COPY, EGSP_FLAG_ENVELOPE, EGSP_FLAG_ENVELOPE | EGSP_FLAG_VARINT };
+	EgspMeasureTestStruct(&testdata, &heapSize);
+	pHeap = malloc(heapSize);
+	for (size_t f = 0; f < sizeof(pushFlags) / sizeof(pushFlags[0]); ++f)
+	{
+		EgspSetFlags(pushFlags[f]);
+		size_t spanHeapSize;
+		result = EgspSaveTestStructSpan(buffer, sizeof(buffer) / 2, &testdata, &written, &spanHeapSize);
+		assert(result == EGSP_SUCCESS);
+		for (size_t i = 0; i < sizeof(pushSizes) / sizeof(pushSizes[0]); ++i)
+		{
+			Reset();
+			EgspPush push;
+			EgspPushInit(&push, &s_egspInfoTestStruct, &output, pHeap, heapSize);
+			size_t pos = 0;
+			size_t used = 0;
+			result = EGSP_NEED_MORE;
+			while (result == EGSP_NEED_MORE)
+			{
+				// Whatever follows the stream is left alone
+				size_t size = pushSizes[i] < sizeof(buffer) - pos ? pushSizes[i] : sizeof(buffer) - pos;
+				result = EgspPushData(&push, buffer + pos, size, &used);
+				pos += used;
+			}
+			assert(result == EGSP_SUCCESS && pos == written);
+			VerifyOutput();
+		}
+	}
+	EgspSetFlags(0);
+
+	// A different struct, or a heap that is too small, fails instead of asserting
+	EgspPush push;
+	EgspPushInit(&push, &s_egspInfoLabel, &label, pHeap, heapSize);
+	push.loader.flags = EGSP_FLAG_ENVELOPE;
+	result = EgspPushData(&push, buffer, written, 0);
+	assert(result == EGSP_FAIL);
+	result = EgspSaveTestStructSpan(buffer, sizeof(buffer), &testdata, &written, &heapSize);
+	assert(result == EGSP_SUCCESS);
+	EgspPushInit(&push, &s_egspInfoTestStruct, &output, pHeap, heapSize / 2);
+	result = EgspPushData(&push, buffer, written, 0);
+	assert(result == EGSP_FAIL);
+
+	// Json only flags stay out of the envelope, so they do not turn down a stream that is otherwise the same
+	EgspSetFlags(EGSP_FLAG_ENVELOPE | EGSP_FLAG_COMPACT);
+	result = EgspSaveTestStructSpan(buffer, sizeof(buffer), &testdata, &written, &heapSize);
+	assert(result == EGSP_SUCCESS);
+	EgspSetFlags(EGSP_FLAG_ENVELOPE);
+	Reset();
+	result = EgspLoadTestStructSpan(buffer, written, &output, pHeap, heapSize);
+	assert(result == EGSP_SUCCESS);
+	VerifyOutput();
+	Reset();
+	EgspPushInit(&push, &s_egspInfoTestStruct, &output, pHeap, heapSize);
+	result = EgspPushData(&push, buffer, written, 0);
+	assert(result == EGSP_SUCCESS);
+	VerifyOutput();
+	EgspSetFlags(0);
+	free(pHeap);
+
+	// Compressed on the way out and back in, through an inner stream of blocks that fit neither the frames nor the loader
+	size_t lzDepths[] = { EGSP_LZ_FAST, EGSP_LZ_SMALL };
+	void* pLzMemory = malloc(EgspLzMemory(4096));
+	for (size_t d = 0; d < sizeof(lzDepths) / sizeof(lzDepths[0]); ++d)
+	{
+		for (size_t i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]); ++i)
+		{
+			EgspLz lz;
+			cursor.count = 0;
+			cursor.written = 0;
+			cursor.blockSize = 61;
+			result = EgspLzOpenWriter(&lz, CursorFunc, &cursor, cursor.blockSize, pLzMemory, blockSizes[i], lzDepths[d]);
+			assert(result == EGSP_SUCCESS);
+			EgspInitLoader(&loader, EgspLzFunc, &lz);
+			loader.blockSize = blockSizes[i];
+			result = EgspSaveTestStructEx(&loader, &testdata);
+			assert(result == EGSP_SUCCESS);
+			result = EgspLzClose(&lz);
+			assert(result == EGSP_SUCCESS);
+			assert(cursor.written == lz.packed && (lz.packed < lz.raw || blockSizes[i] != 4096));
+			heapSize = loader.heapSize;
+
+			Reset();
+			cursor.count = 0;
+			result = EgspLzOpenReader(&lz, CursorFunc, &cursor, cursor.blockSize, pLzMemory, blockSizes[i]);
+			assert(result == EGSP_SUCCESS);
+			EgspInitLoader(&loader, EgspLzFunc, &lz);
+			loader.blockSize = blockSizes[i];
+			pHeap = malloc(heapSize);
+			result = EgspLoadTestStructEx(&loader, &output, pHeap, heapSize);
+			assert(result == EGSP_SUCCESS);
+			VerifyOutput();
+			free(pHeap);
+
+			// A frame that claims more than a block fails to load
+			buffer[0] = 0xFF;
+			cursor.count = 0;
+			result = EgspLzOpenReader(&lz, CursorFunc, &cursor, cursor.blockSize, pLzMemory, blockSizes[i]);
+			assert(result == EGSP_SUCCESS);
+			EgspInitLoader(&loader, EgspLzFunc, &lz);
+			loader.blockSize = blockSizes[i];
+			result = EgspLoadTestStructEx(&loader, &output, 0, 0);
+			assert(result == EGSP_FAIL);
+		}
+	}
+	free(pLzMemory);
+
+	// Every block is checked before it is loaded, and a flipped bit is reported along with the block it is in
+	assert(EgspCrc32c(0, "123456789", 9) == 0xE3069283);
+	size_t crcInnerSizes[] = { 61, 8192 };
+	void* pCrcMemory = malloc(EgspCrcMemory(64));
+	for (size_t i = 0; i < sizeof(crcInnerSizes) / sizeof(crcInnerSizes[0]); ++i)
+	{
+		EgspCrc crc;
+		cursor.count = 0;
+		cursor.written = 0;
+		cursor.blockSize = crcInnerSizes[i];
+		result = EgspCrcOpenWriter(&crc, CursorFunc, &cursor, cursor.blockSize, pCrcMemory, 64);
+		assert(result == EGSP_SUCCESS);
+		EgspInitLoader(&loader, EgspCrcFunc, &crc);
+		loader.blockSize = 64;
+		result = EgspSaveTestStructEx(&loader, &testdata);
+		assert(result == EGSP_SUCCESS);
+		result = EgspCrcClose(&crc);
+		assert(result == EGSP_SUCCESS);
+		heapSize = loader.heapSize;
+		size_t blocks = crc.blocks;
+		size_t streamSize = cursor.written;
+
+		Reset();
+		cursor.count = 0;
+		result = EgspCrcOpenReader(&crc, CursorFunc, &cursor, cursor.blockSize, pCrcMemory, 64);
+		assert(result == EGSP_SUCCESS);
+		EgspInitLoader(&loader, EgspCrcFunc, &crc);
+		loader.blockSize = 64;
+		pHeap = malloc(heapSize);
+		result = EgspLoadTestStructEx(&loader, &output, pHeap, heapSize);
+		assert(result == EGSP_SUCCESS);
+		VerifyOutput();
+		result = EgspCrcClose(&crc);
+		assert(result == EGSP_SUCCESS && crc.blocks == blocks);
+
+		size_t flips[] = { 14, streamSize - 6 };
+		size_t corruptBlocks[] = { 0, blocks - 1 };
+		for (size_t f = 0; f < sizeof(flips) / sizeof(flips[0]); ++f)
+		{
+			buffer[flips[f]] ^= 0x10;
+			cursor.count = 0;
+			result = EgspCrcOpenReader(&crc, CursorFunc, &cursor, cursor.blockSize, pCrcMemory, 64);
+			assert(result == EGSP_SUCCESS);
+			EgspInitLoader(&loader, EgspCrcFunc, &crc);
+			loader.blockSize = 64;
+			result = EgspLoadTestStructEx(&loader, &output, pHeap, heapSize);
+			assert(result == EGSP_FAIL);
+			result = EgspCrcClose(&crc);
+			assert(result == EGSP_CORRUPT && crc.corruptBlock == corruptBlocks[f]);
+			buffer[flips[f]] ^= 0x10;
+		}
+		free(pHeap);
+	}
+	free(pCrcMemory);
+
+	// The table interpreter must write exactly what the generated code does, and load it back
+	uint8_t* pTable = malloc(sizeof(buffer));
+	uint32_t tableFlags[] = { 0, EGSP_FLAG_ZERO_COPY | EGSP_FLAG_VARINT, EGSP_FLAG_ENVELOPE };
+	for (size_t f = 0; f < sizeof(tableFlags) / sizeof(tableFlags[0]); ++f)
+	{
+		for (size_t i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]); ++i)
+		{
+			memset(buffer, 0, sizeof(buffer));
+			memset(pTable, 0, sizeof(buffer));
+			cursor.pBase = buffer;
+			cursor.count = 0;
+			cursor.blockSize = blockSizes[i];
+			EgspInitLoader(&loader, CursorFunc, &cursor);
+			loader.blockSize = blockSizes[i];
+			loader.flags = tableFlags[f];
+			result = EgspSaveTestStructEx(&loader, &testdata);
+			assert(result == EGSP_SUCCESS);
+			size_t blocks = cursor.count;
+			heapSize = loader.heapSize;
+			size_t measured = EgspMeasureTestStructEx(&loader, &testdata);
+
+			cursor.pBase = pTable;
+			cursor.count = 0;
+			EgspInitLoader(&loader, CursorFunc, &cursor);
+			loader.blockSize = blockSizes[i];
+			loader.flags = tableFlags[f];
+			assert(EgspMeasureStructEx(&loader, &s_egspInfoTestStruct, &testdata) == measured && loader.heapSize == heapSize);
+			result = EgspSaveStructEx(&loader, &s_egspInfoTestStruct, &testdata);
+			assert(result == EGSP_SUCCESS);
+			assert(cursor.count == blocks && loader.heapSize == heapSize);
+			assert(memcmp(buffer, pTable, blocks * blockSizes[i]) == 0);
+
+			Reset();
+			cursor.count = 0;
+			EgspInitLoader(&loader, CursorFunc, &cursor);
+			loader.blockSize = blockSizes[i];
+			loader.flags = tableFlags[f];
+			pHeap = malloc(heapSize);
+			result = EgspLoadStructEx(&loader, &s_egspInfoTestStruct, &output, pHeap, heapSize);
+			assert(result == EGSP_SUCCESS);
+			VerifyOutput();
+			free(pHeap);
+		}
+	}
 
 #ifdef EGSP_JSON
+	for (uint32_t compact = 0; compact <= EGSP_FLAG_COMPACT; compact += EGSP_FLAG_COMPACT)
+	{
+		memset(buffer, 0, sizeof(buffer));
+		memset(pTable, 0, sizeof(buffer));
+		cursor.pBase = buffer;
+		cursor.count = 0;
+		cursor.blockSize = 61;
+		EgspInitLoader(&loader, CursorFunc, &cursor);
+		loader.blockSize = cursor.blockSize;
+		loader.flags = compact;
+		result = EgspPrintTestStructEx(&loader, &testdata);
+		assert(result == EGSP_SUCCESS);
+		size_t blocks = cursor.count;
+		heapSize = loader.heapSize;
+
+		cursor.pBase = pTable;
+		cursor.count = 0;
+		EgspInitLoader(&loader, CursorFunc, &cursor);
+		loader.blockSize = cursor.blockSize;
+		loader.flags = compact;
+		result = EgspPrintStructEx(&loader, &s_egspInfoTestStruct, &testdata);
+		assert(result == EGSP_SUCCESS);
+		assert(cursor.count == blocks && loader.heapSize == heapSize);
+		assert(memcmp(buffer, pTable, blocks * cursor.blockSize) == 0);
+
+		Reset();
+		cursor.count = 0;
+		EgspInitLoader(&loader, CursorFunc, &cursor);
+		loader.blockSize = cursor.blockSize;
+		pHeap = malloc(heapSize);
+		result = EgspReadStructEx(&loader, &s_egspInfoTestStruct, &output, pHeap, heapSize);
+		assert(result == EGSP_SUCCESS);
+		VerifyOutput();
+		free(pHeap);
+	}
+#endif
+	free(pTable);
+
+	// Varints that are too long, or too big for their field, fail to load
+	uint8_t tooLong[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+	uint8_t wide[] = { 0x80, 0x80, 0x04, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	uint8_t widest[] = { 0xFF, 0xFF, 0x03, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	uint64_t varLong;
+	uint16_t varShort;
+	int16_t varSigned;
+	EgspInitLoader(&loader, 0, 0);
+	loader.flags = EGSP_FLAG_VARINT;
+	loader.blockSize = sizeof(tooLong);
+	loader.pData = tooLong;
+	assert(_EgspLoaduint64_t(&loader, &varLong) == EGSP_FAIL);
+	loader.offset = 0;
+	loader.pData = wide;
+	assert(_EgspLoaduint16_t(&loader, &varShort) == EGSP_FAIL);
+	loader.offset = 0;
+	assert(_EgspLoadint16_t(&loader, &varSigned) == EGSP_FAIL);
+	loader.offset = 0;
+	loader.pData = widest;
+	assert(_EgspLoaduint16_t(&loader, &varShort) == EGSP_SUCCESS && varShort == 0xFFFF);
+	loader.offset = 0;
+	assert(_EgspLoadint16_t(&loader, &varSigned) == EGSP_SUCCESS && varSigned == -32768);
+
+	// A linked list, by the generated functions and the tables alike
+	ListNode nodes[3] = { { 1, nodes + 1 }, { 2, nodes + 2 }, { 3, 0 } };
+	ListNode list;
+	for (int tables = 0; tables <= 1; ++tables)
+	{
+		result = tables ? EgspSaveStructSpan(&s_egspInfoListNode, buffer, sizeof(buffer), nodes, &written, &heapSize)
+			: EgspSaveListNodeSpan(buffer, sizeof(buffer), nodes, &written, &heapSize);
+		assert(result == EGSP_SUCCESS && heapSize >= 2 * sizeof(ListNode));
+		pHeap = malloc(heapSize);
+		result = tables ? EgspLoadStructSpan(&s_egspInfoListNode, buffer, written, &list, pHeap, heapSize)
+			: EgspLoadListNodeSpan(buffer, written, &list, pHeap, heapSize);
+		assert(result == EGSP_SUCCESS);
+		assert(list.id == 1 && list.next->id == 2 && list.next->next->id == 3 && list.next->next->next == 0);
+		free(pHeap);
+	}
+
+#ifndef _WIN32
+	// Straight to and from a memory mapped file, strings pointing into the mapping
+	EgspMap map;
+	EgspSetBlockSize(4096);
+	EgspSetFlags(EGSP_FLAG_ZERO_COPY);
+	Reset();
+	result = EgspMapOpenWrite(&map, "Test.bin", EgspBlockSize());
+	assert(result == EGSP_SUCCESS);
+	EgspMapBind(&map);
+	result = EgspSaveTestStruct(EgspMapFunc, &testdata, &heapSize);
+	assert(result == EGSP_SUCCESS);
+	result = EgspMapClose(&map);
+	assert(result == EGSP_SUCCESS);
+
+	result = EgspMapOpenRead(&map, "Test.bin", EgspBlockSize());
+	assert(result == EGSP_SUCCESS);
+	EgspInitLoader(&loader, EgspMapFuncEx, &map);
+	pHeap = malloc(heapSize);
+	result = EgspLoadTestStructEx(&loader, &output, pHeap, heapSize);
+	assert(result == EGSP_SUCCESS);
+	VerifyOutput();
+	assert(output.TestString >= (const char*)map.pBase && output.TestString < (const char*)map.pBase + map.length);
+	result = EgspMapClose(&map);
+	assert(result == EGSP_SUCCESS);
+	free(pHeap);
+	remove("Test.bin");
+	EgspSetFlags(0);
+
+	// Through a small ring of blocks written and read ahead on another thread
+	EgspAsync async;
+	void* pRing = malloc(EgspAsyncMemory(16, 3));
+	int fd = open("Test.bin", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	assert(fd >= 0);
+	result = EgspAsyncOpenWriter(&async, fd, pRing, 16, 3);
+	assert(result == EGSP_SUCCESS);
+	EgspInitLoader(&loader, EgspAsyncFunc, &async);
+	loader.blockSize = 16;
+	result = EgspSaveTestStructEx(&loader, &testdata);
+	assert(result == EGSP_SUCCESS);
+	heapSize = loader.heapSize;
+	result = EgspAsyncClose(&async);
+	assert(result == EGSP_SUCCESS);
+	close(fd);
+
+	Reset();
+	fd = open("Test.bin", O_RDONLY);
+	assert(fd >= 0);
+	result = EgspAsyncOpenReader(&async, fd, pRing, 16, 3);
+	assert(result == EGSP_SUCCESS);
+	EgspInitLoader(&loader, EgspAsyncFunc, &async);
+	loader.blockSize = 16;
+	pHeap = malloc(heapSize);
+	result = EgspLoadTestStructEx(&loader, &output, pHeap, heapSize);
+	assert(result == EGSP_SUCCESS);
+	VerifyOutput();
+	result = EgspAsyncClose(&async);
+	assert(result == EGSP_SUCCESS);
+	close(fd);
+	free(pHeap);
+	free(pRing);
+
+	// Batched through io_uring where the kernel has it, plain pwrite/pread where it does not
+	EgspUring uring;
+	pRing = malloc(EgspUringMemory(16, 4));
+	fd = open("Test.bin", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	assert(fd >= 0);
+	result = EgspUringOpenWriter(&uring, fd, pRing, 16, 4);
+	assert(result == EGSP_SUCCESS);
+	EgspInitLoader(&loader, EgspUringFunc, &uring);
+	loader.blockSize = 16;
+	result = EgspSaveTestStructEx(&loader, &testdata);
+	assert(result == EGSP_SUCCESS);
+	heapSize = loader.heapSize;
+	result = EgspUringClose(&uring);
+	assert(result == EGSP_SUCCESS);
+	close(fd);
+
+	Reset();
+	fd = open("Test.bin", O_RDONLY);
+	assert(fd >= 0);
+	result = EgspUringOpenReader(&uring, fd, pRing, 16, 4);
+	assert(result == EGSP_SUCCESS);
+	EgspInitLoader(&loader, EgspUringFunc, &uring);
+	loader.blockSize = 16;
+	pHeap = malloc(heapSize);
+	result = EgspLoadTestStructEx(&loader, &output, pHeap, heapSize);
+	assert(result == EGSP_SUCCESS);
+	VerifyOutput();
+	result = EgspUringClose(&uring);
+	assert(result == EGSP_SUCCESS);
+	close(fd);
+	free(pHeap);
+	free(pRing);
+	remove("Test.bin");
+
+	// Arrays split up between threads must come out exactly like a sequential save
+	EgspPool pool;
+	result = EgspPoolOpen(&pool, 3);
+	assert(result == EGSP_SUCCESS);
+	pool.threshold = 2;
+	uint8_t* pParallel = malloc(sizeof(buffer));
+	for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); ++f)
+	{
+		for (size_t i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]); ++i)
+		{
+			// The unused last byte of each block is left as it was
+			memset(buffer, 0, sizeof(buffer));
+			memset(pParallel, 0, sizeof(buffer));
+			cursor.pBase = buffer;
+			cursor.count = 0;
+			cursor.blockSize = blockSizes[i];
+			EgspInitLoader(&loader, CursorFunc, &cursor);
+			loader.blockSize = blockSizes[i];
+			loader.flags = flags[f];
+			result = EgspSaveTestStructEx(&loader, &testdata);
+			assert(result == EGSP_SUCCESS);
+			size_t blocks = cursor.count;
+			heapSize = loader.heapSize;
+
+			cursor.pBase = pParallel;
+			cursor.count = 0;
+			EgspInitLoader(&loader, CursorFunc, &cursor);
+			loader.blockSize = blockSizes[i];
+			loader.flags = flags[f];
+			loader.pPool = &pool;
+			result = EgspSaveTestStructEx(&loader, &testdata);
+			assert(result == EGSP_SUCCESS);
+			assert(cursor.count == blocks && loader.heapSize == heapSize);
+			assert(memcmp(buffer, pParallel, blocks * blockSizes[i]) == 0);
+		}
+	}
+
+	// Chunks outgrowing EGSP_CHUNK_MIN_SIZE, with strings that run past the end of what a chunk has so far
+	TestStruct big = testdata;
+	big.labelcount = 2000;
+	big.labels = (Label*)malloc(big.labelcount * sizeof(Label));
+	char* pNames = (char*)malloc(big.labelcount * 1001);
+	for (uint32_t l = 0; l < big.labelcount; ++l)
+	{
+		char* pName = pNames + l * 1001;
+		memset(pName, 'a' + l % 26, 1000);
+		pName[1000] = '\0';
+		big.labels[l].name = pName;
+		big.labels[l].id = l;
+	}
+	size_t bigSize = 3 << 20;
+	uint8_t* pSequential = calloc(1, bigSize);
+	free(pParallel);
+	pParallel = calloc(1, bigSize);
+	cursor.pBase = pSequential;
+	cursor.count = 0;
+	cursor.blockSize = 4096;
+	EgspInitLoader(&loader, CursorFunc, &cursor);
+	loader.blockSize = cursor.blockSize;
+	result = EgspSaveTestStructEx(&loader, &big);
+	assert(result == EGSP_SUCCESS);
+	size_t blocks = cursor.count;
+	heapSize = loader.heapSize;
+
+	cursor.pBase = pParallel;
+	cursor.count = 0;
+	EgspInitLoader(&loader, CursorFunc, &cursor);
+	loader.blockSize = cursor.blockSize;
+	loader.pPool = &pool;
+	result = EgspSaveTestStructEx(&loader, &big);
+	assert(result == EGSP_SUCCESS);
+	assert(cursor.count == blocks && loader.heapSize == heapSize);
+	assert(memcmp(pSequential, pParallel, blocks * cursor.blockSize) == 0);
+	free(pSequential);
+	free(pNames);
+	free(big.labels);
+	free(pParallel);
+	result = EgspPoolClose(&pool);
+	assert(result == EGSP_SUCCESS);
+	EgspSetBlockSize(3);
+#endif
+
+#ifdef EGSP_JSON
+	// Shortest text that reads back as the same value, and correct rounding of whatever else is read
+	char number[EGSP_NUMBER_LENGTH];
+	double doubles[] = { 0.1, -0.0, 1e23, 5e-324, 2.2250738585072014e-308, 1.7976931348623157e308, 0.30000000000000004 };
+	for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); ++i)
+	{
+		double val = 1;
+		EgspDoubleToText(number, doubles[i]);
+		assert(EgspTextToDouble(number, &val) && memcmp(&val, &doubles[i], sizeof(val)) == 0);
+	}
+	float single = 0;
+	assert(EgspFloatToText(number, testdata.testfloat) == 6 && strcmp(number, "45.678") == 0);
+	assert(EgspTextToFloat(" 45.678,", &single) && single == testdata.testfloat);
+	double rounded = 0;
+	assert(EgspTextToDouble("9007199254740993", &rounded) && rounded == 9007199254740992.0);
+	assert(EgspTextToDouble("2.4703282292062328e-324", &rounded) && rounded == 5e-324);
+	assert(EgspTextToDouble("1e400", &rounded) && rounded > 1.7976931348623157e308);
+	int64_t bigint = 0;
+	assert(EgspInt64ToText(number, INT64_MIN) == 20 && EgspTextToInt64(number, &bigint) && bigint == INT64_MIN);
+	assert(!EgspTextToInt64("9223372036854775808", &bigint) && !EgspTextToInt64("x", &bigint));
+
 	Reset();
 	s_pFile = fopen("Test.json", "wb");
 	EgspPrintTestStruct(FlushFunc, &testdata, &heapSize);
@@ -139,6 +899,84 @@ int main(int argc, char** argv)
 	EgspReadTestStruct(LoadFunc, &output, pHeap, heapSize);
 	VerifyOutput();
 	free(pHeap);
+
+	// Compact Json has no whitespace at all, and reads back just the same
+	Reset();
+	cursor.pBase = buffer;
+	cursor.count = 0;
+	cursor.written = 0;
+	cursor.blockSize = 61;
+	EgspInitLoader(&loader, CursorFunc, &cursor);
+	loader.blockSize = cursor.blockSize;
+	loader.flags = EGSP_FLAG_COMPACT;
+	result = EgspPrintTestStructEx(&loader, &testdata);
+	assert(result == EGSP_SUCCESS && loader.heapSize == heapSize);
+	for (size_t i = 0; i < cursor.count; ++i)
+	{
+		uint8_t* pBlock = buffer + i * cursor.blockSize;
+		assert(!memchr(pBlock, '\n', cursor.blockSize - 1) && !memchr(pBlock, '\t', cursor.blockSize - 1));
+	}
+	assert(memcmp(buffer, "{\"testint\":32,\"testfloat\":45.678,", 33) == 0);
+
+	cursor.count = 0;
+	EgspInitLoader(&loader, CursorFunc, &cursor);
+	loader.blockSize = cursor.blockSize;
+	pHeap = malloc(heapSize);
+	result = EgspReadTestStructEx(&loader, &output, pHeap, heapSize);
+	assert(result == EGSP_SUCCESS);
+	VerifyOutput();
+	free(pHeap);
+#endif
+
+#ifdef EGSP_STATS
+	// Every byte of the stream belongs to one field and to the outermost struct, and the heap is taken exactly
+	EgspStats stats;
+	memset(&stats, 0, sizeof(stats));
+	Reset();
+	cursor.pBase = buffer;
+	cursor.count = 0;
+	cursor.written = 0;
+	cursor.blockSize = 64;
+	EgspInitLoader(&loader, CursorFunc, &cursor);
+	loader.blockSize = cursor.blockSize;
+	loader.flags = 0;
+	loader.pStats = &stats;
+	result = EgspSaveTestStructEx(&loader, &testdata);
+	assert(result == EGSP_SUCCESS);
+	heapSize = loader.heapSize;
+	EgspStructStats* pTop = 0;
+	for (size_t i = 0; i < EGSP_STATS_STRUCTS; ++i)
+	{
+		pTop = stats.structs[i].pName && strcmp(stats.structs[i].pName, "TestStruct") == 0 ? &stats.structs[i] : pTop;
+	}
+	assert(pTop && pTop->calls == 1 && pTop->bytes == cursor.written);
+	uint64_t fieldBytes = 0;
+	uint64_t funcCalls = 0;
+	for (size_t i = 0; i <= EGSP_KIND_ENUM; ++i)
+	{
+		fieldBytes += stats.kindBytes[i];
+	}
+	for (size_t i = 0; i < EGSP_STATS_BUCKETS; ++i)
+	{
+		funcCalls += stats.funcHistogram[i];
+	}
+	assert(fieldBytes == cursor.written && stats.kindCalls[EGSP_KIND_STRING] == 1 + testdata.labelcount);
+	assert(stats.funcCalls == cursor.count && funcCalls == cursor.count && stats.streamed == cursor.written);
+
+	size_t savedSize = cursor.written;
+	memset(&stats, 0, sizeof(stats));
+	cursor.count = 0;
+	EgspInitLoader(&loader, CursorFunc, &cursor);
+	loader.blockSize = cursor.blockSize;
+	loader.flags = 0;
+	loader.pStats = &stats;
+	pHeap = malloc(heapSize);
+	result = EgspLoadTestStructEx(&loader, &output, pHeap, heapSize);
+	assert(result == EGSP_SUCCESS);
+	VerifyOutput();
+	assert(stats.allocBytes + stats.allocPadding == heapSize && stats.heapHighWater == heapSize);
+	assert(pTop->calls == 1 && pTop->bytes == savedSize);
+	free(pHeap);
 #endif
 	return 0;
 }